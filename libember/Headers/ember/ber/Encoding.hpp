@@ -69,6 +69,29 @@ namespace libember { namespace ber
         encode(output, make_length(value.encodedLength()));
         value.encode(output);
     }
+
+    /**
+     * encodeFrame specialization for reals, which encodes the value once and
+     * uses the result for both the length and the payload.
+     */
+    template<>
+    inline void encodeFrame<double>(util::OctetStream& output, double value)
+    {
+        detail::EncodedReal const real(value);
+        encode(output, universalTag<double>());
+        encode(output, make_length(real.size()));
+        real.write(output);
+    }
+
+    /** @see encodeFrame<double>() */
+    template<>
+    inline void encodeFrame<float>(util::OctetStream& output, float value)
+    {
+        detail::EncodedReal const real(value);
+        encode(output, universalTag<float>());
+        encode(output, make_length(real.size()));
+        real.write(output);
+    }
 }
 }
 
@@ -10,7 +10,7 @@
 #define __LIBEMBER_BER_OBJECTIDENTIFIER_HPP
 
 #include <algorithm>
-#include <deque>
+#include <cstddef>
 #include "../util/Api.hpp"
 
 namespace libember { namespace ber
@@ -18,18 +18,23 @@ namespace libember { namespace ber
     /**
      * A simple template type that wraps an array of signed integer values representing a
      * relative object identifier.
+     * Up to InlineCapacity sub-identifiers are stored within the instance itself,
+     * so the paths used by glow only allocate memory from the heap if they are
+     * unusually deep. The length of the encoded form is maintained while
+     * sub-identifiers are added or removed.
      */
     class LIBEMBER_API ObjectIdentifier
     {
-        typedef std::deque<std::size_t> Container;
-
         public:
-            typedef Container::value_type value_type;
-            typedef Container::size_type size_type;
-            typedef Container::reference reference;
-            typedef Container::const_reference const_reference;
-            typedef Container::iterator iterator;
-            typedef Container::const_iterator const_iterator;
+            typedef std::size_t value_type;
+            typedef std::size_t size_type;
+            typedef value_type& reference;
+            typedef value_type const& const_reference;
+            typedef value_type* iterator;
+            typedef value_type const* const_iterator;
+
+            /** The number of sub-identifiers that can be stored without allocating memory. */
+            static size_type const InlineCapacity = 16;
 
         public:
             /**
@@ -50,6 +55,25 @@ namespace libember { namespace ber
              */
             explicit ObjectIdentifier(value_type value);
 
+            /**
+             * Copy constructor.
+             * @param other The object identifier to copy.
+             */
+            ObjectIdentifier(ObjectIdentifier const& other);
+
+            /**
+             * Destructor, frees the heap storage if the object identifier has
+             * outgrown the inline storage.
+             */
+            ~ObjectIdentifier();
+
+            /**
+             * Assignment operator.
+             * @param other The object identifier to copy.
+             * @return A reference to this instance.
+             */
+            ObjectIdentifier& operator=(ObjectIdentifier const& other);
+
             /**
              * Returns true if the ObjectIdentifier does not contain any elements.
              * @return True if the ObjectIdentifier does not contain any elements.
@@ -62,9 +86,28 @@ namespace libember { namespace ber
              */
             size_type size() const;
 
+            /**
+             * Returns the number of bytes required to encode this oid, without
+             * the tag and length.
+             * @return The length of the encoded form of this oid.
+             */
+            size_type encodedLength() const;
+
+            /**
+             * Returns a hash value of the sub-identifiers, which is suitable for
+             * hashed containers.
+             * @return The hash value of this oid.
+             */
+            std::size_t hash() const;
+
             /**
              * Returns reference to the first element of this oid.
              * @return Reference to the first element of this oid.
+             * @note After an element has been accessed through a non-const
+             *      reference or iterator, encodedLength() computes the length
+             *      on each call, since the element may still be modified. Adding
+             *      or removing sub-identifiers doesn't change this, only assigning
+             *      another oid does.
              */
             reference front();
 
@@ -164,14 +207,46 @@ namespace libember { namespace ber
             void pop_front();
 
         private:
-#ifdef _MSC_VER
-#  pragma warning(push)
-#  pragma warning(disable : 4251)
-#endif
-            Container m_items;
-#ifdef _MSC_VER
-#  pragma warning(pop)
-#endif
+            /**
+             * Makes sure that the storage can hold at least the specified number
+             * of sub-identifiers.
+             * @param count The minimum capacity.
+             */
+            void reserve(size_type count);
+
+            /**
+             * Returns true if the sub-identifiers are stored in the inline storage.
+             * @return True if the inline storage is used, otherwise false.
+             */
+            bool isInline() const;
+
+            /**
+             * Marks the cached encoded length as unknown. Called when a
+             * sub-identifier may be modified through a reference or iterator.
+             */
+            void invalidateLength();
+
+            /**
+             * Updates the cached encoded length after a sub-identifier has been
+             * added or removed. An unknown length remains unknown.
+             * @param added The encoded length of the added sub-identifier.
+             * @param removed The encoded length of the removed sub-identifier.
+             */
+            void updateLength(size_type added, size_type removed);
+
+            /**
+             * Computes the encoded length of the sub-identifiers.
+             * @return The length of the encoded form of this oid.
+             */
+            size_type computeEncodedLength() const;
+
+        private:
+            value_type* m_data;
+            size_type m_size;
+            size_type m_capacity;
+            size_type m_encodedLength;
+            bool m_encodedLengthValid;
+            value_type m_inline[InlineCapacity];
     };
 
     /**
@@ -204,6 +279,15 @@ namespace libember { namespace ber
      */
     bool operator!=(ObjectIdentifier const& lhs, ObjectIdentifier const& rhs);
 
+    /**
+     * Less-than comparison operator for object identifiers, which compares the
+     * sub-identifiers lexicographically. This allows object identifiers to be
+     * used as keys of ordered containers.
+     * @param lhs a constant reference to the first instance to be compared.
+     * @param rhs a constant reference to the second instance to be compared.
+     * @return True if @p lhs precedes @p rhs, otherwise false.
+     */
+    bool operator<(ObjectIdentifier const& lhs, ObjectIdentifier const& rhs);
 
 
     /**************************************************************************/
@@ -217,68 +301,85 @@ namespace libember { namespace ber
 
     template<typename InputIterator>
     ObjectIdentifier::ObjectIdentifier(InputIterator first, InputIterator last)
+        : m_data(m_inline)
+        , m_size(0)
+        , m_capacity(InlineCapacity)
+        , m_encodedLength(0)
+        , m_encodedLengthValid(true)
     {
-        m_items.assign(first, last);
+        for (/* Nothing */; first != last; ++first)
+        {
+            push_back(*first);
+        }
     }
 
     inline bool ObjectIdentifier::empty() const
     {
-        return m_items.empty();
+        return (m_size == 0);
     }
 
     inline ObjectIdentifier::const_iterator ObjectIdentifier::begin() const
     {
-        return m_items.begin();
+        return m_data;
     }
 
     inline ObjectIdentifier::const_iterator ObjectIdentifier::end() const
     {
-        return m_items.end();
+        return m_data + m_size;
     }
 
     inline ObjectIdentifier::iterator ObjectIdentifier::begin()
     {
-        return m_items.begin();
+        invalidateLength();
+        return m_data;
     }
 
     inline ObjectIdentifier::iterator ObjectIdentifier::end()
     {
-        return m_items.end();
+        invalidateLength();
+        return m_data + m_size;
     }
 
     inline ObjectIdentifier::size_type ObjectIdentifier::size() const
     {
-        return m_items.size();
+        return m_size;
+    }
+
+    inline ObjectIdentifier::size_type ObjectIdentifier::encodedLength() const
+    {
+        return m_encodedLengthValid ? m_encodedLength : computeEncodedLength();
     }
 
     inline ObjectIdentifier::reference ObjectIdentifier::front()
     {
-        return m_items.front();
+        invalidateLength();
+        return m_data[0];
     }
 
     inline ObjectIdentifier::const_reference ObjectIdentifier::front() const
     {
-        return m_items.front();
+        return m_data[0];
     }
 
     inline ObjectIdentifier::reference ObjectIdentifier::back()
     {
-        return m_items.back();
+        invalidateLength();
+        return m_data[m_size - 1];
     }
 
     inline ObjectIdentifier::const_reference ObjectIdentifier::back() const
     {
-        return m_items.back();
+        return m_data[m_size - 1];
     }
 
-    inline void ObjectIdentifier::pop_back()
+    inline bool ObjectIdentifier::isInline() const
     {
-        return m_items.pop_back();
+        return (m_data == m_inline);
     }
 
-    inline void ObjectIdentifier::pop_front()
+    inline void ObjectIdentifier::invalidateLength()
     {
-        return m_items.pop_front();
+        m_encodedLengthValid = false;
     }
 
     inline bool operator!=(ObjectIdentifier const& lhs, ObjectIdentifier const& rhs)
@@ -33,6 +33,12 @@ namespace libember { namespace ber
              */
             Octets(Octets const& other);
 
+            /** Assignment operator
+             * @param other The instance to copy the data from
+             * @return A reference to this instance
+             */
+            Octets& operator=(Octets const& other);
+
             /**
              * Initializes a new instance of Octets with the provided buffer
              * @param first First item to copy
@@ -87,6 +93,12 @@ namespace libember { namespace ber
     {
     }
 
+    inline Octets& Octets::operator=(Octets const& other)
+    {
+        m_data = other.m_data;
+        return *this;
+    }
+
     template<typename InputIterator>
     inline Octets::Octets(InputIterator first, InputIterator last)
         : m_data(first, last)
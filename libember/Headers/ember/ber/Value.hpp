@@ -9,16 +9,116 @@
 #ifndef __LIBEMBER_BER_VALUE_HPP
 #define __LIBEMBER_BER_VALUE_HPP
 
+#include <new>
+#include <string>
 #include <typeinfo>
 #include "../util/Api.hpp"
+#include "../meta/Signedness.hpp"
+#include "detail/EncodedReal.hpp"
 #include "traits/CodecTraits.hpp"
 
 namespace libember { namespace ber
 {
+    namespace detail
+    {
+        /**
+         * Traits type that decides whether a value is stored within a Value
+         * instance instead of a reference counted payload on the heap. This
+         * applies to values which can be copied without allocating memory,
+         * the default implementation selects the integral types.
+         */
+        template<typename ValueType>
+        struct InlineValueTraits
+        {
+            static bool isInline(ValueType const&)
+            {
+                return meta::IsSigned<ValueType>::value || meta::IsUnsigned<ValueType>::value;
+            }
+        };
+
+        /** InlineValueTraits specialization for booleans. */
+        template<>
+        struct InlineValueTraits<bool>
+        {
+            static bool isInline(bool)
+            {
+                return true;
+            }
+        };
+
+        /** InlineValueTraits specialization for single precision reals. */
+        template<>
+        struct InlineValueTraits<float>
+        {
+            static bool isInline(float)
+            {
+                return true;
+            }
+        };
+
+        /** InlineValueTraits specialization for double precision reals. */
+        template<>
+        struct InlineValueTraits<double>
+        {
+            static bool isInline(double)
+            {
+                return true;
+            }
+        };
+
+        /**
+         * InlineValueTraits specialization for strings. Short strings are
+         * commonly stored within the string object itself, longer ones are
+         * shared between copies of the value.
+         */
+        template<>
+        struct InlineValueTraits<std::string>
+        {
+            static bool isInline(std::string const& value)
+            {
+                return value.size() <= 15;
+            }
+        };
+
+        /**
+         * Traits type selecting the type a payload stores its value as. By
+         * default, this is the value type itself.
+         */
+        template<typename ValueType>
+        struct PayloadStorageTraits
+        {
+            typedef ValueType type;
+        };
+
+        /**
+         * PayloadStorageTraits specialization for single precision reals, which
+         * are stored along with their encoded form.
+         */
+        template<>
+        struct PayloadStorageTraits<float>
+        {
+            typedef PreencodedReal<float> type;
+        };
+
+        /**
+         * PayloadStorageTraits specialization for double precision reals, which
+         * are stored along with their encoded form.
+         */
+        template<>
+        struct PayloadStorageTraits<double>
+        {
+            typedef PreencodedReal<double> type;
+        };
+    }
+
     /**
      * A type-safe non-discriminated union type that allows introspection of all
      * properties related to the BER encoding of the stored value and its
      * specific type.
+     * @note Scalar values and short strings are stored within the instance
+     *      itself, so creating and copying them does not allocate memory.
+     *      All other values are held by a reference counted payload which is
+     *      shared between copies.
      */
     class LIBEMBER_API Value
     {
@@ -180,6 +280,15 @@ namespace libember { namespace ber
                      */
                     virtual std::type_info const& typeId() const = 0;
 
+                    /**
+                     * Creates a copy of this payload within the passed storage.
+                     * This method is only called for payloads which live in the
+                     * inline storage of a value.
+                     * @param storage The inline storage of the destination value.
+                     * @return A pointer to the created copy.
+                     */
+                    virtual Payload* clone(void* storage) const = 0;
+
                     /**
                      * Increment the reference count of this payload instance by one.
                      * @return The this pointer.
@@ -193,6 +302,9 @@ namespace libember { namespace ber
                      */
                     void releaseRef();
 
+                    /** Virtual destructor. */
+                    virtual ~Payload();
+
                 protected:
                     /**
                      * Default constructor.
@@ -200,9 +312,6 @@ namespace libember { namespace ber
                      */
                     Payload();
 
-                    /** Virtual destructor. */
-                    virtual ~Payload();
-
                 private:
                     /**
                      * Private, unimplemented copy constructor to make instances
@@ -228,6 +337,8 @@ namespace libember { namespace ber
             class PayloadImpl
                 : public Payload
             {
+                typedef typename detail::PayloadStorageTraits<ValueType>::type storage_type;
+
                 public:
                     /**
                      * Default constructor. Initializes the instance with a reference
@@ -240,7 +351,17 @@ namespace libember { namespace ber
                      * count of one and the wrapped value as a copy of @p value.
                      * @param value the value this instance should wrap.
                      */
-                    explicit PayloadImpl(ValueType value);
+                    explicit PayloadImpl(storage_type const& value);
+
+                    /**
+                     * Creates a payload wrapping the passed value. The payload is
+                     * constructed within @p storage if the value qualifies for
+                     * inline storage and fits, otherwise on the heap.
+                     * @param value The value to wrap.
+                     * @param storage The inline storage of the owning value.
+                     * @return A pointer to the created payload.
+                     */
+                    static Payload* create(ValueType const& value, void* storage);
 
                     /**
                      * Accessor to retrieve the held value.
@@ -260,12 +381,49 @@ namespace libember { namespace ber
                     /** @see Payload::encodedLength() */
                     virtual std::type_info const& typeId() const;
 
+                    /** @see Payload::clone() */
+                    virtual Payload* clone(void* storage) const;
+
                 private:
-                    ValueType m_value;
+                    storage_type m_value;
+            };
+
+            /**
+             * Inline storage for small payloads, large enough for a payload
+             * holding a string.
+             */
+            union Storage
+            {
+                void* pointer;
+                long double alignment;
+                unsigned char bytes[sizeof(void*) * 2 + sizeof(std::string)];
             };
 
+            /**
+             * Returns true if the payload lives in the inline storage.
+             * @return True if the payload lives in the inline storage, otherwise
+             *      false.
+             */
+            bool isInline() const;
+
+            /**
+             * Destroys an inline payload or releases the reference to a heap payload.
+             */
+            void destroy();
+
+            /**
+             * Moves a payload from one inline storage to another. Payloads that
+             * live on the heap are returned unchanged.
+             * @param payload The payload to move, may be null.
+             * @param source The storage the payload may currently live in.
+             * @param destination The storage to move an inline payload to.
+             * @return A pointer to the moved payload.
+             */
+            static Payload* relocate(Payload* payload, Storage& source, Storage& destination);
+
         private:
             Payload* m_payload;
+            Storage m_storage;
     };
 
     /**
@@ -284,7 +442,7 @@ namespace libember { namespace ber
 
     template<typename ValueType>
     inline Value::Value(ValueType value)
-        : m_payload(new PayloadImpl<ValueType>(value))
+        : m_payload(PayloadImpl<ValueType>::create(value, &m_storage))
     {}
 
     template<typename DestType>
@@ -303,10 +461,23 @@ namespace libember { namespace ber
     {}
 
     template<typename ValueType>
-    inline Value::PayloadImpl<ValueType>::PayloadImpl(ValueType value)
+    inline Value::PayloadImpl<ValueType>::PayloadImpl(storage_type const& value)
         : Payload(), m_value(value)
     {}
 
+    template<typename ValueType>
+    inline Value::Payload* Value::PayloadImpl<ValueType>::create(ValueType const& value, void* storage)
+    {
+        if ((sizeof(PayloadImpl) <= sizeof(Storage)) && detail::InlineValueTraits<ValueType>::isInline(value))
+        {
+            return new (storage) PayloadImpl(value);
+        }
+        else
+        {
+            return new PayloadImpl(value);
+        }
+    }
+
     template<typename ValueType>
     inline ValueType Value::PayloadImpl<ValueType>::value() const
     {
@@ -337,6 +508,12 @@ namespace libember { namespace ber
         return typeid(ValueType);
     }
 
+    template<typename ValueType>
+    inline Value::Payload* Value::PayloadImpl<ValueType>::clone(void* storage) const
+    {
+        return new (storage) PayloadImpl(m_value);
+    }
+
     inline void swap(Value& lhs, Value& rhs)
     {
         lhs.swap(rhs);
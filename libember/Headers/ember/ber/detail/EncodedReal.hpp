@@ -0,0 +1,178 @@
+/*
+    libember -- C++ 03 implementation of the Ember+ Protocol
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __LIBEMBER_BER_DETAIL_ENCODEDREAL_HPP
+#define __LIBEMBER_BER_DETAIL_ENCODEDREAL_HPP
+
+#include <cstddef>
+#include "../../util/BitScan.hpp"
+#include "../../util/OctetStream.hpp"
+#include "../../util/TypePun.hpp"
+
+namespace libember { namespace ber { namespace detail
+{
+    /**
+     * The encoded form of a real value. The preamble, exponent and mantissa
+     * are computed in a single pass, so the length of the encoded value is
+     * known before it is written. Exponent and mantissa are normalized
+     * with bit scans instead of shift loops.
+     */
+    class EncodedReal
+    {
+        public:
+            /**
+             * Constructor, encodes the passed value.
+             * @param value The value to encode. Single precision values
+             *      are converted to double precision first.
+             */
+            explicit EncodedReal(double value);
+
+            /**
+             * Returns the number of bytes of the encoded value.
+             * @return The number of bytes of the encoded value.
+             */
+            std::size_t size() const;
+
+            /**
+             * Appends the encoded value to the passed stream.
+             * @param output The stream to write the encoded value to.
+             */
+            void write(util::OctetStream& output) const;
+
+        private:
+            /**
+             * The preamble, two exponent bytes and seven mantissa bytes, since
+             * the mantissa of a double has at most 53 bits.
+             */
+            enum { MaximumLength = 1 + 2 + 7 };
+
+            /**
+             * Appends the lowest @p length bytes of @p value in big endian order.
+             * @param value The value to append.
+             * @param length The number of bytes to append.
+             */
+            void appendBytes(unsigned long long value, std::size_t length);
+
+        private:
+            unsigned char m_bytes[MaximumLength];
+            unsigned char m_size;
+    };
+
+    inline EncodedReal::EncodedReal(double value)
+        : m_size(0)
+    {
+        unsigned long long const bits = util::type_pun<unsigned long long>(value);
+        unsigned long long const exponentBits = bits & 0x7FF0000000000000ULL;
+        unsigned long long const fraction = bits & 0x000FFFFFFFFFFFFFULL;
+        bool const negative = (bits & 0x8000000000000000ULL) != 0;
+
+        if (exponentBits == 0x7FF0000000000000ULL)
+        {
+            // 0x40 Indicates positive infinity, 0x41 negative infinity and 0x42 NaN
+            m_bytes[0] = static_cast<unsigned char>((fraction != 0) ? 0x42 : (negative ? 0x41 : 0x40));
+            m_size = 1;
+        }
+        else if (bits == 0x8000000000000000ULL)
+        {
+            // 0x43 Indicates -0.0
+            m_bytes[0] = 0x43;
+            m_size = 1;
+        }
+        else if (bits != 0)
+        {
+            long long const exponent = static_cast<long long>(exponentBits >> 52) - 1023;
+            unsigned long long mantissa = fraction | 0x0010000000000000ULL;
+            mantissa >>= util::countTrailingZeros(mantissa);
+
+            // The exponent of a double is within [-1023, 1023], the mantissa has
+            // at most 53 bits, so its most significant byte never has the sign bit set.
+            std::size_t const exponentLength = ((exponent >= -128) && (exponent <= 127)) ? 1 : 2;
+            std::size_t const mantissaLength = (64 - util::countLeadingZeros(mantissa)) / 8 + 1;
+
+            m_bytes[0] = static_cast<unsigned char>(0x80 | (exponentLength - 1) | (negative ? 0x40 : 0x00));
+            m_size = 1;
+            appendBytes(static_cast<unsigned long long>(exponent), exponentLength);
+            appendBytes(mantissa, mantissaLength);
+        }
+    }
+
+    inline std::size_t EncodedReal::size() const
+    {
+        return m_size;
+    }
+
+    inline void EncodedReal::write(util::OctetStream& output) const
+    {
+        output.append(m_bytes, m_size);
+    }
+
+    inline void EncodedReal::appendBytes(unsigned long long value, std::size_t length)
+    {
+        for (std::size_t shift = length * 8; shift > 0; /* Nothing */)
+        {
+            shift -= 8;
+            m_bytes[m_size] = static_cast<unsigned char>((value >> shift) & 0xFFU);
+            ++m_size;
+        }
+    }
+
+    /**
+     * A real value stored along with its encoded form, which is computed once
+     * when the value is stored. ber::Value keeps reals in this form, so that
+     * determining the encoded length and encoding the value, which usually
+     * happen in turn, don't encode the real each time.
+     */
+    template<typename RealType>
+    class PreencodedReal
+    {
+        public:
+            /**
+             * Constructor, stores and encodes the passed value.
+             * @param value The value to store.
+             */
+            PreencodedReal(RealType value = RealType());
+
+            /**
+             * Returns the stored value.
+             * @return The stored value.
+             */
+            operator RealType() const;
+
+            /**
+             * Returns the encoded form of the stored value.
+             * @return The encoded form of the stored value.
+             */
+            EncodedReal const& encoded() const;
+
+        private:
+            RealType m_value;
+            EncodedReal m_encoded;
+    };
+
+    template<typename RealType>
+    inline PreencodedReal<RealType>::PreencodedReal(RealType value)
+        : m_value(value)
+        , m_encoded(value)
+    {}
+
+    template<typename RealType>
+    inline PreencodedReal<RealType>::operator RealType() const
+    {
+        return m_value;
+    }
+
+    template<typename RealType>
+    inline EncodedReal const& PreencodedReal<RealType>::encoded() const
+    {
+        return m_encoded;
+    }
+}
+}
+}
+
+#endif  // __LIBEMBER_BER_DETAIL_ENCODEDREAL_HPP
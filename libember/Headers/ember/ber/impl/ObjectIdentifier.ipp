@@ -10,42 +10,186 @@
 #define __LIBEMBER_BER_IMPL_OBJECTIDENTIFIER_IPP
 
 #include <algorithm>
+#include "../detail/MultiByte.hpp"
 #include "../../util/Inline.hpp"
 
 namespace libember { namespace ber
 {
     LIBEMBER_INLINE
     ObjectIdentifier::ObjectIdentifier(value_type value)
-        : m_items(1, value)
-    {}
+        : m_data(m_inline)
+        , m_size(1)
+        , m_capacity(InlineCapacity)
+        , m_encodedLength(detail::getMultiByteEncodedLength(value))
+        , m_encodedLengthValid(true)
+    {
+        m_inline[0] = value;
+    }
 
     LIBEMBER_INLINE
     ObjectIdentifier::ObjectIdentifier()
+        : m_data(m_inline)
+        , m_size(0)
+        , m_capacity(InlineCapacity)
+        , m_encodedLength(0)
+        , m_encodedLengthValid(true)
     {}
 
+    LIBEMBER_INLINE
+    ObjectIdentifier::ObjectIdentifier(ObjectIdentifier const& other)
+        : m_data(m_inline)
+        , m_size(0)
+        , m_capacity(InlineCapacity)
+        , m_encodedLength(other.encodedLength())
+        , m_encodedLengthValid(true)
+    {
+        reserve(other.m_size);
+        std::copy(other.m_data, other.m_data + other.m_size, m_data);
+        m_size = other.m_size;
+    }
+
+    LIBEMBER_INLINE
+    ObjectIdentifier::~ObjectIdentifier()
+    {
+        if (!isInline())
+        {
+            delete [] m_data;
+        }
+    }
+
+    LIBEMBER_INLINE
+    ObjectIdentifier& ObjectIdentifier::operator=(ObjectIdentifier const& other)
+    {
+        if (this != &other)
+        {
+            reserve(other.m_size);
+            std::copy(other.m_data, other.m_data + other.m_size, m_data);
+            m_size = other.m_size;
+            m_encodedLength = other.encodedLength();
+            m_encodedLengthValid = true;
+        }
+        return *this;
+    }
+
     LIBEMBER_INLINE
     void ObjectIdentifier::swap(ObjectIdentifier& other)
     {
-        using std::swap;
-        swap(m_items, other.m_items);
+        if (!isInline() && !other.isInline())
+        {
+            std::swap(m_data, other.m_data);
+            std::swap(m_size, other.m_size);
+            std::swap(m_capacity, other.m_capacity);
+            std::swap(m_encodedLength, other.m_encodedLength);
+            std::swap(m_encodedLengthValid, other.m_encodedLengthValid);
+        }
+        else
+        {
+            ObjectIdentifier const temporary(*this);
+            *this = other;
+            other = temporary;
+        }
+    }
+
+    LIBEMBER_INLINE
+    std::size_t ObjectIdentifier::hash() const
+    {
+        // FNV-1a, applied to whole sub-identifiers instead of single bytes
+        std::size_t result = static_cast<std::size_t>(2166136261UL);
+        for (const_iterator it = begin(), last = end(); it != last; ++it)
+        {
+            result ^= *it;
+            result *= static_cast<std::size_t>(16777619UL);
+        }
+        return result;
     }
 
     LIBEMBER_INLINE
     ObjectIdentifier::value_type ObjectIdentifier::operator[](int index) const
     {
-        return m_items[index];
+        return m_data[index];
     }
 
     LIBEMBER_INLINE
     void ObjectIdentifier::push_back(value_type value)
     {
-        m_items.push_back(value);
+        if (m_size == m_capacity)
+        {
+            reserve(m_capacity * 2);
+        }
+
+        m_data[m_size] = value;
+        ++m_size;
+        updateLength(detail::getMultiByteEncodedLength(value), 0);
     }
 
     LIBEMBER_INLINE
     void ObjectIdentifier::push_front(value_type value)
     {
-        m_items.push_front(value);
+        if (m_size == m_capacity)
+        {
+            reserve(m_capacity * 2);
+        }
+
+        std::copy_backward(m_data, m_data + m_size, m_data + m_size + 1);
+        m_data[0] = value;
+        ++m_size;
+        updateLength(detail::getMultiByteEncodedLength(value), 0);
+    }
+
+    LIBEMBER_INLINE
+    void ObjectIdentifier::pop_back()
+    {
+        --m_size;
+        updateLength(0, detail::getMultiByteEncodedLength(m_data[m_size]));
+    }
+
+    LIBEMBER_INLINE
+    void ObjectIdentifier::pop_front()
+    {
+        size_type const removed = detail::getMultiByteEncodedLength(m_data[0]);
+        std::copy(m_data + 1, m_data + m_size, m_data);
+        --m_size;
+        updateLength(0, removed);
+    }
+
+    LIBEMBER_INLINE
+    void ObjectIdentifier::reserve(size_type count)
+    {
+        if (count > m_capacity)
+        {
+            value_type* const data = new value_type[count];
+            std::copy(m_data, m_data + m_size, data);
+
+            if (!isInline())
+            {
+                delete [] m_data;
+            }
+
+            m_data = data;
+            m_capacity = count;
+        }
+    }
+
+    LIBEMBER_INLINE
+    void ObjectIdentifier::updateLength(size_type added, size_type removed)
+    {
+        // Once a mutable reference or iterator has been handed out, the cache
+        // stays invalid, since the sub-identifiers may still be modified through it.
+        if (m_encodedLengthValid)
+        {
+            m_encodedLength = m_encodedLength + added - removed;
+        }
+    }
+
+    LIBEMBER_INLINE
+    ObjectIdentifier::size_type ObjectIdentifier::computeEncodedLength() const
+    {
+        size_type length = 0;
+        for (const_iterator it = begin(), last = end(); it != last; ++it)
+        {
+            length += detail::getMultiByteEncodedLength(*it);
+        }
+        return length;
     }
 
     LIBEMBER_INLINE
@@ -53,8 +197,13 @@ namespace libember { namespace ber
     {
         return ((lhs.size() == rhs.size()) && std::equal(lhs.begin(), lhs.end(), rhs.begin()));
     }
+
+    LIBEMBER_INLINE
+    bool operator<(ObjectIdentifier const& lhs, ObjectIdentifier const& rhs)
+    {
+        return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
 }
 }
 
 #endif // __LIBEMBER_BER_IMPL_OBJECTIDENTIFIER_IPP
-
@@ -20,23 +20,31 @@ namespace libember { namespace ber
                 
     LIBEMBER_INLINE
     Value::Value(Value const& other)
-        : m_payload((other.m_payload != 0) ? other.m_payload->addRef() : 0)
-    {}
+        : m_payload(0)
+    {
+        if (other.isInline())
+        {
+            m_payload = other.m_payload->clone(&m_storage);
+        }
+        else if (other.m_payload != 0)
+        {
+            m_payload = other.m_payload->addRef();
+        }
+    }
 
     LIBEMBER_INLINE
     Value::~Value()
     {
-        if (m_payload != 0)
-        {
-            m_payload->releaseRef();
-        }
+        destroy();
     }
 
     LIBEMBER_INLINE
     void Value::swap(Value& other)
     {
-        using std::swap;
-        swap(m_payload, other.m_payload);
+        Storage temporary;
+        Payload* const payload = relocate(m_payload, m_storage, temporary);
+        m_payload = relocate(other.m_payload, other.m_storage, m_storage);
+        other.m_payload = relocate(payload, temporary, other.m_storage);
     }
 
     LIBEMBER_INLINE
@@ -77,6 +85,38 @@ namespace libember { namespace ber
         m_payload->encode(output);
     }
 
+    LIBEMBER_INLINE
+    bool Value::isInline() const
+    {
+        return (static_cast<void const*>(m_payload) == static_cast<void const*>(&m_storage));
+    }
+
+    LIBEMBER_INLINE
+    void Value::destroy()
+    {
+        if (isInline())
+        {
+            m_payload->~Payload();
+        }
+        else if (m_payload != 0)
+        {
+            m_payload->releaseRef();
+        }
+        m_payload = 0;
+    }
+
+    LIBEMBER_INLINE
+    Value::Payload* Value::relocate(Payload* payload, Storage& source, Storage& destination)
+    {
+        if ((payload != 0) && (static_cast<void*>(payload) == static_cast<void*>(&source)))
+        {
+            Payload* const result = payload->clone(&destination);
+            payload->~Payload();
+            return result;
+        }
+        return payload;
+    }
+
     LIBEMBER_INLINE
     Value::Payload::Payload()
         : m_refCount(1)
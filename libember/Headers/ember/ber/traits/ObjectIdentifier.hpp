@@ -10,7 +10,6 @@
 #define __LIBEMBER_BER_TRAITS_OBJECTIDENTIFIER_HPP
 
 #include <string>
-#include <vector>
 #include "CodecTraits.hpp"
 #include "../ObjectIdentifier.hpp"
 #include "../detail/MultiByte.hpp"
@@ -41,16 +40,7 @@ namespace libember { namespace ber
 
         static std::size_t encodedLength(value_type const& value)
         {
-            std::size_t length = 0;
-            value_type::const_iterator first = value.begin();
-            value_type::const_iterator const last = value.end();
-
-            for (/* Nothing */; first != last; ++first)
-            {
-                length += detail::getMultiByteEncodedLength(*first);
-            }
-
-            return length;
+            return value.encodedLength();
         }
 
         static void encode(util::OctetStream& output, value_type const& value)
@@ -84,15 +74,15 @@ namespace libember { namespace ber
         {
             // Note: Multibyte decoding already verifies validity of the given size.
             typedef ObjectIdentifier::value_type item_type;
-            std::vector<item_type> items;
+            ObjectIdentifier result;
             while(size > 0)
             {
                 std::pair<unsigned long long, std::size_t> encodeResult = detail::decodeMultibyte(input);
-                items.push_back(static_cast<item_type>(encodeResult.first));
+                result.push_back(static_cast<item_type>(encodeResult.first));
                 size -= encodeResult.second;
             }
 
-            return ObjectIdentifier(items.begin(), items.end());
+            return result;
         }
     };
 }
@@ -13,7 +13,9 @@
 #include "CodecTraits.hpp"
 #include "RegisterDecoder.hpp"
 #include "Integral.hpp"
+#include "../detail/EncodedReal.hpp"
 #include "../../meta/FunctionTraits.hpp"
+#include "../../util/BitScan.hpp"
 #include "../../util/TypePun.hpp"
 #include "../../util/SignBit.hpp"
 
@@ -46,95 +48,22 @@ namespace libember { namespace ber
 
             static void encode(util::OctetStream& output, value_type value)
             {
-                if (value == +std::numeric_limits<value_type>::infinity())
-                {
-                    // 0x40 Indicates positive infinity
-                    output.append(0x40);
-                }
-                else if (value == -std::numeric_limits<value_type>::infinity())
-                {
-                    // 0x41 Indicates positive infinity
-                    output.append(0x41);
-                }
-                else if (
-                    value == std::numeric_limits<value_type>::quiet_NaN() ||
-                    value == std::numeric_limits<value_type>::signaling_NaN())
-                {
-                    // 0x42 Indicates NaN
-                    output.append(0x42);
-                }
-                else if (
-                    (value == static_cast<value_type>(0.0)) &&
-                    util::signbit(value))
-                {
-                    // 0x43 Indicates -0.0
-                    output.append(0x43);
-                }
-                else
-                {
-                    double const real = value;
-                    unsigned long long const bits = util::type_pun<unsigned long long>(real);
-
-                    if (bits != 0)
-                    {
-                        long long const exponent = ((0x7FF0000000000000LL & bits) >> 52) - 1023;
-                        unsigned long long mantissa = 0x000FFFFFFFFFFFFFULL & bits;
-                        mantissa |= 0x0010000000000000ULL;
-
-                        while((mantissa & 0xFF) == 0x00)
-                            mantissa >>= 8;
-
-                        while((mantissa & 0x01) == 0x00)
-                            mantissa >>= 1;
-
-                        std::size_t const exponentLength = ber::encodedLength<long long>(exponent);
-                        unsigned char preamble = static_cast<unsigned char>(0x80 | (exponentLength - 1));
-
-                        if((bits & 0x8000000000000000ULL) != 0)
-                            preamble |= 0x40;
+                EncodedReal(value).write(output);
+            }
 
-                        output.append(preamble);
-                        ber::encode<long long>(output, exponent);
-                        ber::encode<unsigned long long>(output, mantissa);
-                    }
-                }
+            static void encode(util::OctetStream& output, PreencodedReal<value_type> const& value)
+            {
+                value.encoded().write(output);
             }
 
             static std::size_t encodedLength(value_type value)
             {
-                if ((value == +std::numeric_limits<value_type>::infinity())
-                ||  (value == -std::numeric_limits<value_type>::infinity())
-                ||  (value == std::numeric_limits<value_type>::quiet_NaN())
-                ||  (value == std::numeric_limits<value_type>::signaling_NaN())
-                ||  ((value == static_cast<value_type>(0.0)) && util::signbit(value)))
-                {
-                    return 1;
-                }
-                else
-                {
-                    std::size_t encodedLength = 0;
-                    double const real = value;
-                    unsigned long long const bits = util::type_pun<unsigned long long>(real);
-
-                    if (bits != 0)
-                    {
-                        long long const exponent = ((0x7FF0000000000000LL & bits) >> 52) - 1023;
-                        unsigned long long mantissa =   0x000FFFFFFFFFFFFFULL & bits;
-                        mantissa |= 0x0010000000000000ULL;
-
-                        while((mantissa & 0xFF) == 0x00)
-                            mantissa >>= 8;
-
-                        while((mantissa & 0x01) == 0x00)
-                            mantissa >>= 1;
-
-                        encodedLength += 1;     // preamble
-                        encodedLength += ber::encodedLength<long long>(exponent);
-                        encodedLength += ber::encodedLength<unsigned long long>(mantissa);
-                    }
+                return EncodedReal(value).size();
+            }
 
-                    return encodedLength;
-                }
+            static std::size_t encodedLength(PreencodedReal<value_type> const& value)
+            {
+                return value.encoded().size();
             }
         };
 
@@ -170,56 +99,149 @@ namespace libember { namespace ber
                     throw std::runtime_error("Not enough data");
                 }
 
-                unsigned char const preamble = input.front();
-                input.consume();
-
-                if ((encodedLength == 1) && (preamble == 0x40))
-                {
-                    return +std::numeric_limits<value_type>::infinity();
-                }
-                else if ((encodedLength == 1) && (preamble == 0x41))
-                {
-                    return -std::numeric_limits<value_type>::infinity();
-                }
-                else if ((encodedLength == 1) && (preamble == 0x42))
+                // Usually the whole value is stored within the first chunk of the
+                // stream, so it can be decoded without consuming it byte by byte.
+                util::OctetStream::segment_iterator const segment = input.segment_begin();
+                if (segment->second >= encodedLength)
                 {
-                    return std::numeric_limits<value_type>::quiet_NaN();
-                }
-                else if ((encodedLength == 1) && (preamble == 0x43))
-                {
-                    return static_cast<value_type>(-0.0);
+                    ContiguousSource source(segment->first);
+                    value_type value;
+                    try
+                    {
+                        value = decodeFrom(source, encodedLength);
+                    }
+                    catch (...)
+                    {
+                        // Like the byte-wise path, an invalid value only consumes its preamble.
+                        input.consume();
+                        throw;
+                    }
+
+                    input.consume(encodedLength);
+                    return value;
                 }
                 else
                 {
-                    unsigned long long bits = 0;
-                    unsigned int const sign = (preamble & 0x40);
-                    unsigned int const exponentLength = 1 + (preamble & 3);
-                    unsigned int const mantissaShift = ((preamble >> 2) & 3);
+                    StreamSource source(input);
+                    return decodeFrom(source, encodedLength);
+                }
+            }
 
-                    // Note: If (exponentLength > encodedLength - 1), the following call to decode will throw,
-                    // so there is no need to check this separately.
-                    long long exponent = ber::decode<long long>(input, exponentLength);
-                    unsigned long long mantissa = ber::decode<unsigned long long>(input, encodedLength - exponentLength - 1) << mantissaShift;
+            private:
+                /** Reads the bytes of a value from contiguous memory. */
+                struct ContiguousSource
+                {
+                    explicit ContiguousSource(unsigned char const* first)
+                        : current(first)
+                    {}
 
-                    if (mantissa != 0)
+                    unsigned char next()
                     {
-                        while((mantissa & 0x7FFFF00000000000ULL) == 0x00)
-                            mantissa <<= 8;
-
-                        while((mantissa & 0x7FF0000000000000ULL) == 0x00)
-                            mantissa <<= 1;
+                        return *current++;
                     }
 
-                    mantissa &= 0x0FFFFFFFFFFFFFULL;
-                    bits = (static_cast<unsigned long long>(exponent + 1023) << 52) | mantissa;
+                    unsigned char const* current;
+                };
 
-                    if (sign != 0)
-                        bits |= (0x8000000000000000ULL);
+                /** Reads and consumes the bytes of a value from a stream. */
+                struct StreamSource
+                {
+                    explicit StreamSource(util::OctetStream& input)
+                        : input(input)
+                    {}
 
-                    double const real = util::type_pun<double>(bits);
-                    return static_cast<value_type>(real);
+                    unsigned char next()
+                    {
+                        unsigned char const byte = input.front();
+                        input.consume();
+                        return byte;
+                    }
+
+                    util::OctetStream& input;
+
+                    private:
+                        StreamSource& operator=(StreamSource const&);
+                };
+
+                /**
+                 * Decodes a value from the passed byte source.
+                 * @param source The source providing the encoded bytes.
+                 * @param encodedLength The number of encoded bytes.
+                 * @return The decoded value.
+                 * @throw std::runtime_error if the exponent length exceeds the
+                 *      encoded length.
+                 */
+                template<typename SourceType>
+                static value_type decodeFrom(SourceType& source, std::size_t encodedLength)
+                {
+                    unsigned char const preamble = source.next();
+
+                    if ((encodedLength == 1) && (preamble == 0x40))
+                    {
+                        return +std::numeric_limits<value_type>::infinity();
+                    }
+                    else if ((encodedLength == 1) && (preamble == 0x41))
+                    {
+                        return -std::numeric_limits<value_type>::infinity();
+                    }
+                    else if ((encodedLength == 1) && (preamble == 0x42))
+                    {
+                        return std::numeric_limits<value_type>::quiet_NaN();
+                    }
+                    else if ((encodedLength == 1) && (preamble == 0x43))
+                    {
+                        return static_cast<value_type>(-0.0);
+                    }
+                    else
+                    {
+                        unsigned int const sign = (preamble & 0x40);
+                        std::size_t const exponentLength = 1 + (preamble & 3);
+                        unsigned int const mantissaShift = ((preamble >> 2) & 3);
+
+                        if (exponentLength > encodedLength - 1)
+                        {
+                            throw std::runtime_error("Not enough data");
+                        }
+
+                        unsigned long long exponentBits = 0;
+                        for (std::size_t index = 0; index < exponentLength; ++index)
+                        {
+                            unsigned char const byte = source.next();
+                            if ((index == 0) && ((byte & 0x80) != 0))
+                            {
+                                exponentBits = ~0ULL;
+                            }
+                            exponentBits = (exponentBits << 8) | byte;
+                        }
+
+                        unsigned long long mantissa = 0;
+                        for (std::size_t index = exponentLength + 1; index < encodedLength; ++index)
+                        {
+                            mantissa = (mantissa << 8) | source.next();
+                        }
+
+                        mantissa <<= mantissaShift;
+                        if (mantissa != 0)
+                        {
+                            // Move the leading one to the position of the implicit bit.
+                            unsigned int const leadingZeros = util::countLeadingZeros(mantissa);
+                            if (leadingZeros > 11)
+                            {
+                                mantissa <<= (leadingZeros - 11);
+                            }
+                        }
+
+                        long long const exponent = static_cast<long long>(exponentBits);
+                        mantissa &= 0x0FFFFFFFFFFFFFULL;
+                        unsigned long long bits = (static_cast<unsigned long long>(exponent + 1023) << 52) | mantissa;
+
+                        if (sign != 0)
+                            bits |= (0x8000000000000000ULL);
+
+                        double const real = util::type_pun<double>(bits);
+                        return static_cast<value_type>(real);
+                    }
                 }
-            }
         };
     }
 
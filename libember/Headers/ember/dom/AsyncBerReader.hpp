@@ -12,6 +12,7 @@
 #include <memory>
 #include <deque>
 #include "../util/Api.hpp"
+#include "../util/MonotonicArena.hpp"
 #include "../util/OctetStream.hpp"
 #include "../ber/Encoding.hpp"
 #include "../ber/Length.hpp"
@@ -65,6 +66,26 @@ namespace libember { namespace dom
             template<typename InputIterator>
             void read(InputIterator first, InputIterator last);
 
+            /**
+             * Decodes a contiguous block of bytes. Tags and lengths that are
+             * completely contained in the block are decoded in place and the
+             * payload of primitive values is copied at once, instead of
+             * dispatching every single byte. The block may end at any position,
+             * decoding continues with the next call.
+             * @param first a pointer to the first byte to decode.
+             * @param last a pointer to the byte one past the last byte to decode.
+             * @throw std::runtime_error if the end of a stream is reached while still decoding
+             *      a container; when there is a mismatch with the decoded tag or length or
+             *      when a memory exception occurs.
+             */
+            void read(value_type const* first, value_type const* last);
+
+            /**
+             * Decodes a contiguous block of bytes.
+             * @see read(value_type const*, value_type const*)
+             */
+            void read(value_type* first, value_type* last);
+
         protected:
             /** Constructor */
             AsyncBerReader();
@@ -98,6 +119,25 @@ namespace libember { namespace dom
              */
             bool isContainer() const;
 
+            /**
+             * Returns the application tag of the node currently being decoded.
+             * @return The application tag of the current node.
+             */
+            ber::Tag const& applicationTag() const;
+
+            /**
+             * Returns the type tag of the node currently being decoded.
+             * @return The type tag of the current node.
+             */
+            ber::Tag const& typeTag() const;
+
+            /**
+             * Returns the buffer holding the value bytes of the primitive node
+             * currently being decoded. The buffer is only valid within itemReady.
+             * @return The buffer holding the value bytes of the current node.
+             */
+            util::OctetStream& valueBuffer();
+
             /**
              * Decodes a value from the value buffer.
              */
@@ -107,9 +147,12 @@ namespace libember { namespace dom
             /**
              * Creates a new node from the current buffer.
              * @param factory The application defined node factory.
+             * @param arena The arena to allocate the node from. If null, the node
+             *      is allocated on the heap. A node allocated from the arena
+             *      has to be passed to dom::Node::adoptByArena().
              * @return A pointer to the newly created dom node.
              */
-            dom::Node* decodeNode(dom::NodeFactory const& factory);
+            dom::Node* decodeNode(dom::NodeFactory const& factory, util::MonotonicArena* arena = 0);
 
         private:
             /**
@@ -140,6 +183,36 @@ namespace libember { namespace dom
              */
             bool readTerminatorByte(value_type value);
 
+            /**
+             * Decodes as many bytes as possible with a single operation: a single
+             * byte tag, a complete length or the available part of a value.
+             * @param first a pointer to the first byte to decode.
+             * @param last a pointer to the byte one past the last byte to decode.
+             * @return A pointer to the first byte that has not been decoded. If
+             *      this equals @p first, the next byte must be read individually.
+             */
+            value_type const* readBlock(value_type const* first, value_type const* last);
+
+            /**
+             * Applies a tag that has been decoded completely.
+             * @param tag The decoded tag.
+             * @return Always false, a container must not end with a tag.
+             */
+            bool tagReady(ber::Tag const& tag);
+
+            /**
+             * Applies a length that has been decoded completely.
+             * @param length The decoded length.
+             * @return True if the current TLV is complete and its container may end.
+             */
+            bool lengthReady(size_type length);
+
+            /**
+             * Adds the passed number of bytes to the byte count of the current container.
+             * @param amount The number of bytes that have been read.
+             */
+            void incrementBytesRead(size_type amount);
+
             /**
              * Resets the state of the decoder, including the current buffer.
              * @param state The new decoding state to set.
@@ -342,6 +415,11 @@ namespace libember { namespace dom
         }
     }
 
+    inline void AsyncBerReader::read(value_type* first, value_type* last)
+    {
+        read(static_cast<value_type const*>(first), static_cast<value_type const*>(last));
+    }
+
     template<typename ValueType>
     inline ValueType AsyncBerReader::decode()
     {
@@ -57,6 +57,24 @@ namespace libember { namespace dom
              */
             dom::Node* detachRoot();
 
+            /**
+             * Sets the arena the decoded nodes are allocated from. The nodes are owned
+             * by the arena and destroyed when it is released, so a tree taken from the
+             * reader is freed with dom::Node::destroy(), which only deletes the nodes
+             * allocated on the heap, followed by releasing the arena. The arena must
+             * not be released while the reader still holds a tree decoded into it.
+             * @param arena The arena to allocate the nodes from. If null, the nodes
+             *      are allocated on the heap, which is the default.
+             */
+            void setArena(util::MonotonicArena* arena);
+
+            /**
+             * Returns the arena the decoded nodes are allocated from.
+             * @return The arena the decoded nodes are allocated from, or null
+             *      if the nodes are allocated on the heap.
+             */
+            util::MonotonicArena* arena() const;
+
         protected:
             /**
              * This method is called when a new container node has been decoded. The
@@ -103,6 +121,7 @@ namespace libember { namespace dom
             dom::Node* m_root;
             dom::Node* m_current;
             dom::NodeFactory const& m_factory;
+            util::MonotonicArena* m_arena;
     };
 }
 }
@@ -0,0 +1,175 @@
+/*
+    libember -- C++ 03 implementation of the Ember+ Protocol
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __LIBEMBER_DOM_ASYNCEVENTREADER_HPP
+#define __LIBEMBER_DOM_ASYNCEVENTREADER_HPP
+
+#include <algorithm>
+#include "AsyncBerReader.hpp"
+#include "../ber/Type.hpp"
+
+namespace libember { namespace dom
+{
+    /**
+     * Asynchronous reader which reports the structure of the decoded data as a
+     * sequence of events instead of building a tree. Containers are reported
+     * when their header has been decoded and when they end, primitive values
+     * are passed as a non-owning view which decodes the value only on request.
+     * Apart from the internal buffers, which are reused, no memory is allocated
+     * while reading.
+     */
+    class LIBEMBER_API AsyncEventReader : public AsyncBerReader
+    {
+        public:
+            /**
+             * Non-owning view of the encoded value of a primitive node. The view
+             * is only valid within the leaf method it has been passed to.
+             */
+            class LIBEMBER_API LeafValue
+            {
+                friend class AsyncEventReader;
+                public:
+                    typedef util::OctetStream::segment_iterator segment_iterator;
+
+                    /**
+                     * Returns the number of value bytes.
+                     * @return The number of value bytes.
+                     */
+                    size_type size() const;
+
+                    /**
+                     * Returns an iterator referring to the first contiguous segment of
+                     * the value bytes.
+                     * @return An iterator referring to the first segment.
+                     */
+                    segment_iterator segment_begin() const;
+
+                    /**
+                     * Returns an iterator referring to the segment one past the last
+                     * segment of the value bytes.
+                     * @return An iterator referring to the segment one past the last segment.
+                     */
+                    segment_iterator segment_end() const;
+
+                    /**
+                     * Copies the value bytes to the passed output iterator.
+                     * @param output The iterator to copy the value bytes to.
+                     * @return The output iterator pointing past the last copied byte.
+                     */
+                    template<typename OutputIterator>
+                    OutputIterator copy(OutputIterator output) const;
+
+                    /**
+                     * Decodes the value as the specified type. Since decoding consumes
+                     * the value bytes, this method may only be called once per value.
+                     * @return The decoded value.
+                     * @throw std::runtime_error if the bytes cannot be decoded as the
+                     *      requested type.
+                     */
+                    template<typename ValueType>
+                    ValueType decode() const;
+
+                private:
+                    /**
+                     * Constructor.
+                     * @param buffer The buffer holding the value bytes.
+                     */
+                    explicit LeafValue(util::OctetStream& buffer);
+
+                    /** Prohibit assignments */
+                    LeafValue& operator=(LeafValue const&);
+
+                private:
+                    util::OctetStream& m_buffer;
+                    size_type const m_size;
+            };
+
+        public:
+            /**
+             * Returns the number of containers that have been entered but not yet left.
+             * @return The nesting depth of the node currently being decoded.
+             */
+            size_type depth() const;
+
+        protected:
+            /** Constructor */
+            AsyncEventReader();
+
+            /**
+             * This method is called when the header of a container has been decoded.
+             * The default implementation is empty.
+             * @param tag The application tag of the container.
+             * @param type The type of the container, e.g. ber::Type::Sequence or an
+             *      application defined type.
+             */
+            virtual void enterContainer(ber::Tag const& tag, ber::Type const& type);
+
+            /**
+             * This method is called when a primitive node has been decoded.
+             * The default implementation is empty.
+             * @param tag The application tag of the node.
+             * @param type The universal type of the value.
+             * @param value A view of the encoded value.
+             */
+            virtual void leaf(ber::Tag const& tag, ber::Type const& type, LeafValue const& value);
+
+            /**
+             * This method is called when all children of a container have been decoded.
+             * The default implementation is empty.
+             * @param tag The application tag of the container.
+             * @param type The type of the container.
+             */
+            virtual void exitContainer(ber::Tag const& tag, ber::Type const& type);
+
+            /**
+             * Resets the nesting depth.
+             */
+            virtual void resetImpl();
+
+        private:
+            /**
+             * Reports the beginning of a container.
+             */
+            virtual void containerReady();
+
+            /**
+             * Reports a primitive node or the end of a container.
+             */
+            virtual void itemReady();
+
+        private:
+            size_type m_depth;
+    };
+
+    /**************************************************************************
+     * Mandatory inline implementation                                        *
+     **************************************************************************/
+
+    template<typename OutputIterator>
+    inline OutputIterator AsyncEventReader::LeafValue::copy(OutputIterator output) const
+    {
+        for (segment_iterator it = segment_begin(), last = segment_end(); it != last; ++it)
+        {
+            output = std::copy(it->first, it->first + it->second, output);
+        }
+        return output;
+    }
+
+    template<typename ValueType>
+    inline ValueType AsyncEventReader::LeafValue::decode() const
+    {
+        return ber::decode<ValueType>(m_buffer, m_size);
+    }
+}
+}
+
+#ifdef LIBEMBER_HEADER_ONLY
+#  include "impl/AsyncEventReader.ipp"
+#endif
+
+#endif  // __LIBEMBER_DOM_ASYNCEVENTREADER_HPP
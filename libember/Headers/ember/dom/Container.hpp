@@ -133,6 +133,14 @@ namespace libember { namespace dom
              */
             void erase(iterator const& first, iterator const& last);
 
+            /**
+             * Return a counter that changes whenever child nodes are inserted
+             * into or erased from this container. It allows lookup structures
+             * that refer to the child nodes to detect that they are outdated.
+             * @return The current revision of the sequence of child nodes.
+             */
+            size_type revision() const;
+
         protected:
             /**
              * Constructor that initializes the node with the application tag
@@ -217,6 +225,9 @@ namespace libember { namespace dom
              * of nodes to each other.
              */
             Container& operator=(Container const&);
+
+        private:
+            size_type m_revision;
    };
 }
 }
@@ -21,6 +21,9 @@
 #include "NodeFactory.hpp"
 #include "DomReader.hpp"
 #include "AsyncDomReader.hpp"
+#include "AsyncEventReader.hpp"
+#include "StreamingEncoder.hpp"
+#include "TreeEncoder.hpp"
 
 #endif  // __LIBEMBER_DOM_DOM_HPP
 
@@ -10,6 +10,7 @@
 #define __LIBEMBER_DOM_DOMREADER_HPP
 
 #include "../util/Api.hpp"
+#include "../util/MonotonicArena.hpp"
 #include "../ber/Encoding.hpp"
 #include "../ber/Length.hpp"
 
@@ -38,11 +39,17 @@ namespace libember { namespace dom
              * Constructs a node structure from an octet stream. The stream must contain
              * the complete data of the previously encoded structure. The returned root node
              * must be deleted manually when it is no longer needed.
+             * When an arena is passed, all nodes are allocated from it and are destroyed
+             * when the arena is released. In that case the tree is freed by passing the
+             * root node to Node::destroy(), which only deletes nodes that a factory
+             * allocated on the heap, and releasing the arena afterwards.
              * @param input Input stream containing the encoded data.
              * @param factory The node factory to use when a new item has been read.
+             * @param arena The arena to allocate the nodes from. If null, the nodes are
+             *      allocated on the heap.
              * @throw std::runtime_error when the decoded root node is not a container.
              */
-            Node* decodeTree(util::OctetStream& input, NodeFactory const& factory);
+            Node* decodeTree(util::OctetStream& input, NodeFactory const& factory, util::MonotonicArena* arena = 0);
 
         private:
             /**
@@ -151,6 +158,7 @@ namespace libember { namespace dom
 
         private:
             util::OctetStream* m_input;
+            util::MonotonicArena* m_arena;
             DomReader* m_parentReader;
             size_type m_length;
             size_type m_outerLength;
@@ -9,8 +9,10 @@
 #ifndef __LIBEMBER_DOM_NODE_HPP
 #define __LIBEMBER_DOM_NODE_HPP
 
+#include <new>
 #include "../ber/Type.hpp"
 #include "../ber/Tag.hpp"
+#include "../util/MonotonicArena.hpp"
 #include "../util/OctetStream.hpp"
 
 namespace libember { namespace dom
@@ -101,6 +103,100 @@ namespace libember { namespace dom
              */
             std::size_t encodedLength() const;
 
+            /**
+             * Returns whether this node is owned by the arena it has been allocated
+             * from. Such a node is destroyed when the arena is released and must
+             * not be deleted.
+             * @return True if this node is owned by an arena.
+             * @see adoptByArena()
+             */
+            bool isArenaAllocated() const;
+
+            /**
+             * Deletes the passed node, unless it is owned by an arena. Containers
+             * use this method to delete their children, so deleting a tree skips
+             * all nodes which will be destroyed when their arena is released.
+             * @param node The node to delete, may be null.
+             */
+            static void destroy(Node* node);
+
+            /**
+             * Hands a node that has just been allocated with new (arena) over
+             * to the arena, which destroys it when it is released. The readers
+             * do this for every node they decode, so a decoded tree is freed
+             * by releasing the arena, without deleting its root first.
+             * Nodes which have not been allocated from @p arena, for instance
+             * by a factory that ignores the arena, are left unchanged.
+             * @param node The node to hand over, may be null.
+             * @param arena The arena the node may have been allocated from, may
+             *      be null.
+             * @return The passed node.
+             */
+            static Node* adoptByArena(Node* node, util::MonotonicArena* arena);
+
+            /**
+             * Allocates the memory for a node on the heap.
+             * @param size The size of the node in bytes.
+             * @return A pointer to the allocated memory.
+             */
+            static void* operator new(std::size_t size);
+
+            /**
+             * Allocates the memory for a node on the heap and returns null on
+             * failure instead of throwing.
+             * @param size The size of the node in bytes.
+             * @return A pointer to the allocated memory, or null.
+             */
+            static void* operator new(std::size_t size, std::nothrow_t const&) throw();
+
+            /**
+             * Constructs a node in memory that is provided by the caller.
+             * @param size The size of the node in bytes.
+             * @param where The memory to construct the node in.
+             * @return @p where.
+             */
+            static void* operator new(std::size_t size, void* where);
+
+            /**
+             * Allocates the memory for a node from the passed arena. The memory
+             * is only returned when the arena is released, so a node allocated
+             * this way must either be handed over to the arena with adoptByArena()
+             * or be destroyed explicitly before the arena is released.
+             * @param size The size of the node in bytes.
+             * @param arena The arena to allocate from. If 0 is passed, the memory
+             *      is allocated on the heap.
+             * @return A pointer to the allocated memory.
+             */
+            static void* operator new(std::size_t size, util::MonotonicArena* arena);
+
+            /**
+             * Frees the memory of a node that has been allocated on the heap.
+             * @param ptr A pointer to the memory of the node to free.
+             */
+            static void operator delete(void* ptr);
+
+            /**
+             * Frees the memory of a node whose constructor threw an exception.
+             * @param ptr A pointer to the memory of the node to free.
+             */
+            static void operator delete(void* ptr, std::nothrow_t const&) throw();
+
+            /**
+             * Called when the constructor of a node constructed in place threw
+             * an exception. The memory is left untouched.
+             * @param ptr A pointer to the memory of the node.
+             * @param where The memory the node has been constructed in.
+             */
+            static void operator delete(void* ptr, void* where);
+
+            /**
+             * Frees the memory of a node whose constructor threw an exception.
+             * Memory that has been allocated from an arena is left untouched.
+             * @param ptr A pointer to the memory of the node to free.
+             * @param arena The arena the memory has been allocated from.
+             */
+            static void operator delete(void* ptr, util::MonotonicArena* arena);
+
         protected:
             /**
              * Return the type tag that should be used to tag the inner frame when
@@ -115,6 +211,8 @@ namespace libember { namespace dom
              * @note This method is never called directly, but instead is called
              *      indirectly by a call to update(), which clears the dirty flag
              *      after invoking this method.
+             * @note Implementations for container nodes must update all of their
+             *      children, see markDirty().
              * @see update()
              */
             virtual void updateImpl() const = 0;
@@ -181,6 +279,11 @@ namespace libember { namespace dom
              * required.
              * The post-condition to calling this method is that an immediate
              * call to isDirty() returns true.
+             * @note Since updating a container also updates all of its children,
+             *      the parent of a dirty node is always dirty as well. The flag is
+             *      therefore only propagated up to the first node that is already
+             *      dirty, which makes marking the nodes of a tree that is still
+             *      being built a constant time operation.
              */
             void markDirty() const;
 
@@ -198,10 +301,17 @@ namespace libember { namespace dom
              */
             Node& operator=(Node const&);
 
+            /**
+             * Destroys a node that is owned by an arena when the arena is released.
+             * @param node The node to destroy.
+             */
+            static void destroyAdopted(void* node);
+
         private:
             ber::Tag m_applicationTag;
             Node* m_parent;
             mutable bool m_dirty;
+            bool m_arenaAllocated;
     };
 }
 }
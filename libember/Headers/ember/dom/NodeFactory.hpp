@@ -10,6 +10,7 @@
 #define __LIBEMBER_DOM_NODEFACTORY_HPP
 
 #include "../util/Api.hpp"
+#include "../util/MonotonicArena.hpp"
 #include "../util/OctetStream.hpp"
 #include "../ber/Tag.hpp"
 #include "../ber/Type.hpp"
@@ -36,6 +37,16 @@ namespace libember { namespace dom
              */
             virtual Node* createApplicationDefinedNode(ber::Type const& type, ber::Tag const& tag) const = 0;
 
+            /**
+             * This method is called by the reader when it detected an application defined node type
+             * and the decoded tree is allocated from an arena. The default implementation ignores
+             * the arena and allocates the node on the heap by calling the overload above.
+             * @param type The decoded object type.
+             * @param tag The decoded object application tag.
+             * @param arena The arena to allocate the node from, may be null.
+             */
+            virtual Node* createApplicationDefinedNode(ber::Type const& type, ber::Tag const& tag, util::MonotonicArena* arena) const;
+
         protected:
             /**
              * Creates a default set with the specified application tag.
@@ -0,0 +1,156 @@
+/*
+    libember -- C++ 03 implementation of the Ember+ Protocol
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __LIBEMBER_DOM_STREAMINGENCODER_HPP
+#define __LIBEMBER_DOM_STREAMINGENCODER_HPP
+
+#include <cstddef>
+#include "../ber/Tag.hpp"
+#include "../util/Api.hpp"
+#include "../util/OctetStream.hpp"
+
+namespace libember { namespace dom
+{
+    /** Forward declarations */
+    class Node;
+
+    /**
+     * Encoder which writes containers with indefinite length, terminated by an
+     * end-of-contents marker. Since the length of a container does not have to be
+     * known before its first byte is written, a large tree can be encoded piece by
+     * piece: The caller opens the enclosing containers with beginContainer(),
+     * writes one element at a time with write() and drains the output stream in
+     * between, so neither the whole tree nor its encoding has to be kept in memory.
+     * Example:
+     * @code
+     * dom::StreamingEncoder encoder(output);
+     * encoder.beginContainer(glow::GlowTags::Root(), glow::GlowType::RootElementCollection.toTypeTag());
+     * for (...)
+     * {
+     *     encoder.write(*element);
+     *     send(output);
+     * }
+     * encoder.endContainer();
+     * @endcode
+     */
+    class LIBEMBER_API StreamingEncoder
+    {
+        public:
+            typedef std::size_t size_type;
+
+            /**
+             * A scoped enumeration type containing the symbolic names of the
+             * length forms used for the containers passed to write().
+             */
+            class LengthForm
+            {
+                public:
+                    enum _Domain
+                    {
+                        /** Containers are encoded with their definite length. */
+                        Definite,
+
+                        /** Containers are encoded with indefinite length. */
+                        Indefinite
+                    };
+
+                    typedef std::size_t value_type;
+
+                    /**
+                     * Non-explicit single argument constructor to allow implicit conversion.
+                     * @param value the value from _Domain with which to initialize this
+                     *      instance.
+                     */
+                    LengthForm(_Domain value)
+                        : m_value(value)
+                    {}
+
+                    /**
+                     * Return the raw value currently represented by this instance.
+                     * @return The raw value currently represented by this instance.
+                     */
+                    value_type value() const
+                    {
+                        return m_value;
+                    }
+
+                private:
+                    value_type m_value;
+            };
+
+        public:
+            /**
+             * Constructor.
+             * @param output The stream to write the encoded data to.
+             * @param form The length form used for the containers within the nodes
+             *      passed to write(). Containers opened by beginContainer() always
+             *      have indefinite length.
+             */
+            explicit StreamingEncoder(util::OctetStream& output, LengthForm const& form = LengthForm::Indefinite);
+
+            /**
+             * Returns the stream the encoded data is written to.
+             * @return The output stream.
+             */
+            util::OctetStream& output() const;
+
+            /**
+             * Returns the length form used for the containers passed to write().
+             * @return The length form.
+             */
+            LengthForm lengthForm() const;
+
+            /**
+             * Returns the number of containers that have been opened but not yet closed.
+             * @return The number of open containers.
+             */
+            size_type depth() const;
+
+            /**
+             * Writes the header of a container with indefinite length. All data
+             * written until the matching call to endContainer() is contained within.
+             * @param tag The application tag of the container.
+             * @param typeTag The type tag of the container, e.g. a universal Sequence
+             *      tag or the tag of an application defined type.
+             */
+            void beginContainer(ber::Tag const& tag, ber::Tag const& typeTag);
+
+            /**
+             * Writes the terminator of the container opened last.
+             * @throw std::runtime_error if no container is open.
+             */
+            void endContainer();
+
+            /**
+             * Encodes a node and all of its children.
+             * @param node The node to encode.
+             */
+            void write(Node const& node);
+
+        private:
+            /**
+             * Writes the end-of-contents marker.
+             */
+            void writeTerminator();
+
+            /** Prohibit assignments */
+            StreamingEncoder& operator=(StreamingEncoder const&);
+
+        private:
+            util::OctetStream& m_output;
+            LengthForm const m_form;
+            size_type m_depth;
+    };
+}
+}
+
+#ifdef LIBEMBER_HEADER_ONLY
+#  include "impl/StreamingEncoder.ipp"
+#endif
+
+#endif  // __LIBEMBER_DOM_STREAMINGENCODER_HPP
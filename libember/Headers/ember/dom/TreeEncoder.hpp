@@ -0,0 +1,115 @@
+/*
+    libember -- C++ 03 implementation of the Ember+ Protocol
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __LIBEMBER_DOM_TREEENCODER_HPP
+#define __LIBEMBER_DOM_TREEENCODER_HPP
+
+#include <cstddef>
+#include <vector>
+#include "../util/Api.hpp"
+#include "../util/OctetStream.hpp"
+
+namespace libember { namespace dom
+{
+    /** Forward declarations */
+    class Node;
+    namespace detail
+    {
+        class ListContainer;
+    }
+
+    /**
+     * Encoder for trees that are built once and encoded once, such as most
+     * response messages. Instead of computing and caching the encoded length
+     * within each container node, the encoder computes the lengths of all
+     * containers in a single post-order pass and stores them in a flat array.
+     * A second, forward pass then writes the encoding, which allows the caller
+     * to provide an output stream that holds the complete message in a single
+     * contiguous chunk.
+     * Containers derived from detail::ListContainer, which includes all Glow
+     * types, are encoded by the encoder itself. Leaves and other containers are
+     * measured and encoded by calling their encodedLength() and encode() methods.
+     * Example:
+     * @code
+     * dom::TreeEncoder encoder;
+     * std::size_t const length = encoder.measure(*root);
+     * util::OctetStream output(0, length);
+     * encoder.encode(output);
+     * @endcode
+     */
+    class LIBEMBER_API TreeEncoder
+    {
+        public:
+            typedef std::size_t size_type;
+
+            /** Constructor */
+            TreeEncoder();
+
+            /**
+             * Computes the encoded length of the tree rooted at @p root and of all
+             * containers within. The tree must not be modified until it has been
+             * encoded by a call to encode().
+             * @param root The root node of the tree to encode.
+             * @return The number of bytes required to encode the tree.
+             */
+            size_type measure(Node const& root);
+
+            /**
+             * Encodes the tree passed to the last call of measure().
+             * @param output The stream to write the encoded tree to.
+             * @throw std::runtime_error if no tree has been measured.
+             */
+            void encode(util::OctetStream& output);
+
+        private:
+            /**
+             * Computes the encoded length of a node and stores the payload lengths
+             * of the containers within in pre-order.
+             * @param node The node to measure.
+             * @return The encoded length of the node.
+             */
+            size_type measureNode(Node const& node);
+
+            /**
+             * Encodes a node, consuming the payload lengths stored by measureNode().
+             * @param node The node to encode.
+             * @param output The stream to write the encoded node to.
+             */
+            void encodeNode(Node const& node, util::OctetStream& output);
+
+            /**
+             * Returns the length of the inner frame of a container.
+             * @param container The container.
+             * @param payloadLength The sum of the encoded lengths of the children.
+             * @return The length of the type tag, the payload length and the payload.
+             */
+            static size_type innerLength(detail::ListContainer const& container, size_type payloadLength);
+
+        private:
+            typedef std::vector<size_type> LengthVector;
+
+        private:
+            Node const* m_root;
+#ifdef _MSC_VER
+#  pragma warning(push)
+#  pragma warning(disable : 4251)
+#endif
+            LengthVector m_lengths;
+#ifdef _MSC_VER
+#  pragma warning(pop)
+#endif
+            LengthVector::size_type m_cursor;
+    };
+}
+}
+
+#ifdef LIBEMBER_HEADER_ONLY
+#  include "impl/TreeEncoder.ipp"
+#endif
+
+#endif  // __LIBEMBER_DOM_TREEENCODER_HPP
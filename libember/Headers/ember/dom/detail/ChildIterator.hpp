@@ -0,0 +1,241 @@
+/*
+    libember -- C++ 03 implementation of the Ember+ Protocol
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __LIBEMBER_DOM_DETAIL_CHILDITERATOR_HPP
+#define __LIBEMBER_DOM_DETAIL_CHILDITERATOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include "../../meta/RemoveCV.hpp"
+
+//SimianIgnore
+
+namespace libember { namespace dom { namespace detail
+{
+    /**
+     * Bidirectional iterator over a contiguous sequence of child node pointers.
+     * The iterator identifies the child it refers to, along with the position
+     * the child has been found at most recently. When children are inserted or
+     * erased, the position of the child is looked up again, so the iterator
+     * keeps referring to the same child like an iterator of a list does, and
+     * remains valid until that child is erased. The end iterator stays the end
+     * iterator.
+     * @note Looking up a position is cheap as long as the child has been moved
+     *      by at most one position, e.g. while erasing children in a loop.
+     */
+    template<typename SequenceType, typename ValueType>
+    class ChildIterator
+    {
+        public:
+            typedef std::bidirectional_iterator_tag                 iterator_category;
+            typedef typename meta::RemoveConst<ValueType>::type     value_type;
+            typedef ValueType*                                      pointer;
+            typedef ValueType&                                      reference;
+            typedef std::ptrdiff_t                                  difference_type;
+            typedef std::size_t                                     size_type;
+
+        public:
+            /**
+             * Default constructor. Initializes this instance in a singular state.
+             */
+            ChildIterator();
+
+            /**
+             * Constructor, initializes an iterator referring to the child at
+             * the specified position of the passed sequence.
+             * @param sequence The sequence of child node pointers.
+             * @param index The position within the sequence. Pass the size of
+             *      the sequence to create the end iterator.
+             */
+            ChildIterator(SequenceType const* sequence, size_type index);
+
+            /**
+             * Returns the current position of the child this iterator refers to.
+             * @return The index of the child this iterator refers to, or the size
+             *      of the sequence for the end iterator.
+             */
+            size_type index() const;
+
+            /**
+             * Dereference operator.
+             * @return A reference to the child node at the current position.
+             */
+            reference operator*() const;
+
+            /**
+             * Member access operator.
+             * @return A pointer to the child node at the current position.
+             */
+            pointer operator->() const;
+
+            /**
+             * Pre increment operator, advances the iterator to the next position.
+             * @return A reference to this instance.
+             */
+            ChildIterator& operator++();
+
+            /**
+             * Post increment operator, advances the iterator to the next position.
+             * @return An iterator referring to the position before incrementing.
+             */
+            ChildIterator operator++(int);
+
+            /**
+             * Pre decrement operator, moves the iterator to the previous position.
+             * @return A reference to this instance.
+             */
+            ChildIterator& operator--();
+
+            /**
+             * Post decrement operator, moves the iterator to the previous position.
+             * @return An iterator referring to the position before decrementing.
+             */
+            ChildIterator operator--(int);
+
+            /**
+             * Equality comparison operator.
+             * @param other The iterator to compare with.
+             * @return True if both iterators refer to the same child of the
+             *      same sequence.
+             */
+            bool operator==(ChildIterator const& other) const;
+
+            /**
+             * Inequality comparison operator.
+             * @param other The iterator to compare with.
+             * @return True if the iterators refer to different children.
+             */
+            bool operator!=(ChildIterator const& other) const;
+
+        private:
+            /**
+             * Makes this iterator refer to the child at the specified position.
+             * @param index The position within the sequence.
+             */
+            void moveTo(size_type index);
+
+        private:
+            SequenceType const* m_sequence;
+            pointer m_child;
+            mutable size_type m_index;
+    };
+
+
+    /**************************************************************************/
+    /* Mandatory inline implementation                                        */
+    /**************************************************************************/
+
+    template<typename SequenceType, typename ValueType>
+    inline ChildIterator<SequenceType, ValueType>::ChildIterator()
+        : m_sequence(0), m_child(0), m_index(0)
+    {}
+
+    template<typename SequenceType, typename ValueType>
+    inline ChildIterator<SequenceType, ValueType>::ChildIterator(SequenceType const* sequence, size_type index)
+        : m_sequence(sequence), m_child(0), m_index(0)
+    {
+        moveTo(index);
+    }
+
+    template<typename SequenceType, typename ValueType>
+    inline typename ChildIterator<SequenceType, ValueType>::size_type ChildIterator<SequenceType, ValueType>::index() const
+    {
+        SequenceType const& sequence = *m_sequence;
+        size_type const size = sequence.size();
+
+        if (m_child == 0)
+        {
+            m_index = size;
+        }
+        else if (m_index >= size || sequence[m_index] != m_child)
+        {
+            if (m_index > 0 && m_index <= size && sequence[m_index - 1] == m_child)
+            {
+                m_index -= 1;
+            }
+            else if (m_index + 1 < size && sequence[m_index + 1] == m_child)
+            {
+                m_index += 1;
+            }
+            else
+            {
+                m_index = static_cast<size_type>(std::find(sequence.begin(), sequence.end(), m_child) - sequence.begin());
+            }
+        }
+        return m_index;
+    }
+
+    template<typename SequenceType, typename ValueType>
+    inline typename ChildIterator<SequenceType, ValueType>::reference ChildIterator<SequenceType, ValueType>::operator*() const
+    {
+        return *m_child;
+    }
+
+    template<typename SequenceType, typename ValueType>
+    inline typename ChildIterator<SequenceType, ValueType>::pointer ChildIterator<SequenceType, ValueType>::operator->() const
+    {
+        return m_child;
+    }
+
+    template<typename SequenceType, typename ValueType>
+    inline ChildIterator<SequenceType, ValueType>& ChildIterator<SequenceType, ValueType>::operator++()
+    {
+        moveTo(index() + 1);
+        return *this;
+    }
+
+    template<typename SequenceType, typename ValueType>
+    inline ChildIterator<SequenceType, ValueType> ChildIterator<SequenceType, ValueType>::operator++(int)
+    {
+        ChildIterator const current(*this);
+        moveTo(index() + 1);
+        return current;
+    }
+
+    template<typename SequenceType, typename ValueType>
+    inline ChildIterator<SequenceType, ValueType>& ChildIterator<SequenceType, ValueType>::operator--()
+    {
+        moveTo(index() - 1);
+        return *this;
+    }
+
+    template<typename SequenceType, typename ValueType>
+    inline ChildIterator<SequenceType, ValueType> ChildIterator<SequenceType, ValueType>::operator--(int)
+    {
+        ChildIterator const current(*this);
+        moveTo(index() - 1);
+        return current;
+    }
+
+    template<typename SequenceType, typename ValueType>
+    inline bool ChildIterator<SequenceType, ValueType>::operator==(ChildIterator const& other) const
+    {
+        return (m_sequence == other.m_sequence) && (m_child == other.m_child);
+    }
+
+    template<typename SequenceType, typename ValueType>
+    inline bool ChildIterator<SequenceType, ValueType>::operator!=(ChildIterator const& other) const
+    {
+        return !(*this == other);
+    }
+
+    template<typename SequenceType, typename ValueType>
+    inline void ChildIterator<SequenceType, ValueType>::moveTo(size_type index)
+    {
+        SequenceType const& sequence = *m_sequence;
+        m_child = index < sequence.size() ? sequence[index] : 0;
+        m_index = index;
+    }
+}
+}
+}
+
+//EndSimianIgnore
+
+#endif  // __LIBEMBER_DOM_DETAIL_CHILDITERATOR_HPP
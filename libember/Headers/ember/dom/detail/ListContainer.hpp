@@ -9,11 +9,19 @@
 #ifndef __LIBEMBER_DOM_DETAIL_LISTCONTAINER_HPP
 #define __LIBEMBER_DOM_DETAIL_LISTCONTAINER_HPP
 
-#include <list>
 #include "../Container.hpp"
+#include "../../util/SmallVector.hpp"
+#include "ChildIterator.hpp"
 
 namespace libember { namespace dom { namespace detail
 {
+    /**
+     * Container which stores its children in the order they have been inserted.
+     * The child pointers are kept in a contiguous sequence which holds up to
+     * eight children without allocating memory. Iterators identify the child
+     * they refer to, so they remain valid while other children are inserted
+     * or erased.
+     */
     class LIBEMBER_API ListContainer
         : public Container
     {
@@ -93,14 +101,16 @@ namespace libember { namespace dom { namespace detail
             virtual void eraseImpl(iterator const& first, iterator const& last);
 
         private:
-            typedef std::list<Node*> NodeList;
+            typedef util::SmallVector<Node*, 8> NodeVector;
+            typedef ChildIterator<NodeVector, Node> NodeIterator;
+            typedef ChildIterator<NodeVector, Node const> ConstNodeIterator;
 
         private:
 #ifdef _MSC_VER
 #  pragma warning(push)
 #  pragma warning(disable : 4251)
 #endif
-            NodeList m_children;
+            NodeVector m_children;
 #ifdef _MSC_VER
 #  pragma warning(pop)
 #endif
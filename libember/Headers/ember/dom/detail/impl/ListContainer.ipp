@@ -9,7 +9,6 @@
 #ifndef __LIBEMBER_DOM_DETAIL_IMPL_LISTCONTAINER_IPP
 #define __LIBEMBER_DOM_DETAIL_IMPL_LISTCONTAINER_IPP
 
-#include "../../../util/DerefIterator.hpp"
 #include "../../../util/Inline.hpp"
 #include "../../../ber/Encoding.hpp"
 
@@ -26,9 +25,11 @@ namespace libember { namespace dom { namespace detail
     {
         try
         {
-            NodeList::const_iterator const begin = other.m_children.begin();
-            NodeList::const_iterator const end   = other.m_children.end();
-            for (NodeList::const_iterator i = begin; i != end; ++i)
+            m_children.reserve(other.m_children.size());
+
+            NodeVector::const_iterator const begin = other.m_children.begin();
+            NodeVector::const_iterator const end   = other.m_children.end();
+            for (NodeVector::const_iterator i = begin; i != end; ++i)
             {
                 Node* const child = (*i)->clone();
                 m_children.push_back(child);
@@ -37,9 +38,9 @@ namespace libember { namespace dom { namespace detail
         }
         catch (...)
         {
-            NodeList::const_iterator const begin = m_children.begin();
-            NodeList::const_iterator const end   = m_children.end();
-            for (NodeList::const_iterator i = begin; i != end; ++i)
+            NodeVector::const_iterator const begin = m_children.begin();
+            NodeVector::const_iterator const end   = m_children.end();
+            for (NodeVector::const_iterator i = begin; i != end; ++i)
             {
                 delete (*i);
             }
@@ -50,11 +51,11 @@ namespace libember { namespace dom { namespace detail
     LIBEMBER_INLINE    
     ListContainer::~ListContainer()
     {
-        NodeList::const_iterator const begin = m_children.begin();
-        NodeList::const_iterator const end   = m_children.end();
-        for (NodeList::const_iterator i = begin; i != end; ++i)
+        NodeVector::const_iterator const begin = m_children.begin();
+        NodeVector::const_iterator const end   = m_children.end();
+        for (NodeVector::const_iterator i = begin; i != end; ++i)
         {
-            delete (*i); 
+            Node::destroy(*i);
         }
     }
 
@@ -73,48 +74,47 @@ namespace libember { namespace dom { namespace detail
     LIBEMBER_INLINE    
     ListContainer::iterator ListContainer::begin()
     {
-        util::DerefIterator<NodeList::iterator> const result(m_children.begin());
+        NodeIterator const result(&m_children, 0);
         return result;
     }
 
     LIBEMBER_INLINE    
     ListContainer::const_iterator ListContainer::begin() const
     {
-        util::DerefIterator<NodeList::const_iterator> const result(m_children.begin());
+        ConstNodeIterator const result(&m_children, 0);
         return result;
     }
 
     LIBEMBER_INLINE    
     ListContainer::iterator ListContainer::end()
     {
-        util::DerefIterator<NodeList::iterator> const result(m_children.end());
+        NodeIterator const result(&m_children, m_children.size());
         return result;
     }
 
     LIBEMBER_INLINE    
     ListContainer::const_iterator ListContainer::end() const
     {
-        util::DerefIterator<NodeList::const_iterator> const result(m_children.end());
+        ConstNodeIterator const result(&m_children, m_children.size());
         return result;
     }
 
     LIBEMBER_INLINE    
     ListContainer::iterator ListContainer::insertImpl(iterator const& where, Node* child)
     {
-        typedef util::DerefIterator<NodeList::iterator> DerefIteratorType;
-        NodeList::iterator const i = where.as<DerefIteratorType>().wrappedIterator();
-        return DerefIteratorType(m_children.insert(i, child));
+        NodeIterator::size_type const index = where.as<NodeIterator>().index();
+        m_children.insert(m_children.begin() + index, child);
+        return NodeIterator(&m_children, index);
     }
 
     LIBEMBER_INLINE    
     void ListContainer::eraseImpl(iterator const& first, iterator const& last)
     {
-        typedef util::DerefIterator<NodeList::iterator> DerefIteratorType;
-        NodeList::iterator const f = first.as<DerefIteratorType>().wrappedIterator();
-        NodeList::iterator const l = last.as<DerefIteratorType>().wrappedIterator();
-        for (NodeList::const_iterator i = f; i != l; ++i)
+        NodeVector::iterator const f = m_children.begin() + first.as<NodeIterator>().index();
+        NodeVector::iterator const l = m_children.begin() + last.as<NodeIterator>().index();
+        for (NodeVector::const_iterator i = f; i != l; ++i)
         {
-            delete (*i);
+            Node::destroy(*i);
         }
         m_children.erase(f, l);
     }
@@ -123,7 +123,7 @@ namespace libember { namespace dom { namespace detail
     std::size_t ListContainer::encodedPayloadLength() const
     {
         std::size_t payloadLength = 0;
-        for (NodeList::const_iterator i = m_children.begin(); i != m_children.end(); ++i)
+        for (NodeVector::const_iterator i = m_children.begin(); i != m_children.end(); ++i)
         {
             payloadLength += (*i)->encodedLength(); 
         }
@@ -133,7 +133,7 @@ namespace libember { namespace dom { namespace detail
     LIBEMBER_INLINE    
     void ListContainer::encodePayload(util::OctetStream& output) const
     {
-        for (NodeList::const_iterator i = m_children.begin(); i != m_children.end(); ++i)
+        for (NodeVector::const_iterator i = m_children.begin(); i != m_children.end(); ++i)
         {
             (*i)->encode(output); 
         }
@@ -9,6 +9,7 @@
 #ifndef __LIBEMBER_DOM_IMPL_ASYNCBERREADER_IPP
 #define __LIBEMBER_DOM_IMPL_ASYNCBERREADER_IPP
 
+#include <algorithm>
 #include <stdexcept>
 #include "../../util/Inline.hpp"
 #include "../VariantLeaf.hpp"
@@ -53,12 +54,7 @@ namespace libember { namespace dom
     void AsyncBerReader::read(value_type value)
     {
         m_buffer.append(value);
-
-        if (!m_stack.empty())
-        {
-            AsyncContainer& currentContainer = m_stack.back();
-            currentContainer.incrementBytesRead();
-        }
+        incrementBytesRead(1);
 
         bool isEofOk = false;
 
@@ -91,6 +87,132 @@ namespace libember { namespace dom
         }
     }
 
+    LIBEMBER_INLINE
+    void AsyncBerReader::read(value_type const* first, value_type const* last)
+    {
+        while (first != last)
+        {
+            value_type const* const next = readBlock(first, last);
+            if (next != first)
+            {
+                first = next;
+            }
+            else
+            {
+                read(*first);
+                ++first;
+            }
+        }
+    }
+
+    LIBEMBER_INLINE
+    AsyncBerReader::value_type const* AsyncBerReader::readBlock(value_type const* first, value_type const* last)
+    {
+        // Bytes beyond the end of the current container are left to the byte-wise
+        // path, which reports the error at exactly the same position.
+        size_type limit = static_cast<size_type>(last - first);
+        if (!m_stack.empty() && m_stack.back().length() != length_type::INDEFINITE)
+        {
+            AsyncContainer const& currentContainer = m_stack.back();
+            limit = std::min(limit, currentContainer.length() - currentContainer.bytesRead());
+        }
+
+        if (limit == 0)
+            return first;
+
+        size_type consumed = 0;
+        bool isEofOk = false;
+
+        switch(m_decodeState.value())
+        {
+            case DecodeState::Tag:
+            {
+                // Only single byte tags are decoded inline, terminators and
+                // multi-byte tags take the byte-wise path.
+                value_type const value = *first;
+                if (m_bytesRead != 0 || value == 0 || (value & 0x1F) == 0x1F)
+                    return first;
+
+                consumed = 1;
+                incrementBytesRead(consumed);
+                isEofOk = tagReady(ber::make_tag(static_cast<ber::Tag::Preamble>(value & 0xE0), static_cast<ber::Tag::Number>(value & 0x1F)));
+                break;
+            }
+
+            case DecodeState::Length:
+            {
+                if (m_bytesExpected != 0)
+                    return first;
+
+                value_type const value = *first;
+                size_type const bytes = (value & 0x80) != 0
+                    ? static_cast<size_type>(value & 0x7F) + 1
+                    : 1;
+
+                if (bytes > 5 || bytes > limit)
+                    return first;
+
+                size_type length = value;
+                if (value == 0x80)
+                {
+                    length = length_type::INDEFINITE;
+                }
+                else if (bytes > 1)
+                {
+                    length = 0;
+                    for (size_type index = 1; index < bytes; ++index)
+                        length = (length << 8) | first[index];
+                }
+
+                consumed = bytes;
+                incrementBytesRead(consumed);
+                isEofOk = lengthReady(length);
+                break;
+            }
+
+            case DecodeState::Value:
+            {
+                if (m_bytesRead == 0)
+                    m_bytesExpected = m_length;
+
+                consumed = std::min(limit, m_bytesExpected - m_bytesRead);
+                m_buffer.append(first, consumed);
+                incrementBytesRead(consumed);
+
+                m_bytesRead += consumed;
+                if (m_bytesRead == m_bytesExpected)
+                {
+                    preloadValue();
+                    isEofOk = true;
+                }
+                break;
+            }
+
+            default:
+                return first;
+        }
+
+        while (!m_stack.empty() && m_stack.back().eof())
+        {
+            if (!isEofOk)
+            {
+                throw std::runtime_error("Unexpected end of container");
+            }
+            popContainer();
+        }
+
+        return first + consumed;
+    }
+
+    LIBEMBER_INLINE
+    void AsyncBerReader::incrementBytesRead(size_type amount)
+    {
+        if (!m_stack.empty())
+        {
+            m_stack.back().incrementBytesRead(amount);
+        }
+    }
+
     LIBEMBER_INLINE
     void AsyncBerReader::resetImpl()
     {}
@@ -108,7 +230,25 @@ namespace libember { namespace dom
     }
 
     LIBEMBER_INLINE
-    dom::Node* AsyncBerReader::decodeNode(dom::NodeFactory const& factory)
+    ber::Tag const& AsyncBerReader::applicationTag() const
+    {
+        return m_appTag;
+    }
+
+    LIBEMBER_INLINE
+    ber::Tag const& AsyncBerReader::typeTag() const
+    {
+        return m_typeTag;
+    }
+
+    LIBEMBER_INLINE
+    util::OctetStream& AsyncBerReader::valueBuffer()
+    {
+        return m_valueBuffer;
+    }
+
+    LIBEMBER_INLINE
+    dom::Node* AsyncBerReader::decodeNode(dom::NodeFactory const& factory, util::MonotonicArena* arena)
     {
         ber::Type const type = ber::Type::fromTag(m_typeTag);
         ber::Tag const tag = m_appTag;
@@ -120,10 +260,10 @@ namespace libember { namespace dom
                 switch(type.value())
                 {
                     case ber::Type::Set:
-                        return new dom::Set(tag);
+                        return new (arena) dom::Set(tag);
 
                     case ber::Type::Sequence:
-                        return new dom::Sequence(tag);
+                        return new (arena) dom::Sequence(tag);
 
                     default:
                         return 0;
@@ -134,28 +274,28 @@ namespace libember { namespace dom
                 switch(type.value())
                 {
                     case ber::Type::Boolean:
-                        return new dom::VariantLeaf(tag, decode<bool>());
+                        return new (arena) dom::VariantLeaf(tag, decode<bool>());
 
                     case ber::Type::Integer:
                         if (m_length > 4)
-                            return new dom::VariantLeaf(tag, decode<long>());
+                            return new (arena) dom::VariantLeaf(tag, decode<long>());
                         else
-                            return new dom::VariantLeaf(tag, decode<int>());
+                            return new (arena) dom::VariantLeaf(tag, decode<int>());
 
                     case ber::Type::Real:
-                        return new dom::VariantLeaf(tag, decode<double>());
+                        return new (arena) dom::VariantLeaf(tag, decode<double>());
 
                     case ber::Type::UTF8String:
-                        return new dom::VariantLeaf(tag, decode<std::string>());
+                        return new (arena) dom::VariantLeaf(tag, decode<std::string>());
 
                     case ber::Type::RelativeObject:
-                        return new dom::VariantLeaf(tag, decode<ber::ObjectIdentifier>());
+                        return new (arena) dom::VariantLeaf(tag, decode<ber::ObjectIdentifier>());
 
                     case ber::Type::OctetString:
-                        return new dom::VariantLeaf(tag, decode<ber::Octets>());
+                        return new (arena) dom::VariantLeaf(tag, decode<ber::Octets>());
 
                     case ber::Type::Null:
-                        return new dom::VariantLeaf(tag, decode<ber::Null>());
+                        return new (arena) dom::VariantLeaf(tag, decode<ber::Null>());
 
                     default:
                         break;
@@ -166,7 +306,7 @@ namespace libember { namespace dom
         }
         else
         {
-            return factory.createApplicationDefinedNode(type, tag);
+            return factory.createApplicationDefinedNode(type, tag, arena);
         }
     }
 
@@ -185,26 +325,28 @@ namespace libember { namespace dom
         if ((m_bytesRead == 0 && (value & 0x1F) != 0x1F)
         ||  (m_bytesRead > 0 && (value & 0x80) == 0))
         {
-            if (m_appTag.number() == 0 && m_appTag.preamble() == 0)
-            {
-                ber::Tag const tag = libember::ber::decode<ber::Tag>(m_buffer);
-
-                m_appTag = tag;
-                m_appTag.setContainer(false);
-            }
-            else
-            {
-                ber::Tag const tag = libember::ber::decode<ber::Tag>(m_buffer);
+            return tagReady(libember::ber::decode<ber::Tag>(m_buffer));
+        }
 
-                m_isContainer = tag.isContainer();
-                m_typeTag = tag;
-            }
+        ++m_bytesRead;
+        return false;
+    }
 
-            reset(DecodeState::Length);
-            return false;
+    LIBEMBER_INLINE
+    bool AsyncBerReader::tagReady(ber::Tag const& tag)
+    {
+        if (m_appTag.number() == 0 && m_appTag.preamble() == 0)
+        {
+            m_appTag = tag;
+            m_appTag.setContainer(false);
+        }
+        else
+        {
+            m_isContainer = tag.isContainer();
+            m_typeTag = tag;
         }
 
-        ++m_bytesRead;
+        reset(DecodeState::Length);
         return false;
     }
 
@@ -230,43 +372,50 @@ namespace libember { namespace dom
 
         if (m_bytesRead == m_bytesExpected)
         {
-            ber::Type const type = ber::Type::fromTag(m_typeTag);
-            if (type.value() == 0)
-            {
-                m_outerLength = ber::decode<length_type>(m_buffer).value;
-
-                if (m_outerLength == 0)
-                    throw std::runtime_error("Zero outer length encountered");
+            return lengthReady(ber::decode<length_type>(m_buffer).value);
+        }
+        return false;
+    }
 
-                reset(DecodeState::Tag);
-            }
-            else 
-            {
-                m_length = ber::decode<length_type>(m_buffer).value;
+    LIBEMBER_INLINE
+    bool AsyncBerReader::lengthReady(size_type length)
+    {
+        ber::Type const type = ber::Type::fromTag(m_typeTag);
+        if (type.value() == 0)
+        {
+            m_outerLength = length;
 
-                bool const isEofOk = m_length == 0;
-                if (m_isContainer)
-                {
-                    reset(DecodeState::Tag);
-                    containerReady();
-                    pushContainer();
-                    disposeCurrentTLV();
-                    return isEofOk;
-                }
+            if (m_outerLength == 0)
+                throw std::runtime_error("Zero outer length encountered");
 
-                if (m_length == 0)
-                {
-                    preloadValue();
-                }
-                else
-                {
-                    reset(DecodeState::Value);
-                }
+            reset(DecodeState::Tag);
+            return false;
+        }
+        else 
+        {
+            m_length = length;
 
+            bool const isEofOk = m_length == 0;
+            if (m_isContainer)
+            {
+                reset(DecodeState::Tag);
+                containerReady();
+                pushContainer();
+                disposeCurrentTLV();
                 return isEofOk;
             }
+
+            if (m_length == 0)
+            {
+                preloadValue();
+            }
+            else
+            {
+                reset(DecodeState::Value);
+            }
+
+            return isEofOk;
         }
-        return false;
     }
 
     LIBEMBER_INLINE
@@ -21,6 +21,7 @@ namespace libember { namespace dom
         , m_root(0)
         , m_current(0)
         , m_factory(factory)
+        , m_arena(0)
     {
     }
 
@@ -60,6 +61,18 @@ namespace libember { namespace dom
         }
     }
 
+    LIBEMBER_INLINE
+    void AsyncDomReader::setArena(util::MonotonicArena* arena)
+    {
+        m_arena = arena;
+    }
+
+    LIBEMBER_INLINE
+    util::MonotonicArena* AsyncDomReader::arena() const
+    {
+        return m_arena;
+    }
+
     LIBEMBER_INLINE
     void AsyncDomReader::containerReady(dom::Node*)
     {
@@ -80,12 +93,12 @@ namespace libember { namespace dom
     {
         if ((m_current != 0) && (m_current->parent() == 0) && (m_current != m_root))
         {
-            delete m_current;
+            Node::destroy(m_current);
         }
 
         if (m_root)
         {
-            delete m_root;
+            Node::destroy(m_root);
         }
 
         m_root = 0;
@@ -96,7 +109,7 @@ namespace libember { namespace dom
     LIBEMBER_INLINE
     void AsyncDomReader::containerReady()
     {
-        dom::Node* container = decodeNode(m_factory);
+        dom::Node* container = Node::adoptByArena(decodeNode(m_factory, m_arena), m_arena);
         if (m_isRootReady)
         {
             resetImpl();
@@ -149,7 +162,7 @@ namespace libember { namespace dom
         }
         else
         {
-            dom::Node* node = decodeNode(m_factory);
+            dom::Node* node = Node::adoptByArena(decodeNode(m_factory, m_arena), m_arena);
             if (node != 0)
             {
                 dom::Container* container = dynamic_cast<dom::Container*>(m_current);
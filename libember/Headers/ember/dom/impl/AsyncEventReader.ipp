@@ -0,0 +1,95 @@
+/*
+    libember -- C++ 03 implementation of the Ember+ Protocol
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __LIBEMBER_DOM_IMPL_ASYNCEVENTREADER_IPP
+#define __LIBEMBER_DOM_IMPL_ASYNCEVENTREADER_IPP
+
+#include "../../util/Inline.hpp"
+
+namespace libember { namespace dom
+{
+    LIBEMBER_INLINE
+    AsyncEventReader::LeafValue::LeafValue(util::OctetStream& buffer)
+        : m_buffer(buffer)
+        , m_size(buffer.size())
+    {}
+
+    LIBEMBER_INLINE
+    AsyncEventReader::size_type AsyncEventReader::LeafValue::size() const
+    {
+        return m_size;
+    }
+
+    LIBEMBER_INLINE
+    AsyncEventReader::LeafValue::segment_iterator AsyncEventReader::LeafValue::segment_begin() const
+    {
+        return m_buffer.segment_begin();
+    }
+
+    LIBEMBER_INLINE
+    AsyncEventReader::LeafValue::segment_iterator AsyncEventReader::LeafValue::segment_end() const
+    {
+        return m_buffer.segment_end();
+    }
+
+
+    LIBEMBER_INLINE
+    AsyncEventReader::AsyncEventReader()
+        : m_depth(0)
+    {}
+
+    LIBEMBER_INLINE
+    AsyncEventReader::size_type AsyncEventReader::depth() const
+    {
+        return m_depth;
+    }
+
+    LIBEMBER_INLINE
+    void AsyncEventReader::enterContainer(ber::Tag const&, ber::Type const&)
+    {}
+
+    LIBEMBER_INLINE
+    void AsyncEventReader::leaf(ber::Tag const&, ber::Type const&, LeafValue const&)
+    {}
+
+    LIBEMBER_INLINE
+    void AsyncEventReader::exitContainer(ber::Tag const&, ber::Type const&)
+    {}
+
+    LIBEMBER_INLINE
+    void AsyncEventReader::resetImpl()
+    {
+        m_depth = 0;
+    }
+
+    LIBEMBER_INLINE
+    void AsyncEventReader::containerReady()
+    {
+        ++m_depth;
+        enterContainer(applicationTag(), ber::Type::fromTag(typeTag()));
+    }
+
+    LIBEMBER_INLINE
+    void AsyncEventReader::itemReady()
+    {
+        ber::Type const type = ber::Type::fromTag(typeTag());
+        if (isContainer())
+        {
+            --m_depth;
+            exitContainer(applicationTag(), type);
+        }
+        else
+        {
+            LeafValue const value(valueBuffer());
+            leaf(applicationTag(), type, value);
+        }
+    }
+}
+}
+
+#endif  // __LIBEMBER_DOM_IMPL_ASYNCEVENTREADER_IPP
@@ -16,7 +16,7 @@ namespace libember { namespace dom
 {
     LIBEMBER_INLINE
     Container::Container(ber::Tag tag)
-        : Node(tag)
+        : Node(tag), m_revision(0)
     {}
 
 #if __cplusplus >= 201103L
@@ -26,7 +26,7 @@ namespace libember { namespace dom
 #else
     LIBEMBER_INLINE
     Container::Container(Container const& other)
-        : Node(other)
+        : Node(other), m_revision(0)
     {}
 #endif
 
@@ -38,6 +38,7 @@ namespace libember { namespace dom
             if (child->parent() == 0)
             {
                 iterator const result = insertImpl(where, child);
+                ++m_revision;
                 result->setParent(this);
                 markDirty();
                 return result;
@@ -53,6 +54,12 @@ namespace libember { namespace dom
         }
     }
 
+    LIBEMBER_INLINE
+    Container::size_type Container::revision() const
+    {
+        return m_revision;
+    }
+
     LIBEMBER_INLINE
     void Container::fixParent(Node* child)
     {
@@ -80,6 +87,7 @@ namespace libember { namespace dom
     void Container::erase(iterator const& first, iterator const& last)
     {
         size_type const oldSize = size();
+        ++m_revision;
         try
         {
             eraseImpl(first, last);
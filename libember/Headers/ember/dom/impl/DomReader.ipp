@@ -9,7 +9,6 @@
 #ifndef __LIBEMBER_DOM_IMPL_DOMREADER_IPP
 #define __LIBEMBER_DOM_IMPL_DOMREADER_IPP
 
-#include <memory>
 #include <stdexcept>
 #include "../../util/Inline.hpp"
 #include "../VariantLeaf.hpp"
@@ -22,41 +21,47 @@ namespace libember { namespace dom
 {
     LIBEMBER_INLINE
     DomReader::DomReader()
-        : m_input(0), m_parentReader(0), m_length(0), m_outerLength(0)
+        : m_input(0), m_arena(0), m_parentReader(0), m_length(0), m_outerLength(0)
         , m_bytesRead(0), m_bytesAvailable(0), m_handledEof(false), m_isContainer(false)
     {}
 
     LIBEMBER_INLINE
     DomReader::DomReader(DomReader* parentReader)
-        : m_input(parentReader->m_input), m_parentReader(parentReader), m_length(0), m_outerLength(0)
+        : m_input(parentReader->m_input), m_arena(parentReader->m_arena), m_parentReader(parentReader), m_length(0), m_outerLength(0)
         , m_bytesRead(0), m_bytesAvailable(parentReader->length()), m_handledEof(0), m_isContainer(false)
     {}
 
     LIBEMBER_INLINE
-    Node* DomReader::decodeTree(util::OctetStream& input, NodeFactory const& factory)
+    Node* DomReader::decodeTree(util::OctetStream& input, NodeFactory const& factory, util::MonotonicArena* arena)
     {
         m_input = &input;
+        m_arena = arena;
         m_bytesAvailable = input.size();
 
-#if __cplusplus >= 201103L
-        std::unique_ptr<Node> root;
-#else
-        std::auto_ptr<Node> root;
-#endif
+        Node* root = 0;
         if (read())
         {
-            root.reset(decodeNode(factory));
+            root = Node::adoptByArena(decodeNode(factory), m_arena);
 
-            if ((root.get() == 0) || !isContainer())
+            try
             {
-                throw std::runtime_error("Root node is not a container");
+                if ((root == 0) || !isContainer())
+                {
+                    throw std::runtime_error("Root node is not a container");
+                }
+                DomReader tempReader(this);
+                decodeTreeRecursive(tempReader, reinterpret_cast<Container*>(root), factory);
+            }
+            catch (...)
+            {
+                Node::destroy(root);
+                throw;
             }
-            DomReader tempReader(this);
-            decodeTreeRecursive(tempReader, reinterpret_cast<Container*>(root.get()), factory);
         }
 
         m_input = 0;
-        return root.release();
+        m_arena = 0;
+        return root;
     }
 
     LIBEMBER_INLINE
@@ -64,21 +69,24 @@ namespace libember { namespace dom
     {
         while (reader.read())
         {
-#if __cplusplus >= 201103L
-            std::unique_ptr<Node> node(reader.decodeNode(factory));
-#else
-            std::auto_ptr<Node> node(reader.decodeNode(factory));
-#endif
-            if (node.get() != 0)
+            Node* const node = Node::adoptByArena(reader.decodeNode(factory), reader.m_arena);
+            if (node != 0)
             {
-                if (reader.isContainer())
+                try
                 {
-                    DomReader tempReader(&reader);
-                    decodeTreeRecursive(tempReader, reinterpret_cast<Container*>(node.get()), factory);
-                }
+                    if (reader.isContainer())
+                    {
+                        DomReader tempReader(&reader);
+                        decodeTreeRecursive(tempReader, reinterpret_cast<Container*>(node), factory);
+                    }
 
-                parent->insert(parent->end(), node.get());
-                node.release();
+                    parent->insert(parent->end(), node);
+                }
+                catch (...)
+                {
+                    Node::destroy(node);
+                    throw;
+                }
             }
         }
     }
@@ -96,10 +104,10 @@ namespace libember { namespace dom
                 switch(type.value())
                 {
                     case ber::Type::Set:
-                        return new dom::Set(tag);
+                        return new (m_arena) dom::Set(tag);
 
                     case ber::Type::Sequence:
-                        return new dom::Sequence(tag);
+                        return new (m_arena) dom::Sequence(tag);
 
                     default:
                         return 0;
@@ -110,25 +118,25 @@ namespace libember { namespace dom
                 switch(type.value())
                 {
                     case ber::Type::Boolean:
-                        return new VariantLeaf(tag, decode<bool>());
+                        return new (m_arena) VariantLeaf(tag, decode<bool>());
 
                     case ber::Type::Integer:
                         if (length() > 4)
-                            return new VariantLeaf(tag, decode<long>());
+                            return new (m_arena) VariantLeaf(tag, decode<long>());
                         else
-                            return new VariantLeaf(tag, decode<int>());
+                            return new (m_arena) VariantLeaf(tag, decode<int>());
 
                     case ber::Type::Real:
-                        return new VariantLeaf(tag, decode<double>());
+                        return new (m_arena) VariantLeaf(tag, decode<double>());
 
                     case ber::Type::UTF8String:
-                        return new VariantLeaf(tag, decode<std::string>());
+                        return new (m_arena) VariantLeaf(tag, decode<std::string>());
 
                     case ber::Type::RelativeObject:
-                        return new VariantLeaf(tag, decode<ber::ObjectIdentifier>());
+                        return new (m_arena) VariantLeaf(tag, decode<ber::ObjectIdentifier>());
 
                     case ber::Type::OctetString:
-                        return new dom::VariantLeaf(tag, decode<ber::Octets>());
+                        return new (m_arena) dom::VariantLeaf(tag, decode<ber::Octets>());
 
                     default:
                         skipCurrentItem();
@@ -139,7 +147,7 @@ namespace libember { namespace dom
         }
         else
         {
-            return factory.createApplicationDefinedNode(type, tag);
+            return factory.createApplicationDefinedNode(type, tag, m_arena);
         }
     }
 
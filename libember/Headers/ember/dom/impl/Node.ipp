@@ -16,12 +16,12 @@ namespace libember { namespace dom
 {
     LIBEMBER_INLINE
     Node::Node(ber::Tag tag)
-        : m_applicationTag(tag), m_parent(0), m_dirty(true)
+        : m_applicationTag(tag), m_parent(0), m_dirty(true), m_arenaAllocated(false)
     {}
 
     LIBEMBER_INLINE
     Node::Node(Node const& other)
-        : m_applicationTag(other.m_applicationTag), m_parent(0), m_dirty(true)
+        : m_applicationTag(other.m_applicationTag), m_parent(0), m_dirty(true), m_arenaAllocated(false)
     {}
 
     LIBEMBER_INLINE
@@ -83,13 +83,93 @@ namespace libember { namespace dom
         return encodedLengthImpl();
     }
 
+    LIBEMBER_INLINE
+    bool Node::isArenaAllocated() const
+    {
+        return m_arenaAllocated;
+    }
+
+    LIBEMBER_INLINE
+    void Node::destroy(Node* node)
+    {
+        if ((node != 0) && !node->m_arenaAllocated)
+        {
+            delete node;
+        }
+    }
+
+    LIBEMBER_INLINE
+    Node* Node::adoptByArena(Node* node, util::MonotonicArena* arena)
+    {
+        if ((node != 0) && (arena != 0) && !node->m_arenaAllocated && arena->isLastAllocation(dynamic_cast<void const*>(node)))
+        {
+            arena->adopt(node, &Node::destroyAdopted);
+            node->m_arenaAllocated = true;
+        }
+        return node;
+    }
+
+    LIBEMBER_INLINE
+    void Node::destroyAdopted(void* node)
+    {
+        static_cast<Node*>(node)->~Node();
+    }
+
+    LIBEMBER_INLINE
+    void* Node::operator new(std::size_t size)
+    {
+        return ::operator new(size);
+    }
+
+    LIBEMBER_INLINE
+    void* Node::operator new(std::size_t size, std::nothrow_t const&) throw()
+    {
+        return ::operator new(size, std::nothrow);
+    }
+
+    LIBEMBER_INLINE
+    void* Node::operator new(std::size_t, void* where)
+    {
+        return where;
+    }
+
+    LIBEMBER_INLINE
+    void* Node::operator new(std::size_t size, util::MonotonicArena* arena)
+    {
+        return (arena != 0) ? arena->allocate(size) : ::operator new(size);
+    }
+
+    LIBEMBER_INLINE
+    void Node::operator delete(void* ptr)
+    {
+        ::operator delete(ptr);
+    }
+
+    LIBEMBER_INLINE
+    void Node::operator delete(void* ptr, std::nothrow_t const&) throw()
+    {
+        ::operator delete(ptr);
+    }
+
+    LIBEMBER_INLINE
+    void Node::operator delete(void*, void*)
+    {}
+
+    LIBEMBER_INLINE
+    void Node::operator delete(void* ptr, util::MonotonicArena* arena)
+    {
+        if (arena == 0)
+        {
+            ::operator delete(ptr);
+        }
+    }
+
     LIBEMBER_INLINE
     void Node::markDirty() const
     {
-        m_dirty = true;
-        if (m_parent != 0)
+        for (Node const* node = this; (node != 0) && !node->m_dirty; node = node->m_parent)
         {
-            m_parent->markDirty();
+            node->m_dirty = true;
         }
     }
 
@@ -19,6 +19,12 @@ namespace libember { namespace dom
     NodeFactory::~NodeFactory()
     {}
 
+    LIBEMBER_INLINE
+    Node* NodeFactory::createApplicationDefinedNode(ber::Type const& type, ber::Tag const& tag, util::MonotonicArena*) const
+    {
+        return createApplicationDefinedNode(type, tag);
+    }
+
     LIBEMBER_INLINE
     Node* NodeFactory::createSet(ber::Tag const& tag) const
     {
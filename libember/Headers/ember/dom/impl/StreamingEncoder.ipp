@@ -0,0 +1,100 @@
+/*
+    libember -- C++ 03 implementation of the Ember+ Protocol
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __LIBEMBER_DOM_IMPL_STREAMINGENCODER_IPP
+#define __LIBEMBER_DOM_IMPL_STREAMINGENCODER_IPP
+
+#include <stdexcept>
+#include "../../util/Inline.hpp"
+#include "../../ber/Encoding.hpp"
+#include "../detail/ListContainer.hpp"
+
+namespace libember { namespace dom
+{
+    LIBEMBER_INLINE
+    StreamingEncoder::StreamingEncoder(util::OctetStream& output, LengthForm const& form)
+        : m_output(output)
+        , m_form(form)
+        , m_depth(0)
+    {}
+
+    LIBEMBER_INLINE
+    util::OctetStream& StreamingEncoder::output() const
+    {
+        return m_output;
+    }
+
+    LIBEMBER_INLINE
+    StreamingEncoder::LengthForm StreamingEncoder::lengthForm() const
+    {
+        return m_form;
+    }
+
+    LIBEMBER_INLINE
+    StreamingEncoder::size_type StreamingEncoder::depth() const
+    {
+        return m_depth;
+    }
+
+    LIBEMBER_INLINE
+    void StreamingEncoder::beginContainer(ber::Tag const& tag, ber::Tag const& typeTag)
+    {
+        typedef ber::Length<size_type> length_type;
+
+        ber::encode(m_output, tag.toContainer());
+        ber::encode(m_output, length_type(length_type::INDEFINITE));
+        ber::encode(m_output, typeTag.toContainer());
+        ber::encode(m_output, length_type(length_type::INDEFINITE));
+        ++m_depth;
+    }
+
+    LIBEMBER_INLINE
+    void StreamingEncoder::endContainer()
+    {
+        if (m_depth == 0)
+        {
+            throw std::runtime_error("Attempt to end a container that has not been begun.");
+        }
+
+        // Terminates the inner (type) and the outer (application tag) frame.
+        writeTerminator();
+        writeTerminator();
+        --m_depth;
+    }
+
+    LIBEMBER_INLINE
+    void StreamingEncoder::write(Node const& node)
+    {
+        detail::ListContainer const* const container = dynamic_cast<detail::ListContainer const*>(&node);
+        if (container == 0 || m_form.value() == LengthForm::Definite)
+        {
+            node.encode(m_output);
+            return;
+        }
+
+        beginContainer(container->applicationTag(), container->typeTag());
+
+        Container::const_iterator const last = container->end();
+        for (Container::const_iterator it = container->begin(); it != last; ++it)
+        {
+            write(*it);
+        }
+
+        endContainer();
+    }
+
+    LIBEMBER_INLINE
+    void StreamingEncoder::writeTerminator()
+    {
+        m_output.append(0x00U);
+        m_output.append(0x00U);
+    }
+}
+}
+
+#endif  // __LIBEMBER_DOM_IMPL_STREAMINGENCODER_IPP
@@ -0,0 +1,104 @@
+/*
+    libember -- C++ 03 implementation of the Ember+ Protocol
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __LIBEMBER_DOM_IMPL_TREEENCODER_IPP
+#define __LIBEMBER_DOM_IMPL_TREEENCODER_IPP
+
+#include <stdexcept>
+#include "../../util/Inline.hpp"
+#include "../../ber/Encoding.hpp"
+#include "../detail/ListContainer.hpp"
+
+namespace libember { namespace dom
+{
+    LIBEMBER_INLINE
+    TreeEncoder::TreeEncoder()
+        : m_root(0), m_lengths(), m_cursor(0)
+    {}
+
+    LIBEMBER_INLINE
+    TreeEncoder::size_type TreeEncoder::measure(Node const& root)
+    {
+        m_root = &root;
+        m_lengths.clear();
+        m_cursor = 0;
+        return measureNode(root);
+    }
+
+    LIBEMBER_INLINE
+    void TreeEncoder::encode(util::OctetStream& output)
+    {
+        if (m_root == 0)
+        {
+            throw std::runtime_error("Attempt to encode a tree that has not been measured.");
+        }
+
+        m_cursor = 0;
+        encodeNode(*m_root, output);
+    }
+
+    LIBEMBER_INLINE
+    TreeEncoder::size_type TreeEncoder::measureNode(Node const& node)
+    {
+        detail::ListContainer const* const container = dynamic_cast<detail::ListContainer const*>(&node);
+        if (container == 0)
+        {
+            return node.encodedLength();
+        }
+
+        // Reserve the slot before descending, so that the lengths are stored in
+        // the order in which the containers are encoded.
+        LengthVector::size_type const index = m_lengths.size();
+        m_lengths.push_back(0);
+
+        size_type payloadLength = 0;
+        Container::const_iterator const last = container->end();
+        for (Container::const_iterator it = container->begin(); it != last; ++it)
+        {
+            payloadLength += measureNode(*it);
+        }
+
+        m_lengths[index] = payloadLength;
+
+        size_type const inner = innerLength(*container, payloadLength);
+        return ber::encodedLength(container->applicationTag().toContainer()) + ber::encodedLength(ber::make_length(inner)) + inner;
+    }
+
+    LIBEMBER_INLINE
+    void TreeEncoder::encodeNode(Node const& node, util::OctetStream& output)
+    {
+        detail::ListContainer const* const container = dynamic_cast<detail::ListContainer const*>(&node);
+        if (container == 0)
+        {
+            node.encode(output);
+            return;
+        }
+
+        size_type const payloadLength = m_lengths[m_cursor++];
+
+        ber::encode(output, container->applicationTag().toContainer());
+        ber::encode(output, ber::make_length(innerLength(*container, payloadLength)));
+        ber::encode(output, container->typeTag().toContainer());
+        ber::encode(output, ber::make_length(payloadLength));
+
+        Container::const_iterator const last = container->end();
+        for (Container::const_iterator it = container->begin(); it != last; ++it)
+        {
+            encodeNode(*it, output);
+        }
+    }
+
+    LIBEMBER_INLINE
+    TreeEncoder::size_type TreeEncoder::innerLength(detail::ListContainer const& container, size_type payloadLength)
+    {
+        return ber::encodedLength(container.typeTag().toContainer()) + ber::encodedLength(ber::make_length(payloadLength)) + payloadLength;
+    }
+}
+}
+
+#endif  // __LIBEMBER_DOM_IMPL_TREEENCODER_IPP
@@ -38,7 +38,9 @@
 #include "GlowFunction.hpp"
 #include "GlowQualifiedFunction.hpp"
 #include "GlowTemplate.hpp"
-#include "GlowQualifiedTemplate.hpp"
+#include "GlowQualifiedTemplate.hpp"
+#include "ValuePool.hpp"
+#include "codec/Codec.hpp"
 
 #endif  // __LIBEMBER_GLOW_GLOW_HPP
 
@@ -9,6 +9,7 @@
 #ifndef __LIBEMBER_GLOW_CONTENTELEMENT_HPP
 #define __LIBEMBER_GLOW_CONTENTELEMENT_HPP
 
+#include <vector>
 #include "../ber/Value.hpp"
 #include "../dom/Set.hpp"
 #include "../dom/VariantLeaf.hpp"
@@ -24,6 +25,10 @@ namespace libember { namespace glow
      * Helper class that initializes a content element when it is being accessed.
      * The content element is a set which contains optional properties of a node 
      * or a parameter.
+     * Properties are looked up through an index from the context-specific tag
+     * number to the property node. The index is built on the first lookup and
+     * rebuilt whenever children have been inserted into or erased from the
+     * content set by other means than set().
      */
     class LIBEMBER_API Contents 
     {
@@ -120,14 +125,64 @@ namespace libember { namespace glow
              */
             flag_type generatePropertyFlags(const_iterator first, const_iterator last) const;
 
+            /**
+             * Returns the first property node with the specified tag.
+             * @param tag The application tag of the property to look up.
+             * @return The property node, or null if the property does not exist.
+             */
+            dom::Node* find(ber::Tag const& tag) const;
+
+            /**
+             * Returns true if the index reflects the current children of the content set.
+             * @return True if the index is up to date, otherwise false.
+             */
+            bool isIndexCurrent() const;
+
+            /**
+             * Rebuilds the index from the children of the content set.
+             */
+            void buildIndex() const;
+
+            /**
+             * Adds a node that has just been inserted into the content set to the
+             * index, provided that the index was up to date before the insertion.
+             * Otherwise, the index is left to be rebuilt by the next lookup.
+             * @param node The inserted node.
+             * @param wasIndexCurrent The result of isIndexCurrent() before the
+             *      node has been inserted.
+             */
+            void addToIndex(dom::Node* node, bool wasIndexCurrent) const;
+
+            /**
+             * Stores the passed node in the index, unless it is not a context-specific
+             * property or the index already refers to a node with the same tag.
+             * @param node The node to add.
+             */
+            void insertIntoIndex(dom::Node* node) const;
+
             /** Prohibit assignment */
             Contents& operator=(Contents const&);
 
+        private:
+            typedef std::vector<dom::Node*> NodeIndex;
+
+            /** Properties with larger tag numbers are not indexed. */
+            static size_type const MaxIndexedNumber = sizeof(flag_type) * 8;
+
         private:
             GlowContentElement& m_parent;
             ber::Tag m_contentTag;
             mutable flag_type m_propertyFlags;
             mutable dom::Set* m_container;
+#ifdef _MSC_VER
+#  pragma warning(push)
+#  pragma warning(disable : 4251)
+#endif
+            mutable NodeIndex m_index;
+#ifdef _MSC_VER
+#  pragma warning(pop)
+#endif
+            mutable dom::Set::size_type m_indexRevision;
     };
 
 
@@ -187,12 +242,10 @@ namespace libember { namespace glow
     template<typename ValueType>
     inline void Contents::set(ber::Tag const& tag, ValueType value)
     {
-        iterator const first = begin();
-        iterator const last = end();
-        iterator const result = util::find_tag(first, last, tag);
-        if (result != last)
+        dom::Node* const result = find(tag);
+        if (result != 0)
         {
-            dom::VariantLeaf* node = dynamic_cast<dom::VariantLeaf*>(&*result);
+            dom::VariantLeaf* node = dynamic_cast<dom::VariantLeaf*>(result);
             if (node != 0)
                 node->setValue(value);
             else
@@ -201,7 +254,12 @@ namespace libember { namespace glow
         else
         {
             if (m_container != 0)
-                m_container->insert(last, new dom::VariantLeaf(tag, value));
+            {
+                bool const wasIndexCurrent = isIndexCurrent();
+                dom::VariantLeaf* const node = new dom::VariantLeaf(tag, value);
+                m_container->insert(m_container->end(), node);
+                addToIndex(node, wasIndexCurrent);
+            }
             else
                 return;
         }
@@ -215,19 +273,19 @@ namespace libember { namespace glow
         iterator const where = end();
         if (m_container != 0)
         {
+            bool const wasIndexCurrent = isIndexCurrent();
             m_container->insert(where, value);
+            addToIndex(value, wasIndexCurrent);
             m_propertyFlags |= (tag.getClass() == ber::Class::ContextSpecific ? (1 << tag.number()) : 0);
         }
     }
 
     inline ber::Value Contents::get(ber::Tag const& tag) const
     {
-        const_iterator const first = begin();
-        const_iterator const last = end();
-        const_iterator const result = util::find_tag(first, last, tag);
-        if (result != last)
+        dom::Node const* const result = find(tag);
+        if (result != 0)
         {
-            dom::VariantLeaf const* node = dynamic_cast<dom::VariantLeaf const*>(&*result);
+            dom::VariantLeaf const* node = dynamic_cast<dom::VariantLeaf const*>(result);
             if (node != 0)
             {
                 return node->value();
@@ -34,6 +34,16 @@ namespace libember { namespace glow
              */
             dom::Node* createApplicationDefinedNode(ber::Type const& type, ber::Tag const& tag) const;
 
+            /**
+             * Creates a Glow specific type within the passed arena.
+             * @param type The application defined type decoded by the reader.
+             * @param tag The application tag.
+             * @param arena The arena to allocate the node from. If null, the
+             *      node is allocated on the heap.
+             * @return A Glow type or null if the provided type is unknown.
+             */
+            dom::Node* createApplicationDefinedNode(ber::Type const& type, ber::Tag const& tag, libember::util::MonotonicArena* arena) const;
+
         private:
             /** Private constructor. **/
             GlowNodeFactory();
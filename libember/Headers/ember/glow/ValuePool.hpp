@@ -0,0 +1,83 @@
+/*
+    libember -- C++ 03 implementation of the Ember+ Protocol
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __LIBEMBER_GLOW_VALUEPOOL_HPP
+#define __LIBEMBER_GLOW_VALUEPOOL_HPP
+
+#include <map>
+#include <string>
+#include "Value.hpp"
+
+namespace libember { namespace glow
+{
+    /**
+     * Stores a single Value instance for each distinct string that is added,
+     * for example the entries of an enumeration which are reported over and
+     * over again. Copies of the returned values share the stored string.
+     * @note Adding strings is not synchronized. Fill the pool before it is
+     *      shared with other threads, which may then call find concurrently.
+     */
+    class ValuePool
+    {
+        public:
+            typedef std::map<std::string, Value>::size_type size_type;
+
+            /**
+             * Returns the value stored for the passed string, adding it if it
+             * is not yet contained in the pool.
+             * @param value The string to look up.
+             * @return The value stored for the passed string.
+             */
+            Value const& intern(std::string const& value);
+
+            /**
+             * Returns the value stored for the passed string.
+             * @param value The string to look up.
+             * @return The stored value, or null if the string has not been added.
+             */
+            Value const* find(std::string const& value) const;
+
+            /**
+             * Returns the number of distinct strings in the pool.
+             * @return The number of distinct strings in the pool.
+             */
+            size_type size() const;
+
+        private:
+            std::map<std::string, Value> m_values;
+    };
+
+    /******************************************************
+     * Inline Implementation                              *
+     ******************************************************/
+
+    inline Value const& ValuePool::intern(std::string const& value)
+    {
+        std::map<std::string, Value>::iterator const it = m_values.lower_bound(value);
+        if (it != m_values.end() && it->first == value)
+        {
+            return it->second;
+        }
+
+        return m_values.insert(it, std::make_pair(value, Value(value)))->second;
+    }
+
+    inline Value const* ValuePool::find(std::string const& value) const
+    {
+        std::map<std::string, Value>::const_iterator const it = m_values.find(value);
+        return it != m_values.end() ? &it->second : 0;
+    }
+
+    inline ValuePool::size_type ValuePool::size() const
+    {
+        return m_values.size();
+    }
+}
+}
+
+#endif  // __LIBEMBER_GLOW_VALUEPOOL_HPP
@@ -12,6 +12,7 @@
 #include <sstream>
 #include "ParameterType.hpp"
 #include "../ber/Octets.hpp"
+#include "../util/RefCount.hpp"
 
 //SimianIgnore
 
@@ -32,6 +33,8 @@ namespace libember { namespace glow
          * @return The created Variant instance.
          * @note The Variant class uses reference counting, so release Ref must be called
          *      in order to indicate that the instance when it is no longer needed.
+         *      Frequently used values like zero, false or the empty string are
+         *      shared by all instances which are created with that value.
          */
         template<typename ValueType>
         static Variant* create(ValueType const value);
@@ -78,7 +81,8 @@ namespace libember { namespace glow
         ParameterType const& type() const;
 
         /**
-         * Increments the internal reference counter by one.
+         * Increments the internal reference counter by one. Reference counting
+         * is thread-safe unless LIBEMBER_SINGLE_THREADED is defined.
          * @return Returns this instance.
          */
         Variant* addRef();
@@ -102,7 +106,19 @@ namespace libember { namespace glow
         explicit Variant(ParameterType const& type);
 
     private:
-        unsigned long m_refCount;
+        /**
+         * Returns the shared instance which stores the passed value, or null if
+         * values like this one are not shared or the shared instances have not
+         * been created yet. The shared instances are created during static
+         * initialization and hold a reference which is never released.
+         * @param value The value to look up.
+         * @return The shared instance without an additional reference, or null.
+         */
+        template<typename ValueType>
+        static Variant* interned(ValueType const& value);
+
+    private:
+        libember::util::RefCount m_refCount;
         ParameterType m_type;
     };
 
@@ -112,7 +128,7 @@ namespace libember { namespace glow
      ******************************************************/
 
     inline Variant::Variant(ParameterType const& type)
-        : m_refCount(1)
+        : m_refCount()
         , m_type(type)
     {}
 
@@ -126,15 +142,13 @@ namespace libember { namespace glow
 
     inline Variant* Variant::addRef()
     {
-        m_refCount += 1;
+        m_refCount.increment();
         return this;
     }
 
     inline void Variant::releaseRef()
     {
-        m_refCount -= 1;
-
-        if (m_refCount == 0)
+        if (m_refCount.decrement())
         {
             delete this;
         }
@@ -475,13 +489,115 @@ namespace libember { namespace glow
     }
     
 
+    namespace detail
+    {
+        /**
+         * Holds the shared variant instances. They are static members of a class
+         * template so that they can be defined in this header, and they are
+         * created during static initialization, before any thread that could
+         * race on their creation has been started. Each instance is created by
+         * the regular factory, which doesn't find a shared instance yet and
+         * allocates a new one. Values created before the shared instances exist,
+         * e.g. by the constructors of other static objects, are not shared.
+         */
+        template<typename Tag>
+        struct SharedVariants
+        {
+            static Variant* zero;
+            static Variant* one;
+            static Variant* yes;
+            static Variant* no;
+            static Variant* empty;
+            static Variant* none;
+        };
+    }
+
+    /**
+     * By default, no values are shared.
+     */
+    template<typename ValueType>
+    inline Variant* Variant::interned(ValueType const&)
+    {
+        return 0;
+    }
+
+    /**
+     * Shares the integers 0 and 1, which are commonly used as defaults, minimum
+     * values and enumeration entries.
+     */
+    template<>
+    inline Variant* Variant::interned<long>(long const& value)
+    {
+        if (value == 0)
+            return detail::SharedVariants<void>::zero;
+        else if (value == 1)
+            return detail::SharedVariants<void>::one;
+
+        return 0;
+    }
+
+    /**
+     * Shares both boolean values.
+     */
+    template<>
+    inline Variant* Variant::interned<bool>(bool const& value)
+    {
+        return value
+            ? detail::SharedVariants<void>::yes
+            : detail::SharedVariants<void>::no;
+    }
+
+    /**
+     * Shares the empty string.
+     */
+    template<>
+    inline Variant* Variant::interned<std::string>(std::string const& value)
+    {
+        return value.empty()
+            ? detail::SharedVariants<void>::empty
+            : 0;
+    }
+
+    /**
+     * Shares the single instance representing the absence of a value.
+     */
+    template<>
+    inline Variant* Variant::interned<void*>(void* const&)
+    {
+        return detail::SharedVariants<void>::none;
+    }
+
+    namespace detail
+    {
+        template<typename Tag>
+        Variant* SharedVariants<Tag>::zero = Variant::create(0L);
+
+        template<typename Tag>
+        Variant* SharedVariants<Tag>::one = Variant::create(1L);
+
+        template<typename Tag>
+        Variant* SharedVariants<Tag>::yes = Variant::create(true);
+
+        template<typename Tag>
+        Variant* SharedVariants<Tag>::no = Variant::create(false);
+
+        template<typename Tag>
+        Variant* SharedVariants<Tag>::empty = Variant::create(std::string());
+
+        template<typename Tag>
+        Variant* SharedVariants<Tag>::none = Variant::create(static_cast<void*>(0));
+    }
+
     /**
      * Implementation of the Variant factory.
      */
     template<typename ValueType>
     inline Variant* Variant::create(ValueType const value)
     {
-        return new detail::VariantImpl<ValueType>(value);
+        Variant* const shared = interned<ValueType>(value);
+        return shared != 0
+            ? shared->addRef()
+            : new detail::VariantImpl<ValueType>(value);
     }
 }
 }
@@ -0,0 +1,22 @@
+/*
+    libember -- C++ 03 implementation of the Ember+ Protocol
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __LIBEMBER_GLOW_CODEC_CODEC_HPP
+#define __LIBEMBER_GLOW_CODEC_CODEC_HPP
+
+/**
+ * Schema-driven codecs for the most frequent glow messages. The elements are
+ * decoded into and encoded from plain records instead of dom trees, using a
+ * static table per record type that maps the context-specific tag numbers to
+ * the record fields. Messages containing other elements must be processed
+ * with the dom reader.
+ */
+#include "Elements.hpp"
+#include "Message.hpp"
+
+#endif  // __LIBEMBER_GLOW_CODEC_CODEC_HPP
@@ -0,0 +1,360 @@
+/*
+    libember -- C++ 03 implementation of the Ember+ Protocol
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __LIBEMBER_GLOW_CODEC_ELEMENTS_HPP
+#define __LIBEMBER_GLOW_CODEC_ELEMENTS_HPP
+
+#include "../CommandType.hpp"
+#include "Schema.hpp"
+
+//SimianIgnore
+
+namespace libember { namespace glow { namespace codec
+{
+    /**
+     * A command. The invocation of an Invoke command is not supported and is
+     * skipped when decoding.
+     */
+    struct Command
+    {
+        /** Constructor, initializes a GetDirectory command. */
+        Command()
+            : number(CommandType::GetDirectory)
+        {}
+
+        /** The command type, see glow::CommandType. */
+        long number;
+
+        /** The fields requested by a GetDirectory command, see glow::DirFieldMask. */
+        Optional<long> dirFieldMask;
+    };
+
+    /** The children of a qualified element, which are limited to commands. */
+    typedef SequenceOf<Command, ElementCollectionType> CommandCollection;
+
+    /**
+     * The contents of a parameter. The enumeration map and the stream descriptor
+     * are not supported and are skipped when decoding.
+     */
+    struct ParameterContents
+    {
+        Optional<std::string> identifier;
+        Optional<std::string> description;
+        Optional<ScalarValue> value;
+        Optional<ScalarValue> minimum;
+        Optional<ScalarValue> maximum;
+
+        /** See glow::Access. */
+        Optional<long> access;
+        Optional<std::string> format;
+        Optional<std::string> enumeration;
+        Optional<long> factor;
+        Optional<bool> isOnline;
+        Optional<std::string> formula;
+        Optional<long> step;
+        Optional<ScalarValue> defaultValue;
+
+        /** See glow::ParameterType. */
+        Optional<long> type;
+        Optional<long> streamIdentifier;
+        Optional<std::string> schemaIdentifiers;
+        Optional<ber::ObjectIdentifier> templateReference;
+    };
+
+    /**
+     * A qualified parameter, as used for value updates and subscriptions.
+     */
+    struct QualifiedParameter
+    {
+        ber::ObjectIdentifier path;
+        Optional<ParameterContents> contents;
+        CommandCollection children;
+    };
+
+    /**
+     * A qualified node, as used to request its children with a GetDirectory
+     * command. The node contents are not supported and are skipped when decoding.
+     */
+    struct QualifiedNode
+    {
+        ber::ObjectIdentifier path;
+        CommandCollection children;
+    };
+
+    /**
+     * A single value of a stream collection.
+     */
+    struct StreamEntry
+    {
+        /** Constructor */
+        StreamEntry()
+            : streamIdentifier(0)
+        {}
+
+        long streamIdentifier;
+        ScalarValue streamValue;
+    };
+
+    /**
+     * A crosspoint connection of a matrix.
+     */
+    struct Connection
+    {
+        /** Constructor */
+        Connection()
+            : target(0)
+        {}
+
+        long target;
+        Optional<ber::ObjectIdentifier> sources;
+
+        /** See glow::ConnectionOperation. */
+        Optional<long> operation;
+
+        /** See glow::ConnectionDisposition. */
+        Optional<long> disposition;
+    };
+
+    /**
+     * A qualified matrix, as used to report and change connections. All fields
+     * other than the path and the connections are skipped when decoding.
+     */
+    struct QualifiedMatrix
+    {
+        ber::ObjectIdentifier path;
+        SequenceOf<Connection, UniversalSequence> connections;
+    };
+
+
+    /**************************************************************************/
+    /* Schemas                                                                */
+    /**************************************************************************/
+
+    template<>
+    struct Schema<Command>
+    {
+        static std::size_t const FieldCount = 2;
+
+        static ber::Tag typeTag()
+        {
+            return GlowType(GlowType::Command).toTypeTag();
+        }
+
+        static Field<Command> const* fields()
+        {
+            typedef MemberField<Command, long, &Command::number> Number;
+            typedef MemberField<Command, Optional<long>, &Command::dirFieldMask> DirFieldMask;
+
+            static Field<Command> const table[FieldCount] =
+            {
+                { &Number::encodedLength, &Number::encode, &Number::decode },
+                { &DirFieldMask::encodedLength, &DirFieldMask::encode, &DirFieldMask::decode }
+            };
+            return table;
+        }
+    };
+
+    template<>
+    struct Schema<ParameterContents>
+    {
+        static std::size_t const FieldCount = 19;
+
+        static ber::Tag typeTag()
+        {
+            return ber::make_tag(ber::Class::Universal, ber::Type::Set);
+        }
+
+        static Field<ParameterContents> const* fields()
+        {
+            typedef ParameterContents R;
+            typedef MemberField<R, Optional<std::string>, &R::identifier> Identifier;
+            typedef MemberField<R, Optional<std::string>, &R::description> Description;
+            typedef MemberField<R, Optional<ScalarValue>, &R::value> Value;
+            typedef MemberField<R, Optional<ScalarValue>, &R::minimum> Minimum;
+            typedef MemberField<R, Optional<ScalarValue>, &R::maximum> Maximum;
+            typedef MemberField<R, Optional<long>, &R::access> Access;
+            typedef MemberField<R, Optional<std::string>, &R::format> Format;
+            typedef MemberField<R, Optional<std::string>, &R::enumeration> Enumeration;
+            typedef MemberField<R, Optional<long>, &R::factor> Factor;
+            typedef MemberField<R, Optional<bool>, &R::isOnline> IsOnline;
+            typedef MemberField<R, Optional<std::string>, &R::formula> Formula;
+            typedef MemberField<R, Optional<long>, &R::step> Step;
+            typedef MemberField<R, Optional<ScalarValue>, &R::defaultValue> Default;
+            typedef MemberField<R, Optional<long>, &R::type> Type;
+            typedef MemberField<R, Optional<long>, &R::streamIdentifier> StreamIdentifier;
+            typedef MemberField<R, Optional<std::string>, &R::schemaIdentifiers> SchemaIdentifiers;
+            typedef MemberField<R, Optional<ber::ObjectIdentifier>, &R::templateReference> TemplateReference;
+
+            static Field<R> const table[FieldCount] =
+            {
+                { &Identifier::encodedLength, &Identifier::encode, &Identifier::decode },
+                { &Description::encodedLength, &Description::encode, &Description::decode },
+                { &Value::encodedLength, &Value::encode, &Value::decode },
+                { &Minimum::encodedLength, &Minimum::encode, &Minimum::decode },
+                { &Maximum::encodedLength, &Maximum::encode, &Maximum::decode },
+                { &Access::encodedLength, &Access::encode, &Access::decode },
+                { &Format::encodedLength, &Format::encode, &Format::decode },
+                { &Enumeration::encodedLength, &Enumeration::encode, &Enumeration::decode },
+                { &Factor::encodedLength, &Factor::encode, &Factor::decode },
+                { &IsOnline::encodedLength, &IsOnline::encode, &IsOnline::decode },
+                { &Formula::encodedLength, &Formula::encode, &Formula::decode },
+                { &Step::encodedLength, &Step::encode, &Step::decode },
+                { &Default::encodedLength, &Default::encode, &Default::decode },
+                { &Type::encodedLength, &Type::encode, &Type::decode },
+                { &StreamIdentifier::encodedLength, &StreamIdentifier::encode, &StreamIdentifier::decode },
+                { 0, 0, 0 },    // EnumMap
+                { 0, 0, 0 },    // StreamDescriptor
+                { &SchemaIdentifiers::encodedLength, &SchemaIdentifiers::encode, &SchemaIdentifiers::decode },
+                { &TemplateReference::encodedLength, &TemplateReference::encode, &TemplateReference::decode }
+            };
+            return table;
+        }
+    };
+
+    template<>
+    struct Schema<QualifiedParameter>
+    {
+        static std::size_t const FieldCount = 3;
+
+        static ber::Tag typeTag()
+        {
+            return GlowType(GlowType::QualifiedParameter).toTypeTag();
+        }
+
+        static Field<QualifiedParameter> const* fields()
+        {
+            typedef QualifiedParameter R;
+            typedef MemberField<R, ber::ObjectIdentifier, &R::path> Path;
+            typedef MemberField<R, Optional<ParameterContents>, &R::contents> Contents;
+            typedef MemberField<R, CommandCollection, &R::children> Children;
+
+            static Field<R> const table[FieldCount] =
+            {
+                { &Path::encodedLength, &Path::encode, &Path::decode },
+                { &Contents::encodedLength, &Contents::encode, &Contents::decode },
+                { &Children::encodedLength, &Children::encode, &Children::decode }
+            };
+            return table;
+        }
+    };
+
+    template<>
+    struct Schema<QualifiedNode>
+    {
+        static std::size_t const FieldCount = 3;
+
+        static ber::Tag typeTag()
+        {
+            return GlowType(GlowType::QualifiedNode).toTypeTag();
+        }
+
+        static Field<QualifiedNode> const* fields()
+        {
+            typedef QualifiedNode R;
+            typedef MemberField<R, ber::ObjectIdentifier, &R::path> Path;
+            typedef MemberField<R, CommandCollection, &R::children> Children;
+
+            static Field<R> const table[FieldCount] =
+            {
+                { &Path::encodedLength, &Path::encode, &Path::decode },
+                { 0, 0, 0 },    // Contents
+                { &Children::encodedLength, &Children::encode, &Children::decode }
+            };
+            return table;
+        }
+    };
+
+    template<>
+    struct Schema<StreamEntry>
+    {
+        static std::size_t const FieldCount = 2;
+
+        static ber::Tag typeTag()
+        {
+            return GlowType(GlowType::StreamEntry).toTypeTag();
+        }
+
+        static Field<StreamEntry> const* fields()
+        {
+            typedef StreamEntry R;
+            typedef MemberField<R, long, &R::streamIdentifier> StreamIdentifier;
+            typedef MemberField<R, ScalarValue, &R::streamValue> StreamValue;
+
+            static Field<R> const table[FieldCount] =
+            {
+                { &StreamIdentifier::encodedLength, &StreamIdentifier::encode, &StreamIdentifier::decode },
+                { &StreamValue::encodedLength, &StreamValue::encode, &StreamValue::decode }
+            };
+            return table;
+        }
+    };
+
+    template<>
+    struct Schema<Connection>
+    {
+        static std::size_t const FieldCount = 4;
+
+        static ber::Tag typeTag()
+        {
+            return GlowType(GlowType::Connection).toTypeTag();
+        }
+
+        static Field<Connection> const* fields()
+        {
+            typedef Connection R;
+            typedef MemberField<R, long, &R::target> Target;
+            typedef MemberField<R, Optional<ber::ObjectIdentifier>, &R::sources> Sources;
+            typedef MemberField<R, Optional<long>, &R::operation> Operation;
+            typedef MemberField<R, Optional<long>, &R::disposition> Disposition;
+
+            static Field<R> const table[FieldCount] =
+            {
+                { &Target::encodedLength, &Target::encode, &Target::decode },
+                { &Sources::encodedLength, &Sources::encode, &Sources::decode },
+                { &Operation::encodedLength, &Operation::encode, &Operation::decode },
+                { &Disposition::encodedLength, &Disposition::encode, &Disposition::decode }
+            };
+            return table;
+        }
+    };
+
+    template<>
+    struct Schema<QualifiedMatrix>
+    {
+        static std::size_t const FieldCount = 6;
+
+        static ber::Tag typeTag()
+        {
+            return GlowType(GlowType::QualifiedMatrix).toTypeTag();
+        }
+
+        static Field<QualifiedMatrix> const* fields()
+        {
+            typedef QualifiedMatrix R;
+            typedef MemberField<R, ber::ObjectIdentifier, &R::path> Path;
+            typedef MemberField<R, SequenceOf<Connection, UniversalSequence>, &R::connections> Connections;
+
+            static Field<R> const table[FieldCount] =
+            {
+                { &Path::encodedLength, &Path::encode, &Path::decode },
+                { 0, 0, 0 },    // Contents
+                { 0, 0, 0 },    // Children
+                { 0, 0, 0 },    // Targets
+                { 0, 0, 0 },    // Sources
+                { &Connections::encodedLength, &Connections::encode, &Connections::decode }
+            };
+            return table;
+        }
+    };
+}
+}
+}
+
+//EndSimianIgnore
+
+#endif  // __LIBEMBER_GLOW_CODEC_ELEMENTS_HPP
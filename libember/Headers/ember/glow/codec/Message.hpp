@@ -0,0 +1,228 @@
+/*
+    libember -- C++ 03 implementation of the Ember+ Protocol
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __LIBEMBER_GLOW_CODEC_MESSAGE_HPP
+#define __LIBEMBER_GLOW_CODEC_MESSAGE_HPP
+
+#include "../GlowTags.hpp"
+#include "Elements.hpp"
+
+//SimianIgnore
+
+namespace libember { namespace glow { namespace codec
+{
+    /**
+     * Base class for the handlers passed to decodeMessage(). All methods are
+     * empty, a handler hides the ones it is interested in. Since the handler type
+     * is a template argument, the methods are bound at compile time.
+     */
+    struct MessageHandler
+    {
+        /** Called for each command of the root element collection. */
+        void command(Command const&)
+        {}
+
+        /** Called for each qualified parameter of the root element collection. */
+        void qualifiedParameter(QualifiedParameter const&)
+        {}
+
+        /** Called for each qualified node of the root element collection. */
+        void qualifiedNode(QualifiedNode const&)
+        {}
+
+        /** Called for each qualified matrix of the root element collection. */
+        void qualifiedMatrix(QualifiedMatrix const&)
+        {}
+
+        /** Called for each entry of a stream collection. */
+        void streamEntry(StreamEntry const&)
+        {}
+
+        /**
+         * Called for each element of a type that is not supported by the codec.
+         * The element is skipped.
+         * @param type The type tag of the element.
+         */
+        void unsupportedElement(ber::Tag const&)
+        {}
+    };
+
+    /**
+     * Decodes a complete glow message, i.e. a root element collection or a stream
+     * collection, and passes each element to the handler. Elements are decoded
+     * into a local record, the handler has to copy the data it wants to keep.
+     * @param input The stream containing the message.
+     * @param handler The handler to pass the elements to.
+     * @throw std::runtime_error if the message is not a valid glow message.
+     */
+    template<typename HandlerType>
+    void decodeMessage(libember::util::OctetStream& input, HandlerType& handler);
+
+    /**
+     * Encodes a root element collection containing the passed records.
+     * @param output The stream to write the message to.
+     * @param first An iterator referring to the first record.
+     * @param last An iterator referring to the position one past the last record.
+     */
+    template<typename InputIterator>
+    void encodeElements(libember::util::OctetStream& output, InputIterator first, InputIterator last);
+
+    /**
+     * Encodes a stream collection containing the passed stream entries.
+     * @param output The stream to write the message to.
+     * @param first An iterator referring to the first stream entry.
+     * @param last An iterator referring to the position one past the last entry.
+     */
+    template<typename InputIterator>
+    void encodeStreams(libember::util::OctetStream& output, InputIterator first, InputIterator last);
+
+
+    /**************************************************************************/
+    /* Mandatory inline implementation                                        */
+    /**************************************************************************/
+
+    namespace detail
+    {
+        /**
+         * Dispatches a record of a root element collection or a stream collection.
+         */
+        template<typename HandlerType>
+        inline void decodeElement(libember::util::OctetStream& input, HandlerType& handler)
+        {
+            ber::Tag tag;
+            std::size_t const length = decodeHeader(input, tag);
+            if (tag.getClass() != ber::Class::Application)
+            {
+                throw std::runtime_error("Unexpected element type");
+            }
+
+            switch(tag.number())
+            {
+                case GlowType::Command:
+                {
+                    Command record;
+                    decodeFields(input, length, record);
+                    handler.command(record);
+                    break;
+                }
+                case GlowType::QualifiedParameter:
+                {
+                    QualifiedParameter record;
+                    decodeFields(input, length, record);
+                    handler.qualifiedParameter(record);
+                    break;
+                }
+                case GlowType::QualifiedNode:
+                {
+                    QualifiedNode record;
+                    decodeFields(input, length, record);
+                    handler.qualifiedNode(record);
+                    break;
+                }
+                case GlowType::QualifiedMatrix:
+                {
+                    QualifiedMatrix record;
+                    decodeFields(input, length, record);
+                    handler.qualifiedMatrix(record);
+                    break;
+                }
+                case GlowType::StreamEntry:
+                {
+                    StreamEntry record;
+                    decodeFields(input, length, record);
+                    handler.streamEntry(record);
+                    break;
+                }
+                default:
+                    skip(input, length);
+                    handler.unsupportedElement(tag);
+                    break;
+            }
+        }
+
+        /**
+         * Encodes a collection of records tagged with GlowTags::ElementDefault(),
+         * wrapped in a root.
+         */
+        template<typename InputIterator>
+        inline void encodeRoot(libember::util::OctetStream& output, ber::Tag const& typeTag, InputIterator first, InputIterator last)
+        {
+            ber::Tag const itemTag = GlowTags::ElementDefault().toContainer();
+            std::size_t payloadLength = 0;
+            for (InputIterator it = first; it != last; ++it)
+            {
+                payloadLength += frameLength(itemTag, codec::encodedLength(*it));
+            }
+
+            std::size_t const collectionLength = frameLength(typeTag.toContainer(), payloadLength);
+            encodeHeader(output, GlowTags::Root().toContainer(), collectionLength);
+            encodeHeader(output, typeTag.toContainer(), payloadLength);
+            for (InputIterator it = first; it != last; ++it)
+            {
+                encodeHeader(output, itemTag, codec::encodedLength(*it));
+                codec::encode(output, *it);
+            }
+        }
+    }
+
+    template<typename HandlerType>
+    inline void decodeMessage(libember::util::OctetStream& input, HandlerType& handler)
+    {
+        ber::Tag tag;
+        std::size_t const rootLength = detail::decodeHeader(input, tag);
+        if (tag.toContainer() != GlowTags::Root().toContainer())
+        {
+            throw std::runtime_error("Unexpected root tag");
+        }
+
+        std::size_t const length = detail::decodeHeader(input, tag);
+        ber::Tag const type = tag.toContainer();
+        if (type != GlowType(GlowType::RootElementCollection).toTypeTag().toContainer()
+        &&  type != GlowType(GlowType::StreamCollection).toTypeTag().toContainer())
+        {
+            detail::skip(input, length);
+            handler.unsupportedElement(tag);
+        }
+        else
+        {
+            std::size_t const end = detail::endOf(input, length);
+            while (detail::hasMoreChildren(input, length, end))
+            {
+                std::size_t const itemLength = detail::decodeHeader(input, tag);
+                detail::decodeElement(input, handler);
+                if (itemLength == detail::length_type::INDEFINITE && !detail::decodeTerminator(input))
+                {
+                    throw std::runtime_error("Missing terminator");
+                }
+            }
+        }
+
+        if (rootLength == detail::length_type::INDEFINITE && !detail::decodeTerminator(input))
+        {
+            throw std::runtime_error("Missing terminator");
+        }
+    }
+
+    template<typename InputIterator>
+    inline void encodeElements(libember::util::OctetStream& output, InputIterator first, InputIterator last)
+    {
+        detail::encodeRoot(output, GlowType(GlowType::RootElementCollection).toTypeTag(), first, last);
+    }
+
+    template<typename InputIterator>
+    inline void encodeStreams(libember::util::OctetStream& output, InputIterator first, InputIterator last)
+    {
+        detail::encodeRoot(output, GlowType(GlowType::StreamCollection).toTypeTag(), first, last);
+    }
+}
+}
+}
+
+//EndSimianIgnore
+
+#endif  // __LIBEMBER_GLOW_CODEC_MESSAGE_HPP
@@ -0,0 +1,130 @@
+/*
+    libember -- C++ 03 implementation of the Ember+ Protocol
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __LIBEMBER_GLOW_CODEC_OPTIONAL_HPP
+#define __LIBEMBER_GLOW_CODEC_OPTIONAL_HPP
+
+//SimianIgnore
+
+namespace libember { namespace glow { namespace codec
+{
+    /**
+     * Holds an optional field of a record. Fields without a value are neither
+     * encoded nor modified by decoding, unless the decoded data contains them.
+     */
+    template<typename ValueType>
+    class Optional
+    {
+        public:
+            typedef ValueType value_type;
+
+            /**
+             * Constructor, initializes an instance without a value.
+             */
+            Optional();
+
+            /**
+             * Constructor, initializes an instance with the passed value.
+             * @param value The value to store.
+             */
+            Optional(value_type const& value);
+
+            /**
+             * Assigns a value.
+             * @param value The value to store.
+             * @return A reference to this instance.
+             */
+            Optional& operator=(value_type const& value);
+
+            /**
+             * Returns true if this instance holds a value.
+             * @return True if this instance holds a value, otherwise false.
+             */
+            bool hasValue() const;
+
+            /**
+             * Returns the value. If this instance does not hold a value, the value
+             * is default constructed.
+             * @return A reference to the value.
+             */
+            value_type const& value() const;
+
+            /**
+             * Returns a reference to the value and marks this instance as holding
+             * a value.
+             * @return A reference to the value.
+             */
+            value_type& value();
+
+            /**
+             * Removes the value.
+             */
+            void reset();
+
+        private:
+            value_type m_value;
+            bool m_hasValue;
+    };
+
+
+    /**************************************************************************/
+    /* Mandatory inline implementation                                        */
+    /**************************************************************************/
+
+    template<typename ValueType>
+    inline Optional<ValueType>::Optional()
+        : m_value()
+        , m_hasValue(false)
+    {}
+
+    template<typename ValueType>
+    inline Optional<ValueType>::Optional(value_type const& value)
+        : m_value(value)
+        , m_hasValue(true)
+    {}
+
+    template<typename ValueType>
+    inline Optional<ValueType>& Optional<ValueType>::operator=(value_type const& value)
+    {
+        m_value = value;
+        m_hasValue = true;
+        return *this;
+    }
+
+    template<typename ValueType>
+    inline bool Optional<ValueType>::hasValue() const
+    {
+        return m_hasValue;
+    }
+
+    template<typename ValueType>
+    inline typename Optional<ValueType>::value_type const& Optional<ValueType>::value() const
+    {
+        return m_value;
+    }
+
+    template<typename ValueType>
+    inline typename Optional<ValueType>::value_type& Optional<ValueType>::value()
+    {
+        m_hasValue = true;
+        return m_value;
+    }
+
+    template<typename ValueType>
+    inline void Optional<ValueType>::reset()
+    {
+        m_value = value_type();
+        m_hasValue = false;
+    }
+}
+}
+}
+
+//EndSimianIgnore
+
+#endif  // __LIBEMBER_GLOW_CODEC_OPTIONAL_HPP
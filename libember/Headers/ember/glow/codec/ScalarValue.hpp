@@ -0,0 +1,159 @@
+/*
+    libember -- C++ 03 implementation of the Ember+ Protocol
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __LIBEMBER_GLOW_CODEC_SCALARVALUE_HPP
+#define __LIBEMBER_GLOW_CODEC_SCALARVALUE_HPP
+
+#include <algorithm>
+#include <string>
+#include "../ParameterType.hpp"
+#include "../../ber/Octets.hpp"
+
+namespace libember { namespace glow { namespace codec
+{
+    /**
+     * Plain representation of the Value choice of the glow dtd, which is used for
+     * parameter values, limits and stream values. Unlike glow::Value, it does not
+     * allocate memory for numbers and booleans. Only the member selected by the
+     * type is meaningful.
+     */
+    struct ScalarValue
+    {
+        /** Constructor, initializes a null value. */
+        ScalarValue();
+
+        /**
+         * Initializes an integer value.
+         * @param value The integer value.
+         */
+        ScalarValue(int value);
+
+        /** @see ScalarValue(int) */
+        ScalarValue(long value);
+
+        /**
+         * Initializes a real value.
+         * @param value The real value.
+         */
+        ScalarValue(double value);
+
+        /**
+         * Initializes a boolean value.
+         * @param value The boolean value.
+         */
+        ScalarValue(bool value);
+
+        /**
+         * Initializes a string value.
+         * @param value The string value.
+         */
+        ScalarValue(std::string const& value);
+
+        /** @see ScalarValue(std::string const&) */
+        ScalarValue(char const* value);
+
+        /**
+         * Initializes an octet string value.
+         * @param value The octets.
+         */
+        ScalarValue(ber::Octets const& value);
+
+        ParameterType type;
+        long integer;
+        double real;
+        bool boolean;
+        std::string string;
+        ber::Octets octets;
+    };
+
+    /**
+     * Compares two values.
+     * @param lhs The first value.
+     * @param rhs The second value.
+     * @return True if both values have the same type and the same value of that type.
+     */
+    bool operator==(ScalarValue const& lhs, ScalarValue const& rhs);
+
+    /**
+     * Compares two values.
+     * @param lhs The first value.
+     * @param rhs The second value.
+     * @return True if the values differ in type or value.
+     */
+    bool operator!=(ScalarValue const& lhs, ScalarValue const& rhs);
+
+
+    /**************************************************************************/
+    /* Mandatory inline implementation                                        */
+    /**************************************************************************/
+
+    inline ScalarValue::ScalarValue()
+        : type(ParameterType::None), integer(0), real(0.0), boolean(false)
+    {}
+
+    inline ScalarValue::ScalarValue(int value)
+        : type(ParameterType::Integer), integer(value), real(0.0), boolean(false)
+    {}
+
+    inline ScalarValue::ScalarValue(long value)
+        : type(ParameterType::Integer), integer(value), real(0.0), boolean(false)
+    {}
+
+    inline ScalarValue::ScalarValue(double value)
+        : type(ParameterType::Real), integer(0), real(value), boolean(false)
+    {}
+
+    inline ScalarValue::ScalarValue(bool value)
+        : type(ParameterType::Boolean), integer(0), real(0.0), boolean(value)
+    {}
+
+    inline ScalarValue::ScalarValue(std::string const& value)
+        : type(ParameterType::String), integer(0), real(0.0), boolean(false), string(value)
+    {}
+
+    inline ScalarValue::ScalarValue(char const* value)
+        : type(ParameterType::String), integer(0), real(0.0), boolean(false), string(value)
+    {}
+
+    inline ScalarValue::ScalarValue(ber::Octets const& value)
+        : type(ParameterType::Octets), integer(0), real(0.0), boolean(false), octets(value)
+    {}
+
+    inline bool operator==(ScalarValue const& lhs, ScalarValue const& rhs)
+    {
+        if (lhs.type.value() != rhs.type.value())
+        {
+            return false;
+        }
+
+        switch(lhs.type.value())
+        {
+            case ParameterType::Integer:
+                return lhs.integer == rhs.integer;
+            case ParameterType::Real:
+                return lhs.real == rhs.real;
+            case ParameterType::Boolean:
+                return lhs.boolean == rhs.boolean;
+            case ParameterType::String:
+                return lhs.string == rhs.string;
+            case ParameterType::Octets:
+                return lhs.octets.size() == rhs.octets.size() && std::equal(lhs.octets.begin(), lhs.octets.end(), rhs.octets.begin());
+            default:
+                return true;
+        }
+    }
+
+    inline bool operator!=(ScalarValue const& lhs, ScalarValue const& rhs)
+    {
+        return !(lhs == rhs);
+    }
+}
+}
+}
+
+#endif  // __LIBEMBER_GLOW_CODEC_SCALARVALUE_HPP
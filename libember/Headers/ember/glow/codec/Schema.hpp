@@ -0,0 +1,646 @@
+/*
+    libember -- C++ 03 implementation of the Ember+ Protocol
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __LIBEMBER_GLOW_CODEC_SCHEMA_HPP
+#define __LIBEMBER_GLOW_CODEC_SCHEMA_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../../ber/Encoding.hpp"
+#include "../../ber/Null.hpp"
+#include "../../ber/ObjectIdentifier.hpp"
+#include "../../ber/Octets.hpp"
+#include "../../ber/Tag.hpp"
+#include "../../ber/Type.hpp"
+#include "../GlowType.hpp"
+#include "Optional.hpp"
+#include "ScalarValue.hpp"
+
+//SimianIgnore
+
+namespace libember { namespace glow { namespace codec
+{
+    /**
+     * The schema of a record type, i.e. a plain struct which corresponds to a
+     * glow type. Each specialization provides the type tag of the record and a
+     * table of its fields, indexed by the number of their context-specific tag:
+     * @code
+     * template<>
+     * struct Schema<RecordType>
+     * {
+     *     static ber::Tag typeTag();
+     *     static Field<RecordType> const* fields();
+     *     static std::size_t const FieldCount;
+     * };
+     * @endcode
+     * Fields whose number has no entry in the table are skipped when decoding.
+     */
+    template<typename RecordType>
+    struct Schema;
+
+    /**
+     * An entry of the field table of a record type. The functions operate on the
+     * universal or application tagged value within the context-specific tag of
+     * the field. Numbers that do not correspond to a field have null entries.
+     */
+    template<typename RecordType>
+    struct Field
+    {
+        /**
+         * Returns the encoded length of the field value, or 0 if the field does
+         * not hold a value and must be omitted.
+         */
+        std::size_t (*encodedLength)(RecordType const& record);
+
+        /** Encodes the field value. */
+        void (*encode)(libember::util::OctetStream& output, RecordType const& record);
+
+        /** Decodes the field value. */
+        void (*decode)(libember::util::OctetStream& input, RecordType& record);
+    };
+
+    /**
+     * Traits describing how a field type is encoded and decoded. The primary
+     * template handles record types with a Schema specialization.
+     */
+    template<typename ValueType>
+    struct FieldTraits;
+
+    /**
+     * Generates the field table entry for a member of a record.
+     */
+    template<typename RecordType, typename MemberType, MemberType RecordType::*Member>
+    struct MemberField
+    {
+        static std::size_t encodedLength(RecordType const& record)
+        {
+            return FieldTraits<MemberType>::encodedLength(record.*Member);
+        }
+
+        static void encode(libember::util::OctetStream& output, RecordType const& record)
+        {
+            FieldTraits<MemberType>::encode(output, record.*Member);
+        }
+
+        static void decode(libember::util::OctetStream& input, RecordType& record)
+        {
+            FieldTraits<MemberType>::decode(input, record.*Member);
+        }
+    };
+
+    /**
+     * A sequence of records, each of which is tagged with GlowTags::ElementDefault().
+     * CollectionType::typeTag() returns the type tag of the sequence.
+     */
+    template<typename RecordType, typename CollectionType>
+    struct SequenceOf
+    {
+        typedef std::vector<RecordType> RecordVector;
+
+        /** The records */
+        RecordVector items;
+    };
+
+    /** Type tag of a universal SEQUENCE OF, as used for matrix connections. */
+    struct UniversalSequence
+    {
+        static ber::Tag typeTag()
+        {
+            return ber::make_tag(ber::Class::Universal, ber::Type::Sequence);
+        }
+    };
+
+    /** Type tag of an ElementCollection, as used for the children of qualified elements. */
+    struct ElementCollectionType
+    {
+        static ber::Tag typeTag()
+        {
+            return GlowType(GlowType::ElementCollection).toTypeTag();
+        }
+    };
+
+    /**
+     * Contains the helper functions shared by the field traits.
+     */
+    namespace detail
+    {
+        typedef ber::Length<std::size_t> length_type;
+
+        /**
+         * Returns the length of a value that is framed by the passed tag.
+         * @param tag The tag of the frame.
+         * @param length The encoded length of the value.
+         * @return The length of the frame.
+         */
+        inline std::size_t frameLength(ber::Tag const& tag, std::size_t length)
+        {
+            return ber::encodedLength(tag) + ber::encodedLength(ber::make_length(length)) + length;
+        }
+
+        /**
+         * Encodes the tag and the length of a frame.
+         * @param output The stream to write to.
+         * @param tag The tag of the frame.
+         * @param length The encoded length of the value.
+         */
+        inline void encodeHeader(libember::util::OctetStream& output, ber::Tag const& tag, std::size_t length)
+        {
+            ber::encode(output, tag);
+            ber::encode(output, ber::make_length(length));
+        }
+
+        /**
+         * Decodes the tag and the length of a frame.
+         * @param input The stream to read from.
+         * @param tag Receives the decoded tag.
+         * @return The decoded length, which may be length_type::INDEFINITE.
+         */
+        inline std::size_t decodeHeader(libember::util::OctetStream& input, ber::Tag& tag)
+        {
+            tag = ber::decode<ber::Tag>(input);
+            return ber::decode<length_type>(input).value;
+        }
+
+        /**
+         * Decodes the header of a primitive value with the expected universal type.
+         * @param input The stream to read from.
+         * @param type The expected type.
+         * @return The length of the value.
+         * @throw std::runtime_error if the value has a different type.
+         */
+        inline std::size_t decodePrimitiveHeader(libember::util::OctetStream& input, ber::Type const& type)
+        {
+            ber::Tag tag;
+            std::size_t const length = decodeHeader(input, tag);
+            if (tag.getClass() != ber::Class::Universal || tag.number() != type.value() || length == length_type::INDEFINITE)
+            {
+                throw std::runtime_error("Unexpected field type");
+            }
+            return length;
+        }
+
+        /**
+         * Returns true and consumes the end-of-contents marker of a container
+         * with indefinite length if it is next in the input.
+         * @param input The stream to read from.
+         * @return True if the marker has been consumed.
+         */
+        inline bool decodeTerminator(libember::util::OctetStream& input)
+        {
+            if (!input.empty() && input.front() == 0x00U)
+            {
+                ber::Tag tag;
+                if (decodeHeader(input, tag) != 0)
+                {
+                    throw std::runtime_error("Invalid terminator");
+                }
+                return true;
+            }
+            return false;
+        }
+
+        /**
+         * Returns true if more children of a container follow. For containers of
+         * definite length, this depends on the number of bytes left within
+         * the container, for containers of indefinite length on whether the
+         * end-of-contents marker follows, which is consumed.
+         * @param input The stream to read from.
+         * @param length The length of the container.
+         * @param end The size of the input at the end of the container, only
+         *      meaningful for containers of definite length.
+         * @return True if another child follows.
+         */
+        inline bool hasMoreChildren(libember::util::OctetStream& input, std::size_t length, std::size_t end)
+        {
+            if (length == length_type::INDEFINITE)
+            {
+                return !decodeTerminator(input);
+            }
+
+            if (input.size() < end)
+            {
+                throw std::runtime_error("Field exceeds its container");
+            }
+            return input.size() > end;
+        }
+
+        /**
+         * Returns the size of the input at the end of a container.
+         * @param input The stream to read from, positioned at the first child.
+         * @param length The length of the container.
+         * @return The size at the end, or 0 for containers of indefinite length.
+         */
+        inline std::size_t endOf(libember::util::OctetStream const& input, std::size_t length)
+        {
+            if (length == length_type::INDEFINITE)
+            {
+                return 0;
+            }
+
+            if (length > input.size())
+            {
+                throw std::runtime_error("Incomplete input");
+            }
+            return input.size() - length;
+        }
+
+        /**
+         * Skips a value, including all nested values of containers with
+         * indefinite length.
+         * @param input The stream to read from, positioned at the value.
+         * @param length The length of the value.
+         */
+        inline void skip(libember::util::OctetStream& input, std::size_t length)
+        {
+            if (length != length_type::INDEFINITE)
+            {
+                if (input.consume(length) != length)
+                {
+                    throw std::runtime_error("Incomplete input");
+                }
+                return;
+            }
+
+            while (!decodeTerminator(input))
+            {
+                ber::Tag tag;
+                std::size_t const childLength = decodeHeader(input, tag);
+                skip(input, childLength);
+            }
+        }
+
+        /**
+         * Field traits for types with BER encoding traits.
+         */
+        template<typename ValueType>
+        struct PrimitiveFieldTraits
+        {
+            static std::size_t encodedLength(ValueType const& value)
+            {
+                return frameLength(ber::universalTag<ValueType>(), ber::EncodingTraits<ValueType>::encodedLength(value));
+            }
+
+            static void encode(libember::util::OctetStream& output, ValueType const& value)
+            {
+                encodeHeader(output, ber::universalTag<ValueType>(), ber::EncodingTraits<ValueType>::encodedLength(value));
+                ber::EncodingTraits<ValueType>::encode(output, value);
+            }
+
+            static void decode(libember::util::OctetStream& input, ValueType& value)
+            {
+                std::size_t const length = decodePrimitiveHeader(input, ber::Type::fromTag(ber::universalTag<ValueType>()));
+                value = ber::decode<ValueType>(input, length);
+            }
+        };
+    }
+
+    /**
+     * Returns the encoded length of a record, including its type tag.
+     * @param record The record.
+     * @return The number of bytes required to encode the record.
+     */
+    template<typename RecordType>
+    std::size_t encodedLength(RecordType const& record);
+
+    /**
+     * Encodes a record, including its type tag.
+     * @param output The stream to write the record to.
+     * @param record The record to encode.
+     */
+    template<typename RecordType>
+    void encode(libember::util::OctetStream& output, RecordType const& record);
+
+    /**
+     * Decodes a record, including its type tag.
+     * @param input The stream to read the record from.
+     * @param record The record to decode into. Fields that are not contained in
+     *      the input are left unchanged.
+     * @throw std::runtime_error if the input does not contain a valid record.
+     */
+    template<typename RecordType>
+    void decode(libember::util::OctetStream& input, RecordType& record);
+
+    /**
+     * Decodes the fields of a record whose type tag has already been decoded.
+     * @param input The stream to read the fields from.
+     * @param length The length of the record.
+     * @param record The record to decode into.
+     */
+    template<typename RecordType>
+    void decodeFields(libember::util::OctetStream& input, std::size_t length, RecordType& record);
+
+
+    /**************************************************************************/
+    /* Field traits                                                           */
+    /**************************************************************************/
+
+    template<typename RecordType>
+    struct FieldTraits
+    {
+        static std::size_t encodedLength(RecordType const& record)
+        {
+            return codec::encodedLength(record);
+        }
+
+        static void encode(libember::util::OctetStream& output, RecordType const& record)
+        {
+            codec::encode(output, record);
+        }
+
+        static void decode(libember::util::OctetStream& input, RecordType& record)
+        {
+            codec::decode(input, record);
+        }
+    };
+
+    template<>
+    struct FieldTraits<long> : detail::PrimitiveFieldTraits<long>
+    {};
+
+    template<>
+    struct FieldTraits<bool> : detail::PrimitiveFieldTraits<bool>
+    {};
+
+    template<>
+    struct FieldTraits<std::string> : detail::PrimitiveFieldTraits<std::string>
+    {};
+
+    template<>
+    struct FieldTraits<ber::ObjectIdentifier> : detail::PrimitiveFieldTraits<ber::ObjectIdentifier>
+    {};
+
+    template<typename ValueType>
+    struct FieldTraits<Optional<ValueType> >
+    {
+        static std::size_t encodedLength(Optional<ValueType> const& value)
+        {
+            return value.hasValue() ? FieldTraits<ValueType>::encodedLength(value.value()) : 0;
+        }
+
+        static void encode(libember::util::OctetStream& output, Optional<ValueType> const& value)
+        {
+            FieldTraits<ValueType>::encode(output, value.value());
+        }
+
+        static void decode(libember::util::OctetStream& input, Optional<ValueType>& value)
+        {
+            FieldTraits<ValueType>::decode(input, value.value());
+        }
+    };
+
+    template<>
+    struct FieldTraits<ScalarValue>
+    {
+        static std::size_t encodedLength(ScalarValue const& value)
+        {
+            switch(value.type.value())
+            {
+                case ParameterType::Integer:
+                    return detail::PrimitiveFieldTraits<long>::encodedLength(value.integer);
+                case ParameterType::Real:
+                    return detail::PrimitiveFieldTraits<double>::encodedLength(value.real);
+                case ParameterType::Boolean:
+                    return detail::PrimitiveFieldTraits<bool>::encodedLength(value.boolean);
+                case ParameterType::String:
+                    return detail::PrimitiveFieldTraits<std::string>::encodedLength(value.string);
+                case ParameterType::Octets:
+                    return detail::PrimitiveFieldTraits<ber::Octets>::encodedLength(value.octets);
+                default:
+                    return detail::PrimitiveFieldTraits<ber::Null>::encodedLength(ber::Null());
+            }
+        }
+
+        static void encode(libember::util::OctetStream& output, ScalarValue const& value)
+        {
+            switch(value.type.value())
+            {
+                case ParameterType::Integer:
+                    detail::PrimitiveFieldTraits<long>::encode(output, value.integer);
+                    break;
+                case ParameterType::Real:
+                    detail::PrimitiveFieldTraits<double>::encode(output, value.real);
+                    break;
+                case ParameterType::Boolean:
+                    detail::PrimitiveFieldTraits<bool>::encode(output, value.boolean);
+                    break;
+                case ParameterType::String:
+                    detail::PrimitiveFieldTraits<std::string>::encode(output, value.string);
+                    break;
+                case ParameterType::Octets:
+                    detail::PrimitiveFieldTraits<ber::Octets>::encode(output, value.octets);
+                    break;
+                default:
+                    detail::PrimitiveFieldTraits<ber::Null>::encode(output, ber::Null());
+                    break;
+            }
+        }
+
+        static void decode(libember::util::OctetStream& input, ScalarValue& value)
+        {
+            ber::Tag tag;
+            std::size_t const length = detail::decodeHeader(input, tag);
+            if (tag.getClass() != ber::Class::Universal || length == detail::length_type::INDEFINITE)
+            {
+                throw std::runtime_error("Unexpected value type");
+            }
+
+            switch(tag.number())
+            {
+                case ber::Type::Integer:
+                    value = ScalarValue(ber::decode<long>(input, length));
+                    break;
+                case ber::Type::Real:
+                    value = ScalarValue(ber::decode<double>(input, length));
+                    break;
+                case ber::Type::Boolean:
+                    value = ScalarValue(ber::decode<bool>(input, length));
+                    break;
+                case ber::Type::UTF8String:
+                    value = ScalarValue(ber::decode<std::string>(input, length));
+                    break;
+                case ber::Type::OctetString:
+                    value = ScalarValue(ber::decode<ber::Octets>(input, length));
+                    break;
+                case ber::Type::Null:
+                    detail::skip(input, length);
+                    value = ScalarValue();
+                    break;
+                default:
+                    throw std::runtime_error("Unexpected value type");
+            }
+        }
+    };
+
+    template<typename RecordType, typename CollectionType>
+    struct FieldTraits<SequenceOf<RecordType, CollectionType> >
+    {
+        typedef SequenceOf<RecordType, CollectionType> value_type;
+        typedef typename value_type::RecordVector::const_iterator const_iterator;
+
+        static std::size_t payloadLength(value_type const& value)
+        {
+            ber::Tag const tag = ber::make_tag(ber::Class::ContextSpecific, 0).toContainer();
+            std::size_t length = 0;
+            for (const_iterator it = value.items.begin(); it != value.items.end(); ++it)
+            {
+                length += detail::frameLength(tag, codec::encodedLength(*it));
+            }
+            return length;
+        }
+
+        static std::size_t encodedLength(value_type const& value)
+        {
+            return value.items.empty() ? 0 : detail::frameLength(CollectionType::typeTag().toContainer(), payloadLength(value));
+        }
+
+        static void encode(libember::util::OctetStream& output, value_type const& value)
+        {
+            ber::Tag const tag = ber::make_tag(ber::Class::ContextSpecific, 0).toContainer();
+            detail::encodeHeader(output, CollectionType::typeTag().toContainer(), payloadLength(value));
+            for (const_iterator it = value.items.begin(); it != value.items.end(); ++it)
+            {
+                detail::encodeHeader(output, tag, codec::encodedLength(*it));
+                codec::encode(output, *it);
+            }
+        }
+
+        static void decode(libember::util::OctetStream& input, value_type& value)
+        {
+            ber::Tag tag;
+            std::size_t const length = detail::decodeHeader(input, tag);
+            if (tag.toContainer() != CollectionType::typeTag().toContainer())
+            {
+                throw std::runtime_error("Unexpected collection type");
+            }
+
+            std::size_t const end = detail::endOf(input, length);
+            while (detail::hasMoreChildren(input, length, end))
+            {
+                std::size_t const itemLength = detail::decodeHeader(input, tag);
+                value.items.push_back(RecordType());
+                codec::decode(input, value.items.back());
+                if (itemLength == detail::length_type::INDEFINITE && !detail::decodeTerminator(input))
+                {
+                    throw std::runtime_error("Missing terminator");
+                }
+            }
+        }
+    };
+
+
+    /**************************************************************************/
+    /* Mandatory inline implementation                                        */
+    /**************************************************************************/
+
+    namespace detail
+    {
+        /**
+         * Returns the sum of the encoded lengths of all fields of a record.
+         */
+        template<typename RecordType>
+        inline std::size_t payloadLength(RecordType const& record)
+        {
+            Field<RecordType> const* const fields = Schema<RecordType>::fields();
+            std::size_t length = 0;
+            for (std::size_t number = 0; number < Schema<RecordType>::FieldCount; ++number)
+            {
+                if (fields[number].encodedLength != 0)
+                {
+                    std::size_t const fieldLength = fields[number].encodedLength(record);
+                    if (fieldLength != 0)
+                    {
+                        ber::Tag const tag = ber::make_tag(ber::Class::ContextSpecific, static_cast<ber::Tag::Number>(number));
+                        length += frameLength(tag.toContainer(), fieldLength);
+                    }
+                }
+            }
+            return length;
+        }
+    }
+
+    template<typename RecordType>
+    inline std::size_t encodedLength(RecordType const& record)
+    {
+        return detail::frameLength(Schema<RecordType>::typeTag().toContainer(), detail::payloadLength(record));
+    }
+
+    template<typename RecordType>
+    inline void encode(libember::util::OctetStream& output, RecordType const& record)
+    {
+        detail::encodeHeader(output, Schema<RecordType>::typeTag().toContainer(), detail::payloadLength(record));
+
+        Field<RecordType> const* const fields = Schema<RecordType>::fields();
+        for (std::size_t number = 0; number < Schema<RecordType>::FieldCount; ++number)
+        {
+            if (fields[number].encodedLength != 0)
+            {
+                std::size_t const fieldLength = fields[number].encodedLength(record);
+                if (fieldLength != 0)
+                {
+                    ber::Tag const tag = ber::make_tag(ber::Class::ContextSpecific, static_cast<ber::Tag::Number>(number));
+                    detail::encodeHeader(output, tag.toContainer(), fieldLength);
+                    fields[number].encode(output, record);
+                }
+            }
+        }
+    }
+
+    template<typename RecordType>
+    inline void decode(libember::util::OctetStream& input, RecordType& record)
+    {
+        ber::Tag tag;
+        std::size_t const length = detail::decodeHeader(input, tag);
+        if (tag.toContainer() != Schema<RecordType>::typeTag().toContainer())
+        {
+            throw std::runtime_error("Unexpected record type");
+        }
+
+        decodeFields(input, length, record);
+    }
+
+    template<typename RecordType>
+    inline void decodeFields(libember::util::OctetStream& input, std::size_t length, RecordType& record)
+    {
+        Field<RecordType> const* const fields = Schema<RecordType>::fields();
+        std::size_t const end = detail::endOf(input, length);
+        while (detail::hasMoreChildren(input, length, end))
+        {
+            ber::Tag tag;
+            std::size_t const fieldLength = detail::decodeHeader(input, tag);
+            std::size_t const number = tag.number();
+            if (tag.getClass() == ber::Class::ContextSpecific && number < Schema<RecordType>::FieldCount && fields[number].decode != 0)
+            {
+                std::size_t const size = input.size();
+                fields[number].decode(input, record);
+                if (fieldLength == detail::length_type::INDEFINITE)
+                {
+                    if (!detail::decodeTerminator(input))
+                    {
+                        throw std::runtime_error("Missing terminator");
+                    }
+                }
+                else if (input.size() + fieldLength != size)
+                {
+                    throw std::runtime_error("Field length mismatch");
+                }
+            }
+            else
+            {
+                detail::skip(input, fieldLength);
+            }
+        }
+    }
+}
+}
+}
+
+//EndSimianIgnore
+
+#endif  // __LIBEMBER_GLOW_CODEC_SCHEMA_HPP
@@ -23,6 +23,8 @@ namespace libember { namespace glow
         , m_contentTag(contentTag)
         , m_propertyFlags(0)
         , m_container(0)
+        , m_index()
+        , m_indexRevision(0)
     {}
 
     LIBEMBER_INLINE
@@ -67,6 +69,80 @@ namespace libember { namespace glow
         return flags;
     }
 
+    LIBEMBER_INLINE
+    dom::Node* Contents::find(ber::Tag const& tag) const
+    {
+        assureContainer();
+
+        if ((tag.getClass() == ber::Class::ContextSpecific) && (tag.number() < MaxIndexedNumber))
+        {
+            if (!isIndexCurrent())
+            {
+                buildIndex();
+            }
+
+            NodeIndex::size_type const number = static_cast<NodeIndex::size_type>(tag.number());
+            return (number < m_index.size()) ? m_index[number] : 0;
+        }
+        else
+        {
+            iterator const last = m_container->end();
+            iterator const result = util::find_tag(m_container->begin(), last, tag);
+            return (result != last) ? &*result : 0;
+        }
+    }
+
+    LIBEMBER_INLINE
+    bool Contents::isIndexCurrent() const
+    {
+        return (m_container != 0) && !m_index.empty() && (m_indexRevision == m_container->revision());
+    }
+
+    LIBEMBER_INLINE
+    void Contents::buildIndex() const
+    {
+        // The index always holds at least one slot, which marks it as built.
+        m_index.assign(1, static_cast<dom::Node*>(0));
+
+        iterator const last = m_container->end();
+        for (iterator it = m_container->begin(); it != last; ++it)
+        {
+            insertIntoIndex(&*it);
+        }
+
+        m_indexRevision = m_container->revision();
+    }
+
+    LIBEMBER_INLINE
+    void Contents::addToIndex(dom::Node* node, bool wasIndexCurrent) const
+    {
+        if (wasIndexCurrent)
+        {
+            insertIntoIndex(node);
+            m_indexRevision = m_container->revision();
+        }
+    }
+
+    LIBEMBER_INLINE
+    void Contents::insertIntoIndex(dom::Node* node) const
+    {
+        ber::Tag const tag = node->applicationTag();
+        if ((tag.getClass() == ber::Class::ContextSpecific) && (tag.number() < MaxIndexedNumber))
+        {
+            NodeIndex::size_type const number = static_cast<NodeIndex::size_type>(tag.number());
+            if (number >= m_index.size())
+            {
+                m_index.resize(number + 1, 0);
+            }
+
+            // Like a linear search, the index refers to the first node with a tag.
+            if (m_index[number] == 0)
+            {
+                m_index[number] = node;
+            }
+        }
+    }
+
     LIBEMBER_INLINE
     Contents::iterator Contents::begin()
     {
@@ -47,83 +47,89 @@ namespace libember { namespace glow
 
     LIBEMBER_INLINE
     dom::Node* GlowNodeFactory::createApplicationDefinedNode(ber::Type const& type, ber::Tag const& tag) const
+    {
+        return createApplicationDefinedNode(type, tag, 0);
+    }
+
+    LIBEMBER_INLINE
+    dom::Node* GlowNodeFactory::createApplicationDefinedNode(ber::Type const& type, ber::Tag const& tag, libember::util::MonotonicArena* arena) const
     {
         switch(type.value())
         {
             case GlowType::Command:
-                return new GlowCommand(tag);
+                return new (arena) GlowCommand(tag);
 
             case GlowType::ElementCollection:
-                return new GlowElementCollection(tag);
+                return new (arena) GlowElementCollection(tag);
 
             case GlowType::RootElementCollection:
-                return new GlowRootElementCollection(tag);
+                return new (arena) GlowRootElementCollection(tag);
 
             case GlowType::StringIntegerCollection:
-                return new GlowStringIntegerCollection(tag);
+                return new (arena) GlowStringIntegerCollection(tag);
 
             case GlowType::StringIntegerPair:
-                return new GlowStringIntegerPair(tag);
+                return new (arena) GlowStringIntegerPair(tag);
 
             case GlowType::Node:
-                return new GlowNode(tag);
+                return new (arena) GlowNode(tag);
 
             case GlowType::QualifiedNode:
-                return new GlowQualifiedNode(tag);
+                return new (arena) GlowQualifiedNode(tag);
 
             case GlowType::Parameter:
-                return new GlowParameter(tag);
+                return new (arena) GlowParameter(tag);
 
             case GlowType::QualifiedParameter:
-                return new GlowQualifiedParameter(tag);
+                return new (arena) GlowQualifiedParameter(tag);
 
             case GlowType::StreamCollection:
-                return new GlowStreamCollection(tag);
+                return new (arena) GlowStreamCollection(tag);
 
             case GlowType::StreamEntry:
-                return new GlowStreamEntry(tag);
+                return new (arena) GlowStreamEntry(tag);
 
             case GlowType::StreamDescriptor:
-                return new GlowStreamDescriptor(tag);
+                return new (arena) GlowStreamDescriptor(tag);
 
             case GlowType::Matrix:
-                return new GlowMatrix(tag);
+                return new (arena) GlowMatrix(tag);
 
             case GlowType::QualifiedMatrix:
-                return new GlowQualifiedMatrix(tag);
+                return new (arena) GlowQualifiedMatrix(tag);
 
             case GlowType::Target:
-                return new GlowTarget(tag);
+                return new (arena) GlowTarget(tag);
 
             case GlowType::Source:
-                return new GlowSource(tag);
+                return new (arena) GlowSource(tag);
 
             case GlowType::Connection:
-                return new GlowConnection(tag);
+                return new (arena) GlowConnection(tag);
 
             case GlowType::Label:
-                return new GlowLabel(tag);
+                return new (arena) GlowLabel(tag);
 
             case GlowType::Function:
-                return new GlowFunction(tag);
+                return new (arena) GlowFunction(tag);
 
             case GlowType::QualifiedFunction:
-                return new GlowQualifiedFunction(tag);
+                return new (arena) GlowQualifiedFunction(tag);
 
             case GlowType::Invocation:
-                return new GlowInvocation(tag);
+                return new (arena) GlowInvocation(tag);
 
             case GlowType::InvocationResult:
-                return new GlowInvocationResult(tag);
+                return new (arena) GlowInvocationResult(tag);
 
             case GlowType::TupleItemDescription:
-                return new GlowTupleItemDescription(tag);
+                return new (arena) GlowTupleItemDescription(tag);
 
             case GlowType::Template:
-                return new GlowTemplate(tag);
+                return new (arena) GlowTemplate(tag);
 
             case GlowType::QualifiedTemplate:
-                return new GlowQualifiedTemplate(tag);
+                return new (arena) GlowQualifiedTemplate(tag);
 
             default:
                 return 0;
@@ -0,0 +1,89 @@
+/*
+    libember -- C++ 03 implementation of the Ember+ Protocol
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __LIBEMBER_UTIL_BITSCAN_HPP
+#define __LIBEMBER_UTIL_BITSCAN_HPP
+
+#if defined(_MSC_VER)
+#  include <intrin.h>
+#endif
+
+namespace libember { namespace util
+{
+    /**
+     * Returns the number of consecutive zero bits, starting at the least
+     * significant bit of @p value.
+     * @param value A non-zero value.
+     * @return The number of trailing zero bits.
+     */
+    inline unsigned int countTrailingZeros(unsigned long long value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned int>(__builtin_ctzll(value));
+#elif defined(_MSC_VER)
+        unsigned long index;
+        unsigned long const low = static_cast<unsigned long>(value & 0xFFFFFFFFULL);
+        if (_BitScanForward(&index, low))
+        {
+            return static_cast<unsigned int>(index);
+        }
+
+        _BitScanForward(&index, static_cast<unsigned long>(value >> 32));
+        return static_cast<unsigned int>(index + 32);
+#else
+        unsigned int result = 0;
+        for (unsigned int shift = 32; shift > 0; shift /= 2)
+        {
+            unsigned long long const mask = (1ULL << shift) - 1;
+            if ((value & mask) == 0)
+            {
+                value >>= shift;
+                result += shift;
+            }
+        }
+        return result;
+#endif
+    }
+
+    /**
+     * Returns the number of consecutive zero bits, starting at the most
+     * significant bit of @p value.
+     * @param value A non-zero value.
+     * @return The number of leading zero bits.
+     */
+    inline unsigned int countLeadingZeros(unsigned long long value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned int>(__builtin_clzll(value));
+#elif defined(_MSC_VER)
+        unsigned long index;
+        unsigned long const high = static_cast<unsigned long>(value >> 32);
+        if (_BitScanReverse(&index, high))
+        {
+            return static_cast<unsigned int>(31 - index);
+        }
+
+        _BitScanReverse(&index, static_cast<unsigned long>(value & 0xFFFFFFFFULL));
+        return static_cast<unsigned int>(63 - index);
+#else
+        unsigned int result = 0;
+        for (unsigned int shift = 32; shift > 0; shift /= 2)
+        {
+            if ((value >> (64 - shift)) == 0)
+            {
+                value <<= shift;
+                result += shift;
+            }
+        }
+        return result;
+#endif
+    }
+}
+}
+
+#endif  // __LIBEMBER_UTIL_BITSCAN_HPP
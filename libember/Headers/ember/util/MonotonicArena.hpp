@@ -0,0 +1,317 @@
+/*
+    libember -- C++ 03 implementation of the Ember+ Protocol
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __LIBEMBER_UTIL_MONOTONICARENA_HPP
+#define __LIBEMBER_UTIL_MONOTONICARENA_HPP
+
+#include <cstddef>
+#include <new>
+
+namespace libember { namespace util
+{
+    /**
+     * A monotonic memory arena. Memory is handed out sequentially from larger
+     * blocks and is never returned individually. Instead, release() returns all
+     * memory that has been allocated at once. The blocks are kept for reuse, so
+     * an arena that is released after each decoded message quickly stops
+     * allocating memory from the heap at all.
+     * Objects living in the arena may be adopted by it, in which case they are
+     * destroyed by release() instead of being deleted one by one.
+     * An arena is not thread-safe, it is meant to be owned by a single reader.
+     */
+    class MonotonicArena
+    {
+        public:
+            typedef std::size_t size_type;
+
+            /**
+             * A function destroying an object which has been adopted by the arena,
+             * without freeing its memory.
+             */
+            typedef void (*Destructor)(void* object);
+
+            /**
+             * A type with the strictest alignment of the fundamental types. All
+             * memory returned by allocate() is aligned for this type.
+             */
+            union max_align_type
+            {
+                long double ld;
+                double d;
+                long l;
+                void* p;
+                void (*f)();
+            };
+
+            /**
+             * Constructor.
+             * @param blockSize The number of bytes to request from the heap
+             *      whenever the arena runs out of memory. Larger allocations
+             *      receive a block of their own.
+             */
+            explicit MonotonicArena(size_type blockSize = 4096);
+
+            /**
+             * Destructor, destroys all adopted objects and frees all blocks owned
+             * by this arena. Other objects that have been constructed in the arena
+             * are not destroyed.
+             */
+            ~MonotonicArena();
+
+            /**
+             * Allocates a block of memory.
+             * @param size The number of bytes to allocate.
+             * @return A pointer to the allocated memory, which is valid until
+             *      the next call to release().
+             * @throw std::bad_alloc if no memory is available.
+             */
+            void* allocate(size_type size);
+
+            /**
+             * Returns whether the passed pointer has been returned by the most
+             * recent call to allocate().
+             * @param pointer The pointer to check.
+             * @return True if @p pointer refers to the last allocation.
+             */
+            bool isLastAllocation(void const* pointer) const;
+
+            /**
+             * Lets the arena take ownership of an object that lives in its memory.
+             * The object is destroyed by the next call to release(), after all
+             * objects that have been adopted before it.
+             * @param object The object to adopt.
+             * @param destructor The function which destroys the object.
+             * @throw std::bad_alloc if no memory is available.
+             */
+            void adopt(void* object, Destructor destructor);
+
+            /**
+             * Destroys all adopted objects in the order they have been adopted
+             * and returns all memory allocated from this arena at once. The blocks
+             * are retained and reused by subsequent allocations. All other objects
+             * that live in the arena must have been destroyed before calling this
+             * method.
+             */
+            void release();
+
+            /**
+             * Frees all retained blocks which are currently not in use.
+             */
+            void shrink_to_fit();
+
+            /**
+             * Returns the number of bytes allocated since the last release.
+             * @return The number of bytes allocated since the last release.
+             */
+            size_type size() const;
+
+            /**
+             * Returns the number of bytes held by the blocks owned by this arena,
+             * including those which are currently unused.
+             * @return The total capacity of this arena.
+             */
+            size_type capacity() const;
+
+        private:
+            struct Block
+            {
+                Block* next;
+                size_type capacity;
+            };
+
+            /** An object adopted by the arena. */
+            struct Adoption
+            {
+                Adoption* next;
+                void* object;
+                Destructor destructor;
+            };
+
+            /** Ensures that the data following the block header is aligned. */
+            union BlockHeader
+            {
+                Block block;
+                max_align_type align;
+            };
+
+            /**
+             * Makes a block of at least the specified size the current block,
+             * either by reusing a retained block or by allocating a new one.
+             * @param size The minimum capacity of the block.
+             */
+            void acquireBlock(size_type size);
+
+            /**
+             * Frees all blocks in the passed list.
+             * @param block The first block of the list.
+             */
+            static void destroy(Block* block);
+
+            /** Prohibit copying */
+            MonotonicArena(MonotonicArena const&);
+
+            /** Prohibit assignments */
+            MonotonicArena& operator=(MonotonicArena const&);
+
+        private:
+            Block* m_used;
+            Block* m_free;
+            Adoption* m_adopted;
+            Adoption** m_adoptedTail;
+            unsigned char* m_last;
+            unsigned char* m_current;
+            size_type m_remaining;
+            size_type m_size;
+            size_type m_capacity;
+            size_type const m_blockSize;
+    };
+
+    /**************************************************************************/
+    /* Mandatory inline implementation                                        */
+    /**************************************************************************/
+
+    inline MonotonicArena::MonotonicArena(size_type blockSize)
+        : m_used(0)
+        , m_free(0)
+        , m_adopted(0)
+        , m_adoptedTail(&m_adopted)
+        , m_last(0)
+        , m_current(0)
+        , m_remaining(0)
+        , m_size(0)
+        , m_capacity(0)
+        , m_blockSize(blockSize)
+    {}
+
+    inline MonotonicArena::~MonotonicArena()
+    {
+        release();
+        destroy(m_used);
+        destroy(m_free);
+    }
+
+    inline void* MonotonicArena::allocate(size_type size)
+    {
+        size_type const alignment = sizeof(max_align_type);
+        size = ((size + alignment - 1) / alignment) * alignment;
+
+        if (size > m_remaining || m_current == 0)
+        {
+            acquireBlock(size);
+        }
+
+        m_last = m_current;
+        m_current += size;
+        m_remaining -= size;
+        m_size += size;
+        return m_last;
+    }
+
+    inline bool MonotonicArena::isLastAllocation(void const* pointer) const
+    {
+        return (m_last != 0) && (pointer == m_last);
+    }
+
+    inline void MonotonicArena::adopt(void* object, Destructor destructor)
+    {
+        Adoption* const adoption = static_cast<Adoption*>(allocate(sizeof(Adoption)));
+        adoption->next = 0;
+        adoption->object = object;
+        adoption->destructor = destructor;
+
+        *m_adoptedTail = adoption;
+        m_adoptedTail = &adoption->next;
+    }
+
+    inline void MonotonicArena::release()
+    {
+        for (Adoption* adoption = m_adopted; adoption != 0; adoption = adoption->next)
+        {
+            adoption->destructor(adoption->object);
+        }
+
+        m_adopted = 0;
+        m_adoptedTail = &m_adopted;
+
+        while (m_used != 0)
+        {
+            Block* const block = m_used;
+            m_used = block->next;
+            block->next = m_free;
+            m_free = block;
+        }
+
+        m_last = 0;
+        m_current = 0;
+        m_remaining = 0;
+        m_size = 0;
+    }
+
+    inline void MonotonicArena::shrink_to_fit()
+    {
+        for (Block* block = m_free; block != 0; block = block->next)
+        {
+            m_capacity -= block->capacity;
+        }
+
+        destroy(m_free);
+        m_free = 0;
+    }
+
+    inline MonotonicArena::size_type MonotonicArena::size() const
+    {
+        return m_size;
+    }
+
+    inline MonotonicArena::size_type MonotonicArena::capacity() const
+    {
+        return m_capacity;
+    }
+
+    inline void MonotonicArena::acquireBlock(size_type size)
+    {
+        Block* block = 0;
+        for (Block** link = &m_free; *link != 0; link = &(*link)->next)
+        {
+            if ((*link)->capacity >= size)
+            {
+                block = *link;
+                *link = block->next;
+                break;
+            }
+        }
+
+        if (block == 0)
+        {
+            size_type const capacity = (size > m_blockSize) ? size : m_blockSize;
+            BlockHeader* const header = static_cast<BlockHeader*>(::operator new(sizeof(BlockHeader) + capacity));
+
+            block = &header->block;
+            block->capacity = capacity;
+            m_capacity += capacity;
+        }
+
+        block->next = m_used;
+        m_used = block;
+        m_current = reinterpret_cast<unsigned char*>(reinterpret_cast<BlockHeader*>(block) + 1);
+        m_remaining = block->capacity;
+    }
+
+    inline void MonotonicArena::destroy(Block* block)
+    {
+        while (block != 0)
+        {
+            Block* const next = block->next;
+            ::operator delete(reinterpret_cast<BlockHeader*>(block));
+            block = next;
+        }
+    }
+}
+}
+
+#endif  // __LIBEMBER_UTIL_MONOTONICARENA_HPP
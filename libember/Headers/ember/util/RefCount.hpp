@@ -0,0 +1,104 @@
+/*
+    libember -- C++ 03 implementation of the Ember+ Protocol
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __LIBEMBER_UTIL_REFCOUNT_HPP
+#define __LIBEMBER_UTIL_REFCOUNT_HPP
+
+/**
+ * Reference counts are updated atomically unless LIBEMBER_SINGLE_THREADED is
+ * defined, in which case plain arithmetic is used. Only define it if objects
+ * with shared ownership are never accessed from more than one thread.
+ * Compilers which provide neither the MSVC nor the GCC atomic intrinsics use
+ * plain arithmetic as well, and a warning is emitted. Objects with shared
+ * ownership, e.g. copies of a glow::Value, must then not be passed between
+ * threads.
+ */
+#if !defined(LIBEMBER_SINGLE_THREADED)
+#  if defined(_MSC_VER)
+#    include <intrin.h>
+#  elif !defined(__GNUC__) && !defined(__clang__)
+#    define LIBEMBER_REFCOUNT_NOT_ATOMIC
+#    pragma message("libember: Atomic reference counting is not supported by this compiler, reference counts are not thread-safe. Define LIBEMBER_SINGLE_THREADED to acknowledge this.")
+#  endif
+#endif
+
+namespace libember { namespace util
+{
+    /**
+     * A reference counter which may be incremented and decremented
+     * concurrently from several threads, as long as the compiler provides
+     * atomic intrinsics (see above).
+     */
+    class RefCount
+    {
+        public:
+            /**
+             * Constructor, initializes the counter with a single reference.
+             */
+            RefCount();
+
+            /**
+             * Increments the counter by one.
+             */
+            void increment();
+
+            /**
+             * Decrements the counter by one.
+             * @return Returns true if the last reference has been released.
+             */
+            bool decrement();
+
+        private:
+            /** Prohibit copy construction */
+            RefCount(RefCount const&);
+
+            /** Prohibit assignment */
+            RefCount& operator=(RefCount const&);
+
+        private:
+            long m_value;
+    };
+
+    /**************************************************************************/
+    /* Mandatory inline implementation                                        */
+    /**************************************************************************/
+
+    inline RefCount::RefCount()
+        : m_value(1)
+    {}
+
+    inline void RefCount::increment()
+    {
+#if defined(LIBEMBER_SINGLE_THREADED) || defined(LIBEMBER_REFCOUNT_NOT_ATOMIC)
+        m_value += 1;
+#elif defined(_MSC_VER)
+        _InterlockedIncrement(&m_value);
+#elif defined(__ATOMIC_RELAXED)
+        __atomic_add_fetch(&m_value, 1, __ATOMIC_RELAXED);
+#else
+        __sync_add_and_fetch(&m_value, 1);
+#endif
+    }
+
+    inline bool RefCount::decrement()
+    {
+#if defined(LIBEMBER_SINGLE_THREADED) || defined(LIBEMBER_REFCOUNT_NOT_ATOMIC)
+        m_value -= 1;
+        return m_value == 0;
+#elif defined(_MSC_VER)
+        return _InterlockedDecrement(&m_value) == 0;
+#elif defined(__ATOMIC_ACQ_REL)
+        return __atomic_sub_fetch(&m_value, 1, __ATOMIC_ACQ_REL) == 0;
+#else
+        return __sync_sub_and_fetch(&m_value, 1) == 0;
+#endif
+    }
+}
+}
+
+#endif  // __LIBEMBER_UTIL_REFCOUNT_HPP
@@ -0,0 +1,294 @@
+/*
+    libember -- C++ 03 implementation of the Ember+ Protocol
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __LIBEMBER_UTIL_SMALLVECTOR_HPP
+#define __LIBEMBER_UTIL_SMALLVECTOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+
+//SimianIgnore
+
+namespace libember { namespace util
+{
+    /**
+     * A contiguous sequence which stores up to InlineCapacity elements within
+     * the instance itself and only allocates memory from the heap when more
+     * elements are added. The value type must be cheap to copy and assign, it
+     * is intended for pointers and other small scalar types.
+     * @note Inserting or erasing elements invalidates all pointers to elements
+     *      following the position of the modification, growing the sequence
+     *      invalidates all of them.
+     */
+    template<typename ValueType, std::size_t InlineCapacity>
+    class SmallVector
+    {
+        public:
+            typedef ValueType                   value_type;
+            typedef value_type&                 reference;
+            typedef value_type const&           const_reference;
+            typedef value_type*                 pointer;
+            typedef value_type const*           const_pointer;
+            typedef pointer                     iterator;
+            typedef const_pointer               const_iterator;
+            typedef std::size_t                 size_type;
+            typedef std::ptrdiff_t              difference_type;
+
+        public:
+            /**
+             * Constructor, initializes an empty sequence using the inline storage.
+             */
+            SmallVector();
+
+            /**
+             * Destructor, frees the heap storage if the sequence has outgrown
+             * the inline storage.
+             */
+            ~SmallVector();
+
+            /**
+             * Returns true if the sequence contains no elements.
+             * @return True if the sequence is empty, otherwise false.
+             */
+            bool empty() const;
+
+            /**
+             * Returns the number of elements in the sequence.
+             * @return The number of elements in the sequence.
+             */
+            size_type size() const;
+
+            /**
+             * Returns the number of elements the sequence can hold without
+             * allocating memory.
+             * @return The current capacity.
+             */
+            size_type capacity() const;
+
+            /**
+             * Returns an iterator referring to the first element.
+             * @return An iterator referring to the first element.
+             */
+            iterator begin();
+
+            /** @see begin() */
+            const_iterator begin() const;
+
+            /**
+             * Returns an iterator referring to the position one past the last element.
+             * @return An iterator referring to the position one past the last element.
+             */
+            iterator end();
+
+            /** @see end() */
+            const_iterator end() const;
+
+            /**
+             * Returns a reference to the element at the specified index.
+             * @param index The index of the element, must be less than size().
+             * @return A reference to the element.
+             */
+            reference operator[](size_type index);
+
+            /** @see operator[]() */
+            const_reference operator[](size_type index) const;
+
+            /**
+             * Makes sure that the sequence can hold at least the specified number
+             * of elements without allocating memory.
+             * @param count The minimum capacity.
+             */
+            void reserve(size_type count);
+
+            /**
+             * Appends an element to the end of the sequence.
+             * @param value The element to append.
+             */
+            void push_back(value_type const& value);
+
+            /**
+             * Inserts an element before the specified position.
+             * @param where The position to insert the element at.
+             * @param value The element to insert.
+             * @return An iterator referring to the inserted element.
+             */
+            iterator insert(iterator where, value_type const& value);
+
+            /**
+             * Removes the elements in the range [first, last).
+             * @param first The first element to remove.
+             * @param last The position one past the last element to remove.
+             * @return An iterator referring to the element that followed the
+             *      last removed element.
+             */
+            iterator erase(iterator first, iterator last);
+
+            /**
+             * Removes all elements. The capacity remains unchanged.
+             */
+            void clear();
+
+        private:
+            /** Prohibit copying */
+            SmallVector(SmallVector const&);
+
+            /** Prohibit assignments */
+            SmallVector& operator=(SmallVector const&);
+
+            /**
+             * Returns true if the elements are currently stored in the inline storage.
+             * @return True if the inline storage is used, otherwise false.
+             */
+            bool isInline() const;
+
+        private:
+            pointer m_data;
+            size_type m_size;
+            size_type m_capacity;
+            value_type m_inline[InlineCapacity];
+    };
+
+
+    /**************************************************************************/
+    /* Mandatory inline implementation                                        */
+    /**************************************************************************/
+
+    template<typename ValueType, std::size_t InlineCapacity>
+    inline SmallVector<ValueType, InlineCapacity>::SmallVector()
+        : m_data(m_inline), m_size(0), m_capacity(InlineCapacity)
+    {}
+
+    template<typename ValueType, std::size_t InlineCapacity>
+    inline SmallVector<ValueType, InlineCapacity>::~SmallVector()
+    {
+        if (!isInline())
+        {
+            delete [] m_data;
+        }
+    }
+
+    template<typename ValueType, std::size_t InlineCapacity>
+    inline bool SmallVector<ValueType, InlineCapacity>::empty() const
+    {
+        return (m_size == 0);
+    }
+
+    template<typename ValueType, std::size_t InlineCapacity>
+    inline typename SmallVector<ValueType, InlineCapacity>::size_type SmallVector<ValueType, InlineCapacity>::size() const
+    {
+        return m_size;
+    }
+
+    template<typename ValueType, std::size_t InlineCapacity>
+    inline typename SmallVector<ValueType, InlineCapacity>::size_type SmallVector<ValueType, InlineCapacity>::capacity() const
+    {
+        return m_capacity;
+    }
+
+    template<typename ValueType, std::size_t InlineCapacity>
+    inline typename SmallVector<ValueType, InlineCapacity>::iterator SmallVector<ValueType, InlineCapacity>::begin()
+    {
+        return m_data;
+    }
+
+    template<typename ValueType, std::size_t InlineCapacity>
+    inline typename SmallVector<ValueType, InlineCapacity>::const_iterator SmallVector<ValueType, InlineCapacity>::begin() const
+    {
+        return m_data;
+    }
+
+    template<typename ValueType, std::size_t InlineCapacity>
+    inline typename SmallVector<ValueType, InlineCapacity>::iterator SmallVector<ValueType, InlineCapacity>::end()
+    {
+        return m_data + m_size;
+    }
+
+    template<typename ValueType, std::size_t InlineCapacity>
+    inline typename SmallVector<ValueType, InlineCapacity>::const_iterator SmallVector<ValueType, InlineCapacity>::end() const
+    {
+        return m_data + m_size;
+    }
+
+    template<typename ValueType, std::size_t InlineCapacity>
+    inline typename SmallVector<ValueType, InlineCapacity>::reference SmallVector<ValueType, InlineCapacity>::operator[](size_type index)
+    {
+        return m_data[index];
+    }
+
+    template<typename ValueType, std::size_t InlineCapacity>
+    inline typename SmallVector<ValueType, InlineCapacity>::const_reference SmallVector<ValueType, InlineCapacity>::operator[](size_type index) const
+    {
+        return m_data[index];
+    }
+
+    template<typename ValueType, std::size_t InlineCapacity>
+    inline void SmallVector<ValueType, InlineCapacity>::reserve(size_type count)
+    {
+        if (count > m_capacity)
+        {
+            pointer const data = new value_type[count];
+            std::copy(m_data, m_data + m_size, data);
+
+            if (!isInline())
+            {
+                delete [] m_data;
+            }
+
+            m_data = data;
+            m_capacity = count;
+        }
+    }
+
+    template<typename ValueType, std::size_t InlineCapacity>
+    inline void SmallVector<ValueType, InlineCapacity>::push_back(value_type const& value)
+    {
+        insert(end(), value);
+    }
+
+    template<typename ValueType, std::size_t InlineCapacity>
+    inline typename SmallVector<ValueType, InlineCapacity>::iterator SmallVector<ValueType, InlineCapacity>::insert(iterator where, value_type const& value)
+    {
+        size_type const index = static_cast<size_type>(where - m_data);
+        if (m_size == m_capacity)
+        {
+            reserve((m_capacity > 0) ? (m_capacity * 2) : 4);
+        }
+
+        pointer const position = m_data + index;
+        std::copy_backward(position, m_data + m_size, m_data + m_size + 1);
+        *position = value;
+        ++m_size;
+        return position;
+    }
+
+    template<typename ValueType, std::size_t InlineCapacity>
+    inline typename SmallVector<ValueType, InlineCapacity>::iterator SmallVector<ValueType, InlineCapacity>::erase(iterator first, iterator last)
+    {
+        iterator const end = m_data + m_size;
+        std::copy(last, end, first);
+        m_size -= static_cast<size_type>(last - first);
+        return first;
+    }
+
+    template<typename ValueType, std::size_t InlineCapacity>
+    inline void SmallVector<ValueType, InlineCapacity>::clear()
+    {
+        m_size = 0;
+    }
+
+    template<typename ValueType, std::size_t InlineCapacity>
+    inline bool SmallVector<ValueType, InlineCapacity>::isInline() const
+    {
+        return (m_data == m_inline);
+    }
+}
+}
+
+//EndSimianIgnore
+
+#endif  // __LIBEMBER_UTIL_SMALLVECTOR_HPP
@@ -10,6 +10,7 @@
 #define __LIBEMBER_UTIL_STREAMBUFFER_HPP
 
 #include "detail/StreamBufferIterator.hpp"
+#include "detail/StreamBufferSegmentIterator.hpp"
 
 namespace libember { namespace util
 {
@@ -21,6 +22,12 @@ namespace libember { namespace util
      * The StreamBuffer calls the flush method when its size reaches the provided maxSize.
      * Afterwards, the content will be reset. To avoid automatic flushing, set the maxSize
      * to 0.
+     * The elements are stored in a list of chunks whose size may be specified when the
+     * buffer is created. Chunks that are no longer in use are kept in a free list and
+     * reused by subsequent appends, so a buffer that is filled and flushed repeatedly
+     * only allocates memory until it has reached its peak size. Each chunk is allocated
+     * in a single block along with its bookkeeping, so ValueType must be a trivial type
+     * such as unsigned char.
      */
     template<typename ValueType, unsigned short ChunkSize = 256>
     class StreamBuffer
@@ -37,14 +44,20 @@ namespace libember { namespace util
             typedef detail::StreamBufferIterator<ValueType, ChunkSize>          iterator;
             typedef detail::StreamBufferIterator<ValueType const, ChunkSize>    const_iterator;
 
+            typedef detail::StreamBufferSegmentIterator<ValueType, ChunkSize>   segment_iterator;
+            typedef typename segment_iterator::value_type                       segment_type;
+
         public:
             /** 
              * Default constructor, initializes an empty stream buffer. 
              * @param maxSize The maximum size the buffer may have. Whenever it reaches this limit
              *      the virtual flush is being called and the buffer content will be reset. Set this value
              *      to zero to avoid flushing.
+             * @param chunkSize The size of a single chunk in bytes. Larger chunks reduce the
+             *      number of allocations, e.g. 4096 matches the size of typical socket writes.
+             *      Defaults to the ChunkSize template parameter.
              */
-            explicit StreamBuffer(size_type maxSize = 0);
+            explicit StreamBuffer(size_type maxSize = 0, size_type chunkSize = ChunkSize);
 
             /**
              * Copy constructor that initializes the instance with a copy
@@ -58,11 +71,16 @@ namespace libember { namespace util
             virtual ~StreamBuffer();
 
             /**
-             * Clear the stream buffer. Releasing all memory allocated to the
-             * controlled sequence.
+             * Clear the stream buffer. The chunks allocated to the controlled
+             * sequence are kept for reuse, call shrink_to_fit to release them.
              */
             void clear();
 
+            /**
+             * Releases the memory of all chunks that are currently not in use.
+             */
+            void shrink_to_fit();
+
             /**
              * Returns whether or not the buffer is currently empty.
              * @return True if if the buffer is currently empty, otherwise false.
@@ -82,6 +100,12 @@ namespace libember { namespace util
              */
             size_type max_size() const;
 
+            /**
+             * Returns the size of a single chunk in bytes.
+             * @return The size of a single chunk in bytes.
+             */
+            size_type chunk_size() const;
+
             /**
              * Returns the first item in the stream
              * @return The value of the first item. If the stream buffer is
@@ -121,6 +145,22 @@ namespace libember { namespace util
              */
             iterator end();
 
+            /**
+             * Returns an iterator referring to the first contiguous segment of the
+             * stream buffer. Each segment is a pair of a pointer to the first element
+             * of a chunk and the number of elements stored in the chunk. Segments
+             * are never empty.
+             * @return An iterator referring to the first segment.
+             */
+            segment_iterator segment_begin() const;
+
+            /**
+             * Returns an iterator referring to the segment one past the last
+             * segment of the stream buffer.
+             * @return An iterator referring to the segment one past the last segment.
+             */
+            segment_iterator segment_end() const;
+
             /**
              * Appends a sequence of elements referred to by @p first and @p last
              * to the back of this buffer.
@@ -138,6 +178,14 @@ namespace libember { namespace util
              */
             void append(value_type value);
 
+            /**
+             * Appends @p count contiguous elements to the back of this buffer.
+             * The elements are copied into the tail chunk block-wise.
+             * @param first a pointer to the first element to add.
+             * @param count the number of elements to add.
+             */
+            void append(const_pointer first, size_type count);
+
             /** 
              * Removes the specified number of elements from the front of
              * this stream.
@@ -214,25 +262,32 @@ namespace libember { namespace util
             node_type* shrink();
 
             /** 
-             * Calls the allocator's allocate method in order to allocate memory for a new chunk.
+             * Takes an empty node from the free list or allocates a new one if
+             * the free list is empty.
              * @return Returns the allocated node.
              */
-            static node_type* allocate();
+            node_type* allocate();
+
+            /**
+             * Returns a node that has been obtained through a call to allocate
+             * to the free list.
+             * @param node a pointer to the node that is no longer in use.
+             */
+            void deallocate(node_type* node);
 
             /**
-             * Helper function that encapsulates the underlying method
-             * of destroying and deallocating a node instance dynamically
-             * allocated through a call to allocate.
-             * @param node a pointer to the node that should be destroyed
-             *      and deallocated.
+             * Destroys and deallocates all nodes of the list starting at @p node.
+             * @param node The first node of the list to destroy.
              */
-            static void deallocate(node_type* node);
+            static void destroy(node_type* node);
 
         private:
             node_type *m_head;
             node_type *m_tail;
+            node_type *m_free;
             size_type m_size;
             size_type m_maxsize;
+            size_type m_chunkCapacity;
    };
 
 
@@ -241,28 +296,38 @@ namespace libember { namespace util
    /**************************************************************************/
 
     template<typename ValueType, unsigned short ChunkSize>
-    inline StreamBuffer<ValueType, ChunkSize>::StreamBuffer(size_type maxSize)
-        : m_head(0), m_tail(0), m_size(0), m_maxsize(maxSize ? maxSize : 0xFFFFFFFF)
+    inline StreamBuffer<ValueType, ChunkSize>::StreamBuffer(size_type maxSize, size_type chunkSize)
+        : m_head(0), m_tail(0), m_free(0), m_size(0), m_maxsize(maxSize ? maxSize : 0xFFFFFFFF)
+        , m_chunkCapacity(chunkSize >= sizeof(value_type) ? chunkSize / sizeof(value_type) : 1)
     {}
 
     template<typename ValueType, unsigned short ChunkSize>
     inline StreamBuffer<ValueType, ChunkSize>::StreamBuffer(StreamBuffer const& other)
-        : m_head(0), m_tail(0), m_size(other.m_size), m_maxsize(other.m_maxsize)
+        : m_head(0), m_tail(0), m_free(0), m_size(other.m_size), m_maxsize(other.m_maxsize)
+        , m_chunkCapacity(other.m_chunkCapacity)
     {
-        node_type const* currentSource = other.m_head;
-        while (currentSource != 0)
+        try
         {
-            node_type* const newNode = new node_type(*currentSource);
-            if (m_head != 0)
+            node_type const* currentSource = other.m_head;
+            while (currentSource != 0)
             {
-                m_head->next() = newNode;
+                node_type* const newNode = node_type::create(*currentSource);
+                if (m_head != 0)
+                {
+                    m_tail->next() = newNode;
+                }
+                else
+                {
+                    m_head = newNode;
+                }
+                m_tail = newNode;
+                currentSource = currentSource->next();
             }
-            else
-            {
-                m_head = newNode;
-            }
-            m_tail = newNode;
-            currentSource = currentSource->next();
+        }
+        catch (...)
+        {
+            destroy(m_head);
+            throw;
         }
     }
 
@@ -270,36 +335,40 @@ namespace libember { namespace util
     template<typename ValueType, unsigned short ChunkSize>
     inline StreamBuffer<ValueType, ChunkSize>::~StreamBuffer()
     {
-        for (node_type* it = m_head; it != 0; /* Nothing */)
+        destroy(m_head);
+        destroy(m_free);
+    }
+
+    template<typename ValueType, unsigned short ChunkSize>
+    inline void StreamBuffer<ValueType, ChunkSize>::clear()
+    {
+        if (m_head != 0)
         {
-            node_type* const current = it;
-            it = current->next();
-            deallocate(current);
+            m_tail->next() = m_free;
+            m_free = m_head;
+            m_head = 0;
+            m_tail = 0;
         }
+        m_size = 0;
     }
 
     template<typename ValueType, unsigned short ChunkSize>
-    inline void StreamBuffer<ValueType, ChunkSize>::clear()
+    inline void StreamBuffer<ValueType, ChunkSize>::shrink_to_fit()
     {
-        StreamBuffer empty(m_maxsize);
-        swap(empty);
+        destroy(m_free);
+        m_free = 0;
     }
 
     template<typename ValueType, unsigned short ChunkSize>
     inline bool StreamBuffer<ValueType, ChunkSize>::empty() const
     {
-        return (m_head == 0);
+        return (m_size == 0);
     }
 
     template<typename ValueType, unsigned short ChunkSize>
     inline typename StreamBuffer<ValueType, ChunkSize>::size_type StreamBuffer<ValueType, ChunkSize>::size() const
     {
-        size_type result = 0;
-        for (node_type const* current = m_head; current != 0; current = current->next())
-        {
-            result += current->size();
-        }
-        return result;
+        return m_size;
     }
 
     template<typename ValueType, unsigned short ChunkSize>
@@ -308,6 +377,12 @@ namespace libember { namespace util
         return m_maxsize;
     }
 
+    template<typename ValueType, unsigned short ChunkSize>
+    inline typename StreamBuffer<ValueType, ChunkSize>::size_type StreamBuffer<ValueType, ChunkSize>::chunk_size() const
+    {
+        return m_chunkCapacity * sizeof(value_type);
+    }
+
     template<typename ValueType, unsigned short ChunkSize>
     inline void StreamBuffer<ValueType, ChunkSize>::append(value_type value)
     {
@@ -334,7 +409,11 @@ namespace libember { namespace util
     {
         size_type const distance = std::distance(first, last);
         size_type const maxsize = max_size();
-        if (distance > maxsize)
+        if (distance == 0)
+        {
+            return;
+        }
+        else if (distance > maxsize)
         {
             for( /* Nothing */; first != last; ++first)
             {
@@ -360,6 +439,12 @@ namespace libember { namespace util
         }
     }
 
+    template<typename ValueType, unsigned short ChunkSize>
+    inline void StreamBuffer<ValueType, ChunkSize>::append(const_pointer first, size_type count)
+    {
+        append(first, first + count);
+    }
+
     template<typename ValueType, unsigned short ChunkSize>
     inline typename StreamBuffer<ValueType, ChunkSize>::size_type StreamBuffer<ValueType, ChunkSize>::consume(size_type howMany)
     {
@@ -412,8 +497,10 @@ namespace libember { namespace util
         using std::swap;
         swap(m_head, other.m_head);
         swap(m_tail, other.m_tail);
+        swap(m_free, other.m_free);
         swap(m_size, other.m_size);
         swap(m_maxsize, other.m_maxsize);
+        swap(m_chunkCapacity, other.m_chunkCapacity);
     }
 
     template<typename ValueType, unsigned short ChunkSize>
@@ -454,6 +541,18 @@ namespace libember { namespace util
         return iterator();
     }
 
+    template<typename ValueType, unsigned short ChunkSize>
+    inline typename StreamBuffer<ValueType, ChunkSize>::segment_iterator StreamBuffer<ValueType, ChunkSize>::segment_begin() const
+    {
+        return segment_iterator(m_head);
+    }
+
+    template<typename ValueType, unsigned short ChunkSize>
+    inline typename StreamBuffer<ValueType, ChunkSize>::segment_iterator StreamBuffer<ValueType, ChunkSize>::segment_end() const
+    {
+        return segment_iterator();
+    }
+
     template<typename ValueType, unsigned short ChunkSize>
     inline void StreamBuffer<ValueType, ChunkSize>::flush(iterator, iterator)
     {
@@ -503,13 +602,32 @@ namespace libember { namespace util
     template<typename ValueType, unsigned short ChunkSize>
     inline void StreamBuffer<ValueType, ChunkSize>::deallocate(node_type* node)
     {
-        delete node;
+        node->next() = m_free;
+        m_free = node;
     }
 
     template<typename ValueType, unsigned short ChunkSize>
     inline typename StreamBuffer<ValueType, ChunkSize>::node_type* StreamBuffer<ValueType, ChunkSize>::allocate()
     {
-        return new node_type();
+        node_type* const node = m_free;
+        if (node != 0)
+        {
+            m_free = node->next();
+            node->reset();
+            return node;
+        }
+        return node_type::create(m_chunkCapacity);
+    }
+
+    template<typename ValueType, unsigned short ChunkSize>
+    inline void StreamBuffer<ValueType, ChunkSize>::destroy(node_type* node)
+    {
+        while (node != 0)
+        {
+            node_type* const current = node;
+            node = current->next();
+            node_type::destroy(current);
+        }
     }
 }
 }
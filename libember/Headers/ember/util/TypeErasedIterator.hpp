@@ -11,6 +11,7 @@
 
 #include <typeinfo>
 #include <iterator>
+#include <new>
 #include "../meta/RemoveCV.hpp"
 
 //SimianIgnore
@@ -47,6 +48,10 @@ namespace libember { namespace util
      * @note Please note that this is a rather minimal implementation relying a lot
      *      on the ability to obtain a pointer to the referred element from a wrapped
      *      iterator.
+     * @note Wrapped iterators of up to four pointers in size, which includes the
+     *      iterators of all dom containers, are stored within the instance itself,
+     *      so that constructing, copying and assigning the iterator does not
+     *      allocate memory. Larger iterators are stored on the heap.
      */
     template<typename ValueType>
     class TypeErasedIterator
@@ -92,7 +97,7 @@ namespace libember { namespace util
              * @param other the TypeErasedIterator instance whose state should
              *      be copied into this instance.
              */
-            TypeErasedIterator& operator=(TypeErasedIterator other);
+            TypeErasedIterator& operator=(TypeErasedIterator const& other);
 
             /**
              * Overloaded dereference operator. Returns a reference to the
@@ -162,7 +167,7 @@ namespace libember { namespace util
              */
             struct Payload
             {
-                virtual Payload* clone() const = 0;
+                virtual Payload* clone(void* storage) const = 0;
                 virtual void preIncrement() = 0;
                 virtual pointer getPointer() const = 0;
                 virtual std::type_info const& typeId() const = 0;
@@ -181,7 +186,16 @@ namespace libember { namespace util
                 public:
                     explicit PayloadImpl(IteratorType iterator);
 
-                    virtual Payload* clone() const;
+                    /**
+                     * Creates a payload wrapping the passed iterator. The payload is
+                     * constructed within @p storage if it fits, otherwise on the heap.
+                     * @param iterator The iterator to wrap.
+                     * @param storage The inline storage of the owning iterator.
+                     * @return A pointer to the created payload.
+                     */
+                    static Payload* create(IteratorType const& iterator, void* storage);
+
+                    virtual Payload* clone(void* storage) const;
                     virtual void preIncrement();
                     virtual pointer getPointer() const;
                     virtual std::type_info const& typeId() const;
@@ -193,8 +207,34 @@ namespace libember { namespace util
                     IteratorType m_iterator;
             };
 
+            /**
+             * Inline storage for small payloads, aligned for any wrapped iterator.
+             */
+            union Storage
+            {
+                void* pointer;
+                long double alignment;
+                unsigned char bytes[sizeof(void*) * 5];
+            };
+
+            /**
+             * Destroys the current payload and frees it, if it lives on the heap.
+             */
+            void destroy();
+
+            /**
+             * Moves a payload from one inline storage to another. Payloads that
+             * live on the heap are returned unchanged.
+             * @param payload The payload to move, may be null.
+             * @param source The storage the payload may currently live in.
+             * @param destination The storage to move an inline payload to.
+             * @return A pointer to the moved payload.
+             */
+            static Payload* relocate(Payload* payload, Storage& source, Storage& destination);
+
         private:
             Payload* m_payload;
+            Storage m_storage;
     };
 
     /**
@@ -219,25 +259,29 @@ namespace libember { namespace util
 
     template<typename ValueType>
     inline TypeErasedIterator<ValueType>::TypeErasedIterator(TypeErasedIterator const& other)
-        : m_payload((other.m_payload != 0) ? other.m_payload->clone() : 0)
+        : m_payload((other.m_payload != 0) ? other.m_payload->clone(&m_storage) : 0)
     {}
 
     template<typename ValueType>
     template<typename IteratorType>
     inline TypeErasedIterator<ValueType>::TypeErasedIterator(IteratorType iterator)
-        : m_payload(new PayloadImpl<IteratorType>(iterator))
+        : m_payload(PayloadImpl<IteratorType>::create(iterator, &m_storage))
     {}
 
     template<typename ValueType>
     inline TypeErasedIterator<ValueType>::~TypeErasedIterator()
     {
-        delete m_payload;
+        destroy();
     }
 
     template<typename ValueType>
-    inline TypeErasedIterator<ValueType>& TypeErasedIterator<ValueType>::operator=(TypeErasedIterator other)
+    inline TypeErasedIterator<ValueType>& TypeErasedIterator<ValueType>::operator=(TypeErasedIterator const& other)
     {
-        swap(other);
+        if (this != &other)
+        {
+            destroy();
+            m_payload = (other.m_payload != 0) ? other.m_payload->clone(&m_storage) : 0;
+        }
         return *this;
     }
 
@@ -277,8 +321,36 @@ namespace libember { namespace util
     template<typename ValueType>
     inline void TypeErasedIterator<ValueType>::swap(TypeErasedIterator& other)
     {
-        using std::swap;
-        swap(m_payload, other.m_payload);
+        Storage temporary;
+        Payload* const payload = relocate(m_payload, m_storage, temporary);
+        m_payload = relocate(other.m_payload, other.m_storage, m_storage);
+        other.m_payload = relocate(payload, temporary, other.m_storage);
+    }
+
+    template<typename ValueType>
+    inline void TypeErasedIterator<ValueType>::destroy()
+    {
+        if (static_cast<void*>(m_payload) == static_cast<void*>(&m_storage))
+        {
+            m_payload->~Payload();
+        }
+        else
+        {
+            delete m_payload;
+        }
+        m_payload = 0;
+    }
+
+    template<typename ValueType>
+    inline typename TypeErasedIterator<ValueType>::Payload* TypeErasedIterator<ValueType>::relocate(Payload* payload, Storage& source, Storage& destination)
+    {
+        if ((payload != 0) && (static_cast<void*>(payload) == static_cast<void*>(&source)))
+        {
+            Payload* const result = payload->clone(&destination);
+            payload->~Payload();
+            return result;
+        }
+        return payload;
     }
 
     template<typename ValueType>
@@ -300,9 +372,23 @@ namespace libember { namespace util
 
     template<typename ValueType>
     template<typename IteratorType>
-    inline typename TypeErasedIterator<ValueType>::Payload* TypeErasedIterator<ValueType>::PayloadImpl<IteratorType>::clone() const
+    inline typename TypeErasedIterator<ValueType>::Payload* TypeErasedIterator<ValueType>::PayloadImpl<IteratorType>::create(IteratorType const& iterator, void* storage)
+    {
+        if (sizeof(PayloadImpl) <= sizeof(Storage))
+        {
+            return new (storage) PayloadImpl(iterator);
+        }
+        else
+        {
+            return new PayloadImpl(iterator);
+        }
+    }
+
+    template<typename ValueType>
+    template<typename IteratorType>
+    inline typename TypeErasedIterator<ValueType>::Payload* TypeErasedIterator<ValueType>::PayloadImpl<IteratorType>::clone(void* storage) const
     {
-        return new PayloadImpl(*this);
+        return create(m_iterator, storage);
     }
 
     template<typename ValueType>
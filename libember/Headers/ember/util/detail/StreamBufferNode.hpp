@@ -10,6 +10,9 @@
 #define __LIBEMBER_UTIL_DETAIL_STREAMBUFFERNODE_HPP
 
 #include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <new>
 #include "../../meta/RemoveCV.hpp"
 #include "../../meta/TransferCV.hpp"
 
@@ -18,7 +21,11 @@ namespace libember { namespace util { namespace detail
 
     /**
      * A node type representing an element of a linked list of consecutive
-     * fixed size typed storage areas.
+     * typed storage areas. The size of the storage area is specified when
+     * the node is created, all nodes of a single StreamBuffer share the
+     * same capacity. The storage area directly follows the node within a
+     * single allocation, so nodes are created and destroyed with create()
+     * and destroy() instead of new and delete.
      */
     template<typename ValueType, unsigned short ChunkSize>
     class StreamBufferNode
@@ -32,22 +39,34 @@ namespace libember { namespace util { namespace detail
             typedef value_type const*   const_pointer;
 
             typedef std::size_t         size_type;
-            typedef unsigned short      cursor_type;
+            typedef std::size_t         cursor_type;
 
         public:
             /**
-             * Default constructor that initializes all internal pointers
-             * to null and leaves the internal storage area uninitialized.
-             */ 
-            StreamBufferNode();
+             * Creates an empty node along with its storage area in a single
+             * allocation.
+             * @param capacity The number of elements the node may store.
+             * @return A pointer to the new node.
+             * @throw std::bad_alloc if no memory is available.
+             */
+            static StreamBufferNode* create(size_type capacity);
 
             /**
-             * Copy constructor that initializes the instance as a shallow
-             * copy of @p other. In this context shallow means that only
-             * the nodes contents and cursors are copied and the next-pointer
-             * ins initialized with 0.
+             * Creates a shallow copy of @p other. In this context shallow means
+             * that only the nodes contents and cursors are copied and the
+             * next-pointer is initialized with 0.
+             * @param other The node to copy.
+             * @return A pointer to the new node.
+             * @throw std::bad_alloc if no memory is available.
              */
-            StreamBufferNode(StreamBufferNode const& other);
+            static StreamBufferNode* create(StreamBufferNode const& other);
+
+            /**
+             * Destroys a node that has been created with create() and frees
+             * its memory, including the storage area.
+             * @param node The node to destroy.
+             */
+            static void destroy(StreamBufferNode* node);
 
             /**
              * Return the maximum number of elements the node may store.
@@ -55,6 +74,13 @@ namespace libember { namespace util { namespace detail
              */
             size_type capacity() const;
 
+            /**
+             * Return the number of elements that may still be appended to
+             * this node.
+             * @return The number of elements that may still be appended.
+             */
+            size_type available() const;
+
             /**
              * Return the current number of elements stored in this node.
              * @return The current number of elements stored in this node.
@@ -140,6 +166,21 @@ namespace libember { namespace util { namespace detail
              */
             const_reference at(cursor_type pos) const;
 
+            /**
+             * Return a pointer to the first element of the range of valid
+             * elements within this node. The range is contiguous and contains
+             * size() elements.
+             * @return A pointer to the first valid element.
+             */
+            pointer data();
+
+            /**
+             * Return a const-qualified pointer to the first element of the range
+             * of valid elements within this node.
+             * @return A const-qualified pointer to the first valid element.
+             */
+            const_pointer data() const;
+
             /**
              * Append a single element to the range of valid elements within
              * this node.
@@ -172,7 +213,52 @@ namespace libember { namespace util { namespace detail
              */
             size_type consume(size_type howMany);
 
+            /**
+             * Discards the contents of this node and resets the next pointer,
+             * so the node can be reused.
+             */
+            void reset();
+
         private:
+            /**
+             * Appends a sequence of elements one by one.
+             * @see append(InputIterator, InputIterator)
+             */
+            template<typename InputIterator>
+            InputIterator append(InputIterator first, InputIterator last, std::input_iterator_tag);
+
+            /**
+             * Appends as many elements of a random access sequence as fit into
+             * this node with a single copy.
+             * @see append(InputIterator, InputIterator)
+             */
+            template<typename RandomAccessIterator>
+            RandomAccessIterator append(RandomAccessIterator first, RandomAccessIterator last, std::random_access_iterator_tag);
+
+            /**
+             * Constructor that initializes all cursors to null and leaves the
+             * storage area uninitialized.
+             * @param capacity The number of elements the node may store.
+             * @param data The storage area, which follows the node in memory.
+             */
+            StreamBufferNode(size_type capacity, pointer data);
+
+            /** Destructor. */
+            ~StreamBufferNode();
+
+            /**
+             * Returns the offset of the storage area from the start of a node,
+             * which is a multiple of the element size and thus properly aligned.
+             * @return The offset of the storage area in bytes.
+             */
+            static size_type dataOffset();
+
+            /**
+             * Private unimplemented copy constructor, nodes are copied with
+             * create().
+             */
+            StreamBufferNode(StreamBufferNode const&);
+
             /**
              * Private unimplemented assignment operator to disallow
              * assignments from one node to another.
@@ -183,13 +269,8 @@ namespace libember { namespace util { namespace detail
             StreamBufferNode* m_next;
             cursor_type m_first;
             cursor_type m_last;
-
-            enum
-            {
-                CAPACITY = (ChunkSize - sizeof(StreamBufferNode*) - sizeof(cursor_type) - sizeof(cursor_type)) / sizeof(value_type)
-            };
-
-            value_type m_data[CAPACITY];
+            cursor_type const m_capacity;
+            pointer const m_data;
     };
 
 
@@ -199,28 +280,60 @@ namespace libember { namespace util { namespace detail
    /**************************************************************************/
 
     template<typename ValueType, unsigned short ChunkSize>
-    inline StreamBufferNode<ValueType, ChunkSize>::StreamBufferNode()
-        : m_next(0), m_first(0), m_last(0)
+    inline StreamBufferNode<ValueType, ChunkSize>* StreamBufferNode<ValueType, ChunkSize>::create(size_type capacity)
+    {
+        unsigned char* const memory = static_cast<unsigned char*>(::operator new(dataOffset() + capacity * sizeof(value_type)));
+        return new (memory) StreamBufferNode(capacity, reinterpret_cast<pointer>(memory + dataOffset()));
+    }
+
+    template<typename ValueType, unsigned short ChunkSize>
+    inline StreamBufferNode<ValueType, ChunkSize>* StreamBufferNode<ValueType, ChunkSize>::create(StreamBufferNode const& other)
+    {
+        StreamBufferNode* const node = create(other.m_capacity);
+        std::copy(other.m_data + other.m_first, other.m_data + other.m_last, node->m_data + other.m_first);
+        node->m_first = other.m_first;
+        node->m_last = other.m_last;
+        return node;
+    }
+
+    template<typename ValueType, unsigned short ChunkSize>
+    inline void StreamBufferNode<ValueType, ChunkSize>::destroy(StreamBufferNode* node)
+    {
+        node->~StreamBufferNode();
+        ::operator delete(node);
+    }
+
+    template<typename ValueType, unsigned short ChunkSize>
+    inline StreamBufferNode<ValueType, ChunkSize>::StreamBufferNode(size_type capacity, pointer data)
+        : m_next(0), m_first(0), m_last(0), m_capacity(capacity), m_data(data)
+    {}
+
+    template<typename ValueType, unsigned short ChunkSize>
+    inline StreamBufferNode<ValueType, ChunkSize>::~StreamBufferNode()
     {}
+
     template<typename ValueType, unsigned short ChunkSize>
-    inline StreamBufferNode<ValueType, ChunkSize>::StreamBufferNode(StreamBufferNode const& other)
-        : m_next(0), m_first(other.m_first), m_last(other.m_last)
+    inline typename StreamBufferNode<ValueType, ChunkSize>::size_type StreamBufferNode<ValueType, ChunkSize>::dataOffset()
     {
-        std::copy(other.m_data, other.m_data + other.m_last, m_data);
+        return ((sizeof(StreamBufferNode) + sizeof(value_type) - 1) / sizeof(value_type)) * sizeof(value_type);
     }
 
     template<typename ValueType, unsigned short ChunkSize>
     inline typename StreamBufferNode<ValueType, ChunkSize>::size_type StreamBufferNode<ValueType, ChunkSize>::capacity() const
     {
-        using std::max;
-        return max(0, CAPACITY - m_last);
+        return m_capacity;
+    }
+
+    template<typename ValueType, unsigned short ChunkSize>
+    inline typename StreamBufferNode<ValueType, ChunkSize>::size_type StreamBufferNode<ValueType, ChunkSize>::available() const
+    {
+        return m_capacity - m_last;
     }
 
     template<typename ValueType, unsigned short ChunkSize>
     inline typename StreamBufferNode<ValueType, ChunkSize>::size_type StreamBufferNode<ValueType, ChunkSize>::size() const
     {
-        using std::max;
-        return static_cast<size_type>(max(0, m_last - m_first));
+        return m_last - m_first;
     }
 
     template<typename ValueType, unsigned short ChunkSize>
@@ -277,10 +390,22 @@ namespace libember { namespace util { namespace detail
         return m_data[pos];
     }
 
+    template<typename ValueType, unsigned short ChunkSize>
+    inline typename StreamBufferNode<ValueType, ChunkSize>::pointer StreamBufferNode<ValueType, ChunkSize>::data()
+    {
+        return m_data + m_first;
+    }
+
+    template<typename ValueType, unsigned short ChunkSize>
+    inline typename StreamBufferNode<ValueType, ChunkSize>::const_pointer StreamBufferNode<ValueType, ChunkSize>::data() const
+    {
+        return m_data + m_first;
+    }
+
     template<typename ValueType, unsigned short ChunkSize>
     inline bool StreamBufferNode<ValueType, ChunkSize>::append(value_type value)
     {
-        bool const spaceAvailable = (m_last < CAPACITY);
+        bool const spaceAvailable = (m_last < m_capacity);
         if (spaceAvailable)
             m_data[m_last++] = value;
         return spaceAvailable;
@@ -290,7 +415,15 @@ namespace libember { namespace util { namespace detail
     template<typename InputIterator>
     inline InputIterator StreamBufferNode<ValueType, ChunkSize>::append(InputIterator first, InputIterator last)
     {
-        while ((first != last) && (m_last < CAPACITY))
+        typedef typename std::iterator_traits<InputIterator>::iterator_category iterator_category;
+        return append(first, last, iterator_category());
+    }
+
+    template<typename ValueType, unsigned short ChunkSize>
+    template<typename InputIterator>
+    inline InputIterator StreamBufferNode<ValueType, ChunkSize>::append(InputIterator first, InputIterator last, std::input_iterator_tag)
+    {
+        while ((first != last) && (m_last < m_capacity))
         {
             m_data[m_last] = *first;
             ++first;
@@ -300,13 +433,33 @@ namespace libember { namespace util { namespace detail
     }
 
     template<typename ValueType, unsigned short ChunkSize>
-    typename StreamBufferNode<ValueType, ChunkSize>::size_type StreamBufferNode<ValueType, ChunkSize>::consume(size_type howMany)
+    template<typename RandomAccessIterator>
+    inline RandomAccessIterator StreamBufferNode<ValueType, ChunkSize>::append(RandomAccessIterator first, RandomAccessIterator last, std::random_access_iterator_tag)
+    {
+        using std::min;
+        size_type const count = min(static_cast<size_type>(last - first), available());
+        RandomAccessIterator const end = first + count;
+        std::copy(first, end, m_data + m_last);
+        m_last += count;
+        return end;
+    }
+
+    template<typename ValueType, unsigned short ChunkSize>
+    inline typename StreamBufferNode<ValueType, ChunkSize>::size_type StreamBufferNode<ValueType, ChunkSize>::consume(size_type howMany)
     {
         using std::min;
         cursor_type const toConsume = static_cast<cursor_type>(min(size(), howMany));
         m_first += toConsume;
         return toConsume;
     }
+
+    template<typename ValueType, unsigned short ChunkSize>
+    inline void StreamBufferNode<ValueType, ChunkSize>::reset()
+    {
+        m_next = 0;
+        m_first = 0;
+        m_last = 0;
+    }
 }
 }
 }
@@ -0,0 +1,192 @@
+/*
+    libember -- C++ 03 implementation of the Ember+ Protocol
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __LIBEMBER_UTIL_DETAIL_STREAMBUFFERSEGMENTITERATOR_HPP
+#define __LIBEMBER_UTIL_DETAIL_STREAMBUFFERSEGMENTITERATOR_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include "StreamBufferNode.hpp"
+
+//SimianIgnore
+
+namespace libember { namespace util
+{
+    /** Forward declaration. */
+    template<typename ValueType, unsigned short ChunkSize>
+    class StreamBuffer;
+}
+}
+
+namespace libember { namespace util { namespace detail
+{
+    /**
+     * Forward iterator over the chunks of a StreamBuffer. Each element is a
+     * pair of a pointer to the first element stored in a chunk and the number
+     * of contiguous elements that follow, which allows the contents of the
+     * buffer to be processed in blocks instead of element by element.
+     */
+    template<typename ValueType, unsigned short ChunkSize>
+    class StreamBufferSegmentIterator
+    {
+        public:
+            typedef std::forward_iterator_tag                           iterator_category;
+            typedef std::pair<ValueType const*, std::size_t>            value_type;
+            typedef value_type const&                                   reference;
+            typedef value_type const*                                   pointer;
+            typedef std::ptrdiff_t                                      difference_type;
+
+            typedef StreamBufferNode<ValueType, ChunkSize> const        node_type;
+
+        public:
+            /**
+             * Default constructor. Initializes the instance in a singular state,
+             * which equals the end of any segment sequence.
+             */
+            StreamBufferSegmentIterator();
+
+            /**
+             * Pre increment operator, advances the iterator to the next chunk.
+             * @return A reference to this instance.
+             */
+            StreamBufferSegmentIterator& operator++();
+
+            /**
+             * Post-increment operator. Returns a copy of the current state and
+             * advances to the next chunk.
+             * @return Returns an iterator referring to the current chunk.
+             */
+            StreamBufferSegmentIterator operator++(int);
+
+            /**
+             * Dereference operator.
+             * @return The pointer and length of the current chunk.
+             */
+            reference operator*() const;
+
+            /**
+             * Member access operator.
+             * @return A pointer to the pointer and length of the current chunk.
+             */
+            pointer operator->() const;
+
+            /**
+             * Equality comparison operator.
+             * @param other The iterator to compare with.
+             * @return True if both iterators refer to the same chunk.
+             */
+            bool operator==(StreamBufferSegmentIterator const& other) const;
+
+            /**
+             * Inequality comparison operator.
+             * @param other The iterator to compare with.
+             * @return True if the iterators refer to different chunks.
+             */
+            bool operator!=(StreamBufferSegmentIterator const& other) const;
+
+        private:
+            friend class StreamBuffer<ValueType, ChunkSize>;
+
+            /**
+             * Constructor, creates an iterator referring to the passed node.
+             * @param node The node to start from, may be null.
+             */
+            explicit StreamBufferSegmentIterator(node_type* node);
+
+            /**
+             * Updates the cached segment after the node has changed.
+             */
+            void update();
+
+        private:
+            node_type* m_node;
+            value_type m_segment;
+    };
+
+
+    /**************************************************************************/
+    /* Mandatory inline implementation                                         */
+    /**************************************************************************/
+
+    template<typename ValueType, unsigned short ChunkSize>
+    inline StreamBufferSegmentIterator<ValueType, ChunkSize>::StreamBufferSegmentIterator()
+        : m_node(0), m_segment(static_cast<ValueType const*>(0), 0)
+    {}
+
+    template<typename ValueType, unsigned short ChunkSize>
+    inline StreamBufferSegmentIterator<ValueType, ChunkSize>::StreamBufferSegmentIterator(node_type* node)
+        : m_node(node), m_segment(static_cast<ValueType const*>(0), 0)
+    {
+        update();
+    }
+
+    template<typename ValueType, unsigned short ChunkSize>
+    inline StreamBufferSegmentIterator<ValueType, ChunkSize>& StreamBufferSegmentIterator<ValueType, ChunkSize>::operator++()
+    {
+        if (m_node != 0)
+        {
+            m_node = m_node->next();
+            update();
+        }
+        return *this;
+    }
+
+    template<typename ValueType, unsigned short ChunkSize>
+    inline StreamBufferSegmentIterator<ValueType, ChunkSize> StreamBufferSegmentIterator<ValueType, ChunkSize>::operator++(int)
+    {
+        StreamBufferSegmentIterator const current(*this);
+        ++(*this);
+        return current;
+    }
+
+    template<typename ValueType, unsigned short ChunkSize>
+    inline typename StreamBufferSegmentIterator<ValueType, ChunkSize>::reference StreamBufferSegmentIterator<ValueType, ChunkSize>::operator*() const
+    {
+        return m_segment;
+    }
+
+    template<typename ValueType, unsigned short ChunkSize>
+    inline typename StreamBufferSegmentIterator<ValueType, ChunkSize>::pointer StreamBufferSegmentIterator<ValueType, ChunkSize>::operator->() const
+    {
+        return &m_segment;
+    }
+
+    template<typename ValueType, unsigned short ChunkSize>
+    inline bool StreamBufferSegmentIterator<ValueType, ChunkSize>::operator==(StreamBufferSegmentIterator const& other) const
+    {
+        return m_node == other.m_node;
+    }
+
+    template<typename ValueType, unsigned short ChunkSize>
+    inline bool StreamBufferSegmentIterator<ValueType, ChunkSize>::operator!=(StreamBufferSegmentIterator const& other) const
+    {
+        return m_node != other.m_node;
+    }
+
+    template<typename ValueType, unsigned short ChunkSize>
+    inline void StreamBufferSegmentIterator<ValueType, ChunkSize>::update()
+    {
+        if (m_node != 0)
+        {
+            m_segment.first = m_node->data();
+            m_segment.second = m_node->size();
+        }
+        else
+        {
+            m_segment.first = 0;
+            m_segment.second = 0;
+        }
+    }
+}
+}
+}
+
+//EndSimianIgnore
+
+#endif  // __LIBEMBER_UTIL_DETAIL_STREAMBUFFERSEGMENTITERATOR_HPP
@@ -0,0 +1,61 @@
+/*
+    libember -- C++ 03 implementation of the Ember+ Protocol
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __LIBEMBER_TESTS_BENCHMARK_BENCHMARK_HPP
+#define __LIBEMBER_TESTS_BENCHMARK_BENCHMARK_HPP
+
+#include <cstddef>
+#include <ctime>
+#include <iostream>
+#include <string>
+
+namespace benchmark
+{
+    /**
+     * Prevents the compiler from discarding a computed value.
+     */
+    template<typename ValueType>
+    inline void keep(ValueType const& value)
+    {
+        static ValueType volatile sink;
+        sink = value;
+        static_cast<void>(sink);
+    }
+
+    /**
+     * Runs @p function repeatedly until at least @p minimumSeconds of processor
+     * time have passed and prints the result as a single JSON object per line:
+     * {"benchmark":"<name>","items":<n>,"repetitions":<r>,"ns_per_item":<t>}
+     * @param name The name of the measurement.
+     * @param items The number of items processed by a single call of @p function.
+     * @param function The function to measure.
+     * @param minimumSeconds The minimum processor time to spend.
+     */
+    template<typename FunctionType>
+    inline void run(std::string const& name, std::size_t items, FunctionType function, double minimumSeconds = 0.2)
+    {
+        function();
+
+        std::size_t repetitions = 0;
+        std::clock_t const start = std::clock();
+        double elapsed = 0.0;
+        do
+        {
+            function();
+            ++repetitions;
+            elapsed = static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC;
+        }
+        while (elapsed < minimumSeconds);
+
+        double const nanoseconds = elapsed * 1e9 / (static_cast<double>(repetitions) * static_cast<double>(items));
+        std::cout << "{\"benchmark\":\"" << name << "\",\"items\":" << items
+                  << ",\"repetitions\":" << repetitions << ",\"ns_per_item\":" << nanoseconds << "}" << std::endl;
+    }
+}
+
+#endif  // __LIBEMBER_TESTS_BENCHMARK_BENCHMARK_HPP
@@ -0,0 +1,118 @@
+/*
+    libember -- C++ 03 implementation of the Ember+ Protocol
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include <string>
+#include <vector>
+#include "ember/Ember.hpp"
+#include "Benchmark.hpp"
+
+namespace
+{
+    std::size_t const ValueCount = 1000;
+
+    /** Encodes the values as complete frames, i.e. with universal tag and length. */
+    template<typename ValueType>
+    struct Encode
+    {
+        explicit Encode(std::vector<ValueType> const& values)
+            : values(values)
+        {}
+
+        void operator()() const
+        {
+            libember::util::OctetStream output;
+            typename std::vector<ValueType>::const_iterator const last = values.end();
+            for (typename std::vector<ValueType>::const_iterator it = values.begin(); it != last; ++it)
+            {
+                libember::ber::encodeFrame(output, *it);
+            }
+            benchmark::keep(output.size());
+        }
+
+        std::vector<ValueType> const& values;
+    };
+
+    /** Decodes frames produced by Encode. */
+    template<typename ValueType>
+    struct Decode
+    {
+        explicit Decode(std::vector<ValueType> const& values)
+        {
+            libember::util::OctetStream output;
+            typename std::vector<ValueType>::const_iterator const last = values.end();
+            for (typename std::vector<ValueType>::const_iterator it = values.begin(); it != last; ++it)
+            {
+                libember::ber::encodeFrame(output, *it);
+            }
+            encoded.assign(output.begin(), output.end());
+        }
+
+        void operator()() const
+        {
+            libember::util::OctetStream input;
+            input.append(&encoded[0], encoded.size());
+
+            std::size_t count = 0;
+            while (!input.empty())
+            {
+                libember::ber::decode<libember::ber::Tag>(input);
+                std::size_t const length = libember::ber::decode<libember::ber::Length<std::size_t> >(input).value;
+                libember::ber::decode<ValueType>(input, length);
+                ++count;
+            }
+            benchmark::keep(count);
+        }
+
+        std::vector<unsigned char> encoded;
+    };
+
+    template<typename ValueType>
+    void measure(std::string const& name, std::vector<ValueType> const& values)
+    {
+        benchmark::run("ber_encode_" + name, values.size(), Encode<ValueType>(values));
+        benchmark::run("ber_decode_" + name, values.size(), Decode<ValueType>(values));
+    }
+}
+
+int main()
+{
+    std::vector<bool> booleans;
+    std::vector<int> integers;
+    std::vector<long> longs;
+    std::vector<double> reals;
+    std::vector<std::string> strings;
+    std::vector<libember::ber::ObjectIdentifier> paths;
+    std::vector<libember::ber::Octets> octets;
+
+    for (std::size_t i = 0; i < ValueCount; ++i)
+    {
+        booleans.push_back((i % 2) == 0);
+        integers.push_back(static_cast<int>(i * 7919) - 3000000);
+        longs.push_back(static_cast<long>(i) * 104729L - 50000000L);
+        reals.push_back(static_cast<double>(i) * 0.37 - 100.0);
+        strings.push_back(std::string(8 + i % 24, static_cast<char>('a' + i % 26)));
+
+        libember::ber::ObjectIdentifier path;
+        path.push_back(1);
+        path.push_back(static_cast<libember::ber::ObjectIdentifier::value_type>(i % 200));
+        path.push_back(static_cast<libember::ber::ObjectIdentifier::value_type>(i));
+        paths.push_back(path);
+
+        unsigned char const bytes[] = { 0x01, 0x7F, 0x80, 0xFF, 0x00, static_cast<unsigned char>(i) };
+        octets.push_back(libember::ber::Octets(bytes, bytes + sizeof(bytes)));
+    }
+
+    measure("boolean", booleans);
+    measure("integer", integers);
+    measure("long", longs);
+    measure("real", reals);
+    measure("string", strings);
+    measure("relative_oid", paths);
+    measure("octets", octets);
+    return 0;
+}
@@ -0,0 +1,98 @@
+/*
+    libember -- C++ 03 implementation of the Ember+ Protocol
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "ember/Ember.hpp"
+#include "Benchmark.hpp"
+
+namespace
+{
+    std::size_t const ChildCount = 10000;
+
+    libember::dom::Sequence* createCollection()
+    {
+        libember::dom::Sequence* const sequence = new libember::dom::Sequence(libember::ber::make_tag(libember::ber::Class::Application, 1));
+        for (std::size_t i = 0; i < ChildCount; ++i)
+        {
+            libember::ber::Tag const tag = libember::ber::make_tag(libember::ber::Class::ContextSpecific, static_cast<libember::ber::Tag::Number>(i));
+            sequence->insert(sequence->end(), new libember::dom::VariantLeaf(tag, static_cast<int>(i)));
+        }
+        return sequence;
+    }
+
+    /** Walks all children and sums up their tag numbers. */
+    struct Iterate
+    {
+        explicit Iterate(libember::dom::Container const& container)
+            : container(container)
+        {}
+
+        void operator()() const
+        {
+            libember::ber::Tag::Number sum = 0;
+            libember::dom::Container::const_iterator const last = container.end();
+            for (libember::dom::Container::const_iterator it = container.begin(); it != last; ++it)
+            {
+                sum += it->applicationTag().number();
+            }
+            benchmark::keep(sum);
+        }
+
+        libember::dom::Container const& container;
+    };
+
+    /** Looks up the tag of the last child, which visits every child. */
+    struct FindTag
+    {
+        explicit FindTag(libember::dom::Container const& container)
+            : container(container)
+            , tag(libember::ber::make_tag(libember::ber::Class::ContextSpecific, static_cast<libember::ber::Tag::Number>(ChildCount - 1)))
+        {}
+
+        void operator()() const
+        {
+            libember::dom::Container::const_iterator const result = libember::glow::util::find_tag(container.begin(), container.end(), tag);
+            benchmark::keep(&*result);
+        }
+
+        libember::dom::Container const& container;
+        libember::ber::Tag const tag;
+    };
+
+    /** Creates and copies an iterator per child, as algorithms passing iterators by value do. */
+    struct CopyIterators
+    {
+        explicit CopyIterators(libember::dom::Container const& container)
+            : container(container)
+        {}
+
+        void operator()() const
+        {
+            libember::dom::Container::const_iterator it = container.begin();
+            for (std::size_t i = 0; i < ChildCount; ++i)
+            {
+                libember::dom::Container::const_iterator const copy = it;
+                it = copy;
+            }
+            benchmark::keep(&*it);
+        }
+
+        libember::dom::Container const& container;
+    };
+}
+
+int main(int, char const* const*)
+{
+    libember::dom::Sequence* const collection = createCollection();
+
+    benchmark::run("container/iterate", ChildCount, Iterate(*collection));
+    benchmark::run("container/find_tag", ChildCount, FindTag(*collection));
+    benchmark::run("container/copy_iterator", ChildCount, CopyIterators(*collection));
+
+    delete collection;
+    return 0;
+}
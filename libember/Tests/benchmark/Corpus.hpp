@@ -0,0 +1,110 @@
+/*
+    libember -- C++ 03 implementation of the Ember+ Protocol
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __LIBEMBER_TESTS_BENCHMARK_CORPUS_HPP
+#define __LIBEMBER_TESTS_BENCHMARK_CORPUS_HPP
+
+#include <sstream>
+#include <string>
+#include <vector>
+#include "ember/Ember.hpp"
+
+/**
+ * Glow messages resembling the traffic between a provider and its consumers.
+ * Each message is created as a tree and encoded, so the corpus does not depend
+ * on recorded files.
+ */
+namespace corpus
+{
+    typedef std::vector<unsigned char> Bytes;
+
+    /** Number of parameters within the GetDirectory response. */
+    std::size_t const DirectorySize = 1000;
+
+    /** Number of entries within the stream collection. */
+    std::size_t const StreamCount = 200;
+
+    inline Bytes encode(libember::dom::Node const& node)
+    {
+        libember::util::OctetStream stream;
+        node.encode(stream);
+        return Bytes(stream.begin(), stream.end());
+    }
+
+    inline libember::ber::ObjectIdentifier makePath(int node, int parameter)
+    {
+        libember::ber::ObjectIdentifier path;
+        path.push_back(1);
+        path.push_back(node);
+        path.push_back(parameter);
+        return path;
+    }
+
+    /**
+     * Creates a notification about the value change of a single parameter.
+     */
+    inline libember::glow::GlowRootElementCollection* createNotification()
+    {
+        libember::glow::GlowRootElementCollection* const root = libember::glow::GlowRootElementCollection::create();
+        libember::glow::GlowQualifiedParameter* const parameter = new libember::glow::GlowQualifiedParameter(root, makePath(2, 17));
+        parameter->setValue(-12L);
+        return root;
+    }
+
+    /**
+     * Creates the response to a GetDirectory request for a node with many
+     * parameters, each of which reports its complete contents. The parameters
+     * are qualified, which is the form the schema-driven codec supports.
+     */
+    inline libember::glow::GlowRootElementCollection* createDirectory()
+    {
+        libember::glow::GlowRootElementCollection* const root = libember::glow::GlowRootElementCollection::create();
+        for (std::size_t i = 0; i < DirectorySize; ++i)
+        {
+            std::ostringstream identifier;
+            identifier << "fader" << i;
+
+            libember::glow::GlowQualifiedParameter* const parameter = new libember::glow::GlowQualifiedParameter(root, makePath(2, static_cast<int>(i + 1)));
+            parameter->setIdentifier(identifier.str());
+            parameter->setDescription("Channel fader level");
+            parameter->setValue(static_cast<long>(i) - 500L);
+            parameter->setMinimum(-4096L);
+            parameter->setMaximum(4096L);
+            parameter->setFactor(32);
+            parameter->setFormat("%8.2f dB");
+            parameter->setAccess(libember::glow::Access::ReadWrite);
+            parameter->setStreamIdentifier(static_cast<int>(i));
+        }
+        return root;
+    }
+
+    /**
+     * Creates a stream collection with integer levels.
+     */
+    inline libember::glow::GlowStreamCollection* createStreams()
+    {
+        libember::glow::GlowStreamCollection* const streams = libember::glow::GlowStreamCollection::create();
+        for (std::size_t i = 0; i < StreamCount; ++i)
+        {
+            streams->insert(static_cast<int>(i), static_cast<int>(i * 37) - 4000);
+        }
+        return streams;
+    }
+
+    /**
+     * Returns the encoded form of a tree and deletes the tree.
+     */
+    inline Bytes encodeAndDelete(libember::dom::Node* node)
+    {
+        Bytes const result = encode(*node);
+        delete node;
+        return result;
+    }
+}
+
+#endif  // __LIBEMBER_TESTS_BENCHMARK_CORPUS_HPP
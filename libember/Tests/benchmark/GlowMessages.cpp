@@ -0,0 +1,219 @@
+/*
+    libember -- C++ 03 implementation of the Ember+ Protocol
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include <string>
+#include "ember/Ember.hpp"
+#include "Benchmark.hpp"
+#include "Corpus.hpp"
+
+namespace
+{
+    /** Size of the blocks passed to the asynchronous reader, like a network packet. */
+    std::size_t const BlockSize = 1024;
+
+    /** Decodes a message with the asynchronous dom reader, block by block. */
+    struct AsyncDecode
+    {
+        explicit AsyncDecode(corpus::Bytes const& message)
+            : message(message)
+        {}
+
+        void operator()() const
+        {
+            libember::dom::AsyncDomReader reader(libember::glow::GlowNodeFactory::getFactory());
+            unsigned char const* const first = &message[0];
+            for (std::size_t offset = 0; offset < message.size(); offset += BlockSize)
+            {
+                std::size_t const length = std::min(BlockSize, message.size() - offset);
+                reader.read(first + offset, first + offset + length);
+            }
+
+            libember::dom::Node* const root = reader.detachRoot();
+            benchmark::keep(root);
+            delete root;
+        }
+
+        corpus::Bytes const& message;
+    };
+
+    /** Decodes a message with the asynchronous dom reader into a reused arena. */
+    struct AsyncDecodeArena
+    {
+        explicit AsyncDecodeArena(corpus::Bytes const& message)
+            : message(message)
+        {}
+
+        void operator()() const
+        {
+            libember::dom::AsyncDomReader reader(libember::glow::GlowNodeFactory::getFactory());
+            reader.setArena(&arena);
+            reader.read(&message[0], &message[0] + message.size());
+
+            libember::dom::Node* const root = reader.detachRoot();
+            benchmark::keep(root);
+            arena.release();
+        }
+
+        corpus::Bytes const& message;
+        mutable libember::util::MonotonicArena arena;
+    };
+
+    /** Decodes a message with the synchronous dom reader. */
+    struct SyncDecode
+    {
+        explicit SyncDecode(corpus::Bytes const& message)
+            : message(message)
+        {}
+
+        void operator()() const
+        {
+            libember::util::OctetStream input;
+            input.append(&message[0], message.size());
+
+            libember::dom::DomReader reader;
+            libember::dom::Node* const root = reader.decodeTree(input, libember::glow::GlowNodeFactory::getFactory());
+            benchmark::keep(root);
+            delete root;
+        }
+
+        corpus::Bytes const& message;
+    };
+
+    /** Counts the records passed by the schema-driven codec. */
+    struct RecordCounter : libember::glow::codec::MessageHandler
+    {
+        RecordCounter()
+            : count(0)
+        {}
+
+        void qualifiedParameter(libember::glow::codec::QualifiedParameter const&)
+        {
+            ++count;
+        }
+
+        void streamEntry(libember::glow::codec::StreamEntry const&)
+        {
+            ++count;
+        }
+
+        std::size_t count;
+    };
+
+    /** Decodes a message with the schema-driven codec. */
+    struct CodecDecode
+    {
+        explicit CodecDecode(corpus::Bytes const& message)
+            : message(message)
+        {}
+
+        void operator()() const
+        {
+            libember::util::OctetStream input;
+            input.append(&message[0], message.size());
+
+            RecordCounter counter;
+            libember::glow::codec::decodeMessage(input, counter);
+            benchmark::keep(counter.count);
+        }
+
+        corpus::Bytes const& message;
+    };
+
+    /** Creates a tree and encodes it with Node::encode, as providers do for each response. */
+    template<typename NodeType>
+    struct BuildAndEncode
+    {
+        typedef NodeType* (*Factory)();
+
+        explicit BuildAndEncode(Factory factory)
+            : factory(factory)
+        {}
+
+        void operator()() const
+        {
+            NodeType* const root = factory();
+            libember::util::OctetStream output;
+            root->encode(output);
+            benchmark::keep(output.size());
+            delete root;
+        }
+
+        Factory factory;
+    };
+
+    /** Creates a tree and encodes it with the two-pass tree encoder into a single chunk. */
+    template<typename NodeType>
+    struct BuildAndEncodeTwoPass
+    {
+        typedef NodeType* (*Factory)();
+
+        explicit BuildAndEncodeTwoPass(Factory factory)
+            : factory(factory)
+        {}
+
+        void operator()() const
+        {
+            NodeType* const root = factory();
+            libember::dom::TreeEncoder encoder;
+            std::size_t const length = encoder.measure(*root);
+            libember::util::OctetStream output(0, length);
+            encoder.encode(output);
+            benchmark::keep(output.size());
+            delete root;
+        }
+
+        Factory factory;
+    };
+
+    /** Encodes an unchanged tree again, which uses the cached lengths. */
+    struct Reencode
+    {
+        explicit Reencode(libember::dom::Node const& root)
+            : root(root)
+        {}
+
+        void operator()() const
+        {
+            libember::util::OctetStream output;
+            root.encode(output);
+            benchmark::keep(output.size());
+        }
+
+        libember::dom::Node const& root;
+    };
+
+    void measureDecoding(std::string const& name, corpus::Bytes const& message, std::size_t items)
+    {
+        benchmark::run("async_dom_reader_" + name, items, AsyncDecode(message));
+        benchmark::run("async_dom_reader_arena_" + name, items, AsyncDecodeArena(message));
+        benchmark::run("dom_reader_" + name, items, SyncDecode(message));
+        benchmark::run("codec_decode_" + name, items, CodecDecode(message));
+    }
+}
+
+int main()
+{
+    corpus::Bytes const notification = corpus::encodeAndDelete(corpus::createNotification());
+    corpus::Bytes const directory = corpus::encodeAndDelete(corpus::createDirectory());
+    corpus::Bytes const streams = corpus::encodeAndDelete(corpus::createStreams());
+
+    measureDecoding("notification", notification, 1);
+    measureDecoding("directory", directory, corpus::DirectorySize);
+    measureDecoding("streams", streams, corpus::StreamCount);
+
+    typedef libember::glow::GlowRootElementCollection Root;
+    benchmark::run("node_encode_notification", 1, BuildAndEncode<Root>(&corpus::createNotification));
+    benchmark::run("node_encode_directory", corpus::DirectorySize, BuildAndEncode<Root>(&corpus::createDirectory));
+    benchmark::run("node_encode_streams", corpus::StreamCount, BuildAndEncode<libember::glow::GlowStreamCollection>(&corpus::createStreams));
+    benchmark::run("tree_encoder_directory", corpus::DirectorySize, BuildAndEncodeTwoPass<Root>(&corpus::createDirectory));
+
+    Root* const root = corpus::createDirectory();
+    benchmark::run("node_reencode_directory", corpus::DirectorySize, Reencode(*root));
+    delete root;
+    return 0;
+}
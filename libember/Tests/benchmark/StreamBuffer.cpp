@@ -0,0 +1,138 @@
+/*
+    libember -- C++ 03 implementation of the Ember+ Protocol
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include <vector>
+#include "ember/Ember.hpp"
+#include "Benchmark.hpp"
+
+namespace
+{
+    std::size_t const ByteCount = 64 * 1024;
+    std::size_t const BlockSize = 1500;
+
+    typedef std::vector<unsigned char> Bytes;
+
+    /** Appends single bytes to a buffer which is reused between repetitions. */
+    struct AppendBytes
+    {
+        void operator()() const
+        {
+            buffer.clear();
+            for (std::size_t i = 0; i < ByteCount; ++i)
+            {
+                buffer.append(static_cast<unsigned char>(i));
+            }
+            benchmark::keep(buffer.size());
+        }
+
+        mutable libember::util::OctetStream buffer;
+    };
+
+    /** Appends blocks of the size of a network packet. */
+    struct AppendBlocks
+    {
+        explicit AppendBlocks(Bytes const& bytes)
+            : bytes(bytes)
+        {}
+
+        void operator()() const
+        {
+            buffer.clear();
+            for (std::size_t offset = 0; offset < bytes.size(); offset += BlockSize)
+            {
+                std::size_t const length = std::min(BlockSize, bytes.size() - offset);
+                buffer.append(&bytes[offset], length);
+            }
+            benchmark::keep(buffer.size());
+        }
+
+        Bytes const& bytes;
+        mutable libember::util::OctetStream buffer;
+    };
+
+    /** Fills the buffer and consumes it again byte by byte, as the decoders do. */
+    struct ConsumeBytes
+    {
+        explicit ConsumeBytes(Bytes const& bytes)
+            : bytes(bytes)
+        {}
+
+        void operator()() const
+        {
+            buffer.append(&bytes[0], bytes.size());
+            unsigned int sum = 0;
+            while (!buffer.empty())
+            {
+                sum += buffer.front();
+                buffer.consume();
+            }
+            benchmark::keep(sum);
+        }
+
+        Bytes const& bytes;
+        mutable libember::util::OctetStream buffer;
+    };
+
+    /** Iterates over the contents as contiguous segments, as writers do. */
+    struct IterateSegments
+    {
+        explicit IterateSegments(Bytes const& bytes)
+        {
+            buffer.append(&bytes[0], bytes.size());
+        }
+
+        void operator()() const
+        {
+            unsigned int sum = 0;
+            libember::util::OctetStream::segment_iterator const last = buffer.segment_end();
+            for (libember::util::OctetStream::segment_iterator it = buffer.segment_begin(); it != last; ++it)
+            {
+                for (std::size_t i = 0; i < it->second; ++i)
+                {
+                    sum += it->first[i];
+                }
+            }
+            benchmark::keep(sum);
+        }
+
+        libember::util::OctetStream buffer;
+    };
+
+    /** Copies the complete buffer. */
+    struct CopyBuffer
+    {
+        explicit CopyBuffer(Bytes const& bytes)
+        {
+            buffer.append(&bytes[0], bytes.size());
+        }
+
+        void operator()() const
+        {
+            libember::util::OctetStream const copy(buffer);
+            benchmark::keep(copy.size());
+        }
+
+        libember::util::OctetStream buffer;
+    };
+}
+
+int main()
+{
+    Bytes bytes(ByteCount);
+    for (std::size_t i = 0; i < ByteCount; ++i)
+    {
+        bytes[i] = static_cast<unsigned char>(i * 31);
+    }
+
+    benchmark::run("streambuffer_append_byte", ByteCount, AppendBytes());
+    benchmark::run("streambuffer_append_block", ByteCount, AppendBlocks(bytes));
+    benchmark::run("streambuffer_consume_byte", ByteCount, ConsumeBytes(bytes));
+    benchmark::run("streambuffer_iterate_segments", ByteCount, IterateSegments(bytes));
+    benchmark::run("streambuffer_copy", ByteCount, CopyBuffer(bytes));
+    return 0;
+}
@@ -0,0 +1,149 @@
+/*
+    libember -- C++ 03 implementation of the Ember+ Protocol
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include "ember/ber/Ber.hpp"
+
+#define THROW_TEST_EXCEPTION(message)                       \
+            {                                               \
+                std::ostringstream msgStream;               \
+                msgStream << message ;                      \
+                throw std::runtime_error(msgStream.str());  \
+            }
+
+namespace
+{
+    typedef libember::ber::ObjectIdentifier ObjectIdentifier;
+
+    /**
+     * Encodes the passed object identifier, decodes it again and verifies that
+     * the result equals the original and that the cached length is correct.
+     */
+    void assertRoundTrip(ObjectIdentifier const& oid)
+    {
+        libember::util::OctetStream stream;
+        libember::ber::encode(stream, oid);
+        std::size_t const length = stream.size();
+        if (length != oid.encodedLength())
+        {
+            THROW_TEST_EXCEPTION("Invalid encoded length! Expected " << length << ", found " << oid.encodedLength());
+        }
+
+        ObjectIdentifier const decoded = libember::ber::decode<ObjectIdentifier>(stream, length);
+        if (decoded != oid || decoded.encodedLength() != length || decoded.hash() != oid.hash())
+        {
+            THROW_TEST_EXCEPTION("Decoded object identifier differs from the encoded one!");
+        }
+    }
+}
+
+int main(int, char const* const*)
+{
+    try
+    {
+        ObjectIdentifier oid;
+        for (std::size_t i = 0; i < 40; ++i)
+        {
+            oid.push_back(i * 1000);
+            if (oid.size() != i + 1 || oid.back() != i * 1000 || oid.front() != 0)
+            {
+                THROW_TEST_EXCEPTION("Unexpected contents after appending " << (i + 1) << " sub-identifiers!");
+            }
+            assertRoundTrip(oid);
+        }
+
+        // Copies of inline and spilled object identifiers
+        ObjectIdentifier shortOid(7);
+        shortOid.push_back(300);
+        ObjectIdentifier copy(oid);
+        if (copy != oid || copy.hash() != oid.hash())
+        {
+            THROW_TEST_EXCEPTION("Copied object identifier differs from the original!");
+        }
+
+        copy = shortOid;
+        if (copy != shortOid || copy.size() != 2 || copy.encodedLength() != 3)
+        {
+            THROW_TEST_EXCEPTION("Assigned object identifier differs from the original!");
+        }
+
+        swap(copy, oid);
+        if (copy.size() != 40 || oid != shortOid)
+        {
+            THROW_TEST_EXCEPTION("Swapping object identifiers failed!");
+        }
+
+        // Prepending and removing sub-identifiers keeps the length up to date
+        oid.push_front(200000);
+        if (oid.size() != 3 || oid[0] != 200000 || oid[1] != 7 || oid[2] != 300 || oid.encodedLength() != 6)
+        {
+            THROW_TEST_EXCEPTION("Unexpected contents after prepending a sub-identifier!");
+        }
+        assertRoundTrip(oid);
+
+        oid.pop_front();
+        oid.pop_back();
+        if (oid.size() != 1 || oid[0] != 7 || oid.encodedLength() != 1)
+        {
+            THROW_TEST_EXCEPTION("Unexpected contents after removing sub-identifiers!");
+        }
+
+        // Modifications through iterators are taken into account
+        *oid.begin() = 128;
+        if (oid.encodedLength() != 2)
+        {
+            THROW_TEST_EXCEPTION("Modification through an iterator has not been taken into account!");
+        }
+        assertRoundTrip(oid);
+
+        // References stay writable across appending and removing sub-identifiers,
+        // as long as the inline storage is not exceeded
+        ObjectIdentifier::reference first = oid.front();
+        oid.push_back(1);
+        oid.pop_back();
+        oid.push_back(2);
+        first = 7;
+        if (oid.encodedLength() != 2)
+        {
+            THROW_TEST_EXCEPTION("Modification through a reference taken before appending has not been taken into account!");
+        }
+        assertRoundTrip(oid);
+
+        // Copies compute the length of an oid that has handed out references
+        // and keep it cached, independent of the original
+        ObjectIdentifier const copied(oid);
+        ObjectIdentifier assigned;
+        assigned = oid;
+        first = 300;
+        if (copied.encodedLength() != 2 || assigned.encodedLength() != 2 || oid.encodedLength() != 3)
+        {
+            THROW_TEST_EXCEPTION("Invalid encoded length of a copy! Expected 2, found " << copied.encodedLength() << " and " << assigned.encodedLength());
+        }
+        assertRoundTrip(copied);
+        assertRoundTrip(assigned);
+
+        // Ordering
+        ObjectIdentifier const prefix(1);
+        ObjectIdentifier longer(1);
+        longer.push_back(2);
+        if (!(prefix < longer) || (longer < prefix) || (prefix < prefix))
+        {
+            THROW_TEST_EXCEPTION("Invalid ordering of object identifiers!");
+        }
+
+        assertRoundTrip(ObjectIdentifier());
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << "Unexpected exception: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
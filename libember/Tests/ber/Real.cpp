@@ -0,0 +1,143 @@
+/*
+    libember -- C++ 03 implementation of the Ember+ Protocol
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include "ember/ber/Ber.hpp"
+
+#define THROW_TEST_EXCEPTION(message)                       \
+            {                                               \
+                std::ostringstream msgStream;               \
+                msgStream << message ;                      \
+                throw std::runtime_error(msgStream.str());  \
+            }
+
+namespace
+{
+    typedef std::vector<unsigned char> Bytes;
+
+    /**
+     * Encodes the passed value and compares the result with the expected bytes.
+     */
+    void assertEncoding(double value, unsigned char const* expected, std::size_t size)
+    {
+        libember::util::OctetStream stream;
+        libember::ber::encode(stream, value);
+
+        Bytes const bytes(stream.begin(), stream.end());
+        if (bytes != Bytes(expected, expected + size) || libember::ber::encodedLength(value) != size)
+        {
+            THROW_TEST_EXCEPTION("Unexpected encoding of " << value << "!");
+        }
+
+        // Values store reals along with their encoded form
+        libember::ber::Value const wrapped(value);
+        libember::ber::Value const copy(wrapped);
+        libember::util::OctetStream wrappedStream;
+        copy.encode(wrappedStream);
+
+        if (Bytes(wrappedStream.begin(), wrappedStream.end()) != bytes || copy.encodedLength() != size
+        ||  libember::util::type_pun<unsigned long long>(copy.as<double>()) != libember::util::type_pun<unsigned long long>(value))
+        {
+            THROW_TEST_EXCEPTION("Unexpected encoding of " << value << " wrapped in a value!");
+        }
+    }
+
+    /**
+     * Encodes the passed value, decodes it from a stream with small chunks so
+     * that the value is split across chunks at different offsets and verifies
+     * that the bits of the decoded value equal those of the original.
+     */
+    void assertRoundTrip(double value)
+    {
+        for (std::size_t offset = 0; offset < 4; ++offset)
+        {
+            libember::util::OctetStream stream(0, 4);
+            for (std::size_t i = 0; i < offset; ++i)
+            {
+                stream.append(0x00);
+            }
+
+            libember::ber::encodeFrame(stream, value);
+            stream.consume(offset);
+
+            libember::ber::Tag const tag = libember::ber::decode<libember::ber::Tag>(stream);
+            std::size_t const length = libember::ber::decode<libember::ber::Length<unsigned long> >(stream).value;
+            double const decoded = libember::ber::decode<double>(stream, length);
+
+            if (tag != libember::ber::universalTag<double>()
+            ||  libember::util::type_pun<unsigned long long>(decoded) != libember::util::type_pun<unsigned long long>(value)
+            ||  !stream.empty())
+            {
+                THROW_TEST_EXCEPTION("Decoded value " << decoded << " differs from " << value << "!");
+            }
+        }
+    }
+}
+
+int main(int, char const* const*)
+{
+    try
+    {
+        unsigned char const one[] = { 0x80, 0x00, 0x01 };
+        unsigned char const oneAndAHalf[] = { 0x80, 0x00, 0x03 };
+        unsigned char const minusTwo[] = { 0xC0, 0x01, 0x01 };
+        unsigned char const large[] = { 0x81, 0x03, 0xE4, 0x05, 0xF9, 0x0F, 0x22, 0x00, 0x1D, 0x67 };
+        unsigned char const infinity[] = { 0x40 };
+        unsigned char const minusInfinity[] = { 0x41 };
+        unsigned char const notANumber[] = { 0x42 };
+        unsigned char const minusZero[] = { 0x43 };
+
+        assertEncoding(1.0, one, sizeof(one));
+        assertEncoding(1.5, oneAndAHalf, sizeof(oneAndAHalf));
+        assertEncoding(-2.0, minusTwo, sizeof(minusTwo));
+        assertEncoding(1e300, large, sizeof(large));
+        assertEncoding(0.0, 0, 0);
+        assertEncoding(+std::numeric_limits<double>::infinity(), infinity, sizeof(infinity));
+        assertEncoding(-std::numeric_limits<double>::infinity(), minusInfinity, sizeof(minusInfinity));
+        assertEncoding(std::numeric_limits<double>::quiet_NaN(), notANumber, sizeof(notANumber));
+        assertEncoding(-0.0, minusZero, sizeof(minusZero));
+
+        double const values[] =
+        {
+            0.0, -0.0, 1.0, -1.0, 0.1, -12.75, 255.0, 256.0, 1e300, -1e-300,
+            std::numeric_limits<double>::max(),
+            std::numeric_limits<double>::min(),
+            std::numeric_limits<double>::denorm_min(),
+            std::numeric_limits<double>::infinity()
+        };
+
+        for (std::size_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i)
+        {
+            assertRoundTrip(values[i]);
+        }
+
+        for (int i = -10000; i <= 10000; ++i)
+        {
+            assertRoundTrip(i / 64.0);
+            assertRoundTrip(i / 10.0);
+        }
+
+        libember::util::OctetStream stream;
+        libember::ber::encode(stream, std::numeric_limits<float>::quiet_NaN());
+        float const decoded = libember::ber::decode<float>(stream, stream.size());
+        if (decoded == decoded)
+        {
+            THROW_TEST_EXCEPTION("NaN has not been preserved!");
+        }
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << "Unexpected exception: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,127 @@
+/*
+    libember -- C++ 03 implementation of the Ember+ Protocol
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "ember/ber/Ber.hpp"
+
+#define THROW_TEST_EXCEPTION(message)                       \
+            {                                               \
+                std::ostringstream msgStream;               \
+                msgStream << message ;                      \
+                throw std::runtime_error(msgStream.str());  \
+            }
+
+namespace
+{
+    typedef libember::ber::Value Value;
+
+    /**
+     * Encodes the passed value as a frame and verifies the result against the
+     * frame encoded from the plain value.
+     */
+    template<typename ValueType>
+    void assertEncoding(Value const& value, ValueType const& expected)
+    {
+        libember::util::OctetStream valueStream;
+        libember::util::OctetStream expectedStream;
+        libember::ber::encodeFrame(valueStream, value);
+        libember::ber::encodeFrame(expectedStream, expected);
+
+        std::vector<unsigned char> const valueBytes(valueStream.begin(), valueStream.end());
+        std::vector<unsigned char> const expectedBytes(expectedStream.begin(), expectedStream.end());
+        if (valueBytes != expectedBytes || value.encodedLength() != libember::ber::encodedLength(expected))
+        {
+            THROW_TEST_EXCEPTION("Encoded value differs from the encoded " << typeid(ValueType).name() << "!");
+        }
+    }
+}
+
+int main(int, char const* const*)
+{
+    try
+    {
+        std::string const shortString("short");
+        std::string const longString("A string which is too long to be stored inline");
+
+        std::vector<Value> values;
+        values.push_back(Value(42));
+        values.push_back(Value(-4242424242LL));
+        values.push_back(Value(true));
+        values.push_back(Value(3.25));
+        values.push_back(Value(shortString));
+        values.push_back(Value(longString));
+
+        // Copies, assignments and swaps move between inline and shared payloads
+        for (std::size_t round = 0; round < 3; ++round)
+        {
+            std::vector<Value> const copies(values);
+            for (std::size_t i = 0; i + 1 < values.size(); ++i)
+            {
+                swap(values[i], values[i + 1]);
+            }
+
+            for (std::size_t i = 0; i < values.size(); ++i)
+            {
+                Value assigned;
+                assigned = values[i];
+                values[i] = copies[(i + 1) % copies.size()];
+                values[i] = assigned;
+            }
+        }
+
+        Value const rotated[] = { values[3], values[4], values[5], values[0], values[1], values[2] };
+        if (rotated[0].as<int>() != 42
+        ||  rotated[1].as<long long>() != -4242424242LL
+        ||  rotated[2].as<bool>() != true
+        ||  rotated[3].as<double>() != 3.25
+        ||  rotated[4].as<std::string>() != shortString
+        ||  rotated[5].as<std::string>() != longString)
+        {
+            THROW_TEST_EXCEPTION("Values have been modified by copying, assigning or swapping!");
+        }
+
+        assertEncoding(rotated[0], 42);
+        assertEncoding(rotated[1], -4242424242LL);
+        assertEncoding(rotated[2], true);
+        assertEncoding(rotated[3], 3.25);
+        assertEncoding(rotated[4], shortString);
+        assertEncoding(rotated[5], longString);
+
+        bool rejected = false;
+        try
+        {
+            rotated[0].as<long>();
+        }
+        catch (std::bad_cast const&)
+        {
+            rejected = true;
+        }
+
+        if (!rejected)
+        {
+            THROW_TEST_EXCEPTION("Value has been returned as a different type!");
+        }
+
+        Value empty;
+        swap(empty, values[0]);
+        if (!empty || values[0])
+        {
+            THROW_TEST_EXCEPTION("Swapping with a singular value failed!");
+        }
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << "Unexpected exception: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,311 @@
+/*
+    libember -- C++ 03 implementation of the Ember+ Protocol
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "ember/Ember.hpp"
+
+#define THROW_TEST_EXCEPTION(message)                       \
+            {                                               \
+                std::ostringstream msgStream;               \
+                msgStream << message ;                      \
+                throw std::runtime_error(msgStream.str());  \
+            }
+
+namespace
+{
+    typedef std::vector<unsigned char> Bytes;
+
+    Bytes encode(libember::dom::Node const& node)
+    {
+        libember::util::OctetStream stream;
+        node.encode(stream);
+        return Bytes(stream.begin(), stream.end());
+    }
+
+    Bytes createTree()
+    {
+        using namespace libember::glow;
+        GlowRootElementCollection* const root = GlowRootElementCollection::create();
+        GlowNode* const node = new GlowNode(1);
+        node->setIdentifier("node");
+        node->setDescription(std::string(300, 'd'));
+        root->insert(root->end(), node);
+
+        libember::dom::Container* const children = node->children();
+        for (int i = 0; i < 30; ++i)
+        {
+            GlowParameter* const parameter = new GlowParameter(i);
+            parameter->setIdentifier("parameter");
+            parameter->setValue(static_cast<long>(i) * 123456789L);
+            parameter->setFormat(std::string(i * 3, 'f'));
+            children->insert(children->end(), parameter);
+        }
+
+        Bytes const result = encode(*root);
+        delete root;
+        return result;
+    }
+
+    /**
+     * Decodes the passed bytes, either byte by byte or in blocks of the passed size,
+     * and returns the re-encoded tree or the error message.
+     */
+    std::string decode(Bytes const& input, std::size_t blockSize)
+    {
+        libember::dom::AsyncDomReader reader(libember::glow::GlowNodeFactory::getFactory());
+        try
+        {
+            if (blockSize == 0)
+            {
+                for (Bytes::const_iterator it = input.begin(); it != input.end(); ++it)
+                {
+                    reader.read(*it);
+                }
+            }
+            else
+            {
+                unsigned char const* const first = &input[0];
+                for (std::size_t offset = 0; offset < input.size(); offset += blockSize)
+                {
+                    std::size_t const length = std::min(blockSize, input.size() - offset);
+                    reader.read(first + offset, first + offset + length);
+                }
+            }
+        }
+        catch (std::runtime_error const& e)
+        {
+            return std::string("error: ") + e.what();
+        }
+
+        libember::dom::Node* const root = reader.detachRoot();
+        if (root == 0)
+        {
+            return "incomplete";
+        }
+
+        Bytes const encoded = encode(*root);
+        delete root;
+        return std::string(encoded.begin(), encoded.end());
+    }
+
+    /**
+     * Event reader that sums up all integer values and the lengths of all
+     * strings it encounters.
+     */
+    class EventCounter : public libember::dom::AsyncEventReader
+    {
+        public:
+            EventCounter()
+                : containers(0), leafs(0), integerSum(0), stringLength(0), isBalanced(true)
+            {}
+
+            std::size_t containers;
+            std::size_t leafs;
+            long integerSum;
+            std::size_t stringLength;
+            bool isBalanced;
+
+        protected:
+            virtual void enterContainer(libember::ber::Tag const&, libember::ber::Type const&)
+            {
+                ++containers;
+            }
+
+            virtual void leaf(libember::ber::Tag const&, libember::ber::Type const& type, LeafValue const& value)
+            {
+                ++leafs;
+                if (type.value() == libember::ber::Type::Integer)
+                {
+                    integerSum += value.decode<long>();
+                }
+                else if (type.value() == libember::ber::Type::UTF8String)
+                {
+                    std::string text;
+                    value.copy(std::back_inserter(text));
+                    stringLength += text.size();
+                }
+            }
+
+            virtual void exitContainer(libember::ber::Tag const&, libember::ber::Type const&)
+            {
+                if (containers == 0)
+                {
+                    isBalanced = false;
+                }
+            }
+    };
+}
+
+int main(int, char const* const*)
+{
+    try
+    {
+        Bytes const tree = createTree();
+        std::string const expected(tree.begin(), tree.end());
+        if (decode(tree, 0) != expected)
+        {
+            THROW_TEST_EXCEPTION("Byte-wise decoding does not reproduce the encoded tree.");
+        }
+
+        // Block boundaries may fall into any tag, length or value.
+        for (std::size_t blockSize = 1; blockSize <= 67; ++blockSize)
+        {
+            if (decode(tree, blockSize) != expected)
+            {
+                THROW_TEST_EXCEPTION("Decoding in blocks of " << blockSize << " bytes does not reproduce the encoded tree.");
+            }
+        }
+        if (decode(tree, tree.size()) != expected)
+        {
+            THROW_TEST_EXCEPTION("Decoding in a single block does not reproduce the encoded tree.");
+        }
+
+        // The event reader must report every container and value of the tree.
+        {
+            EventCounter counter;
+            counter.read(&tree[0], &tree[0] + tree.size());
+
+            // The numbers of the node and of the parameters are integers as well.
+            long expectedSum = 1;
+            std::size_t expectedLength = 4 + 300;
+            for (int i = 0; i < 30; ++i)
+            {
+                expectedSum += i + static_cast<long>(i) * 123456789L;
+                expectedLength += 9 + i * 3;
+            }
+
+            if (counter.depth() != 0 || !counter.isBalanced)
+            {
+                THROW_TEST_EXCEPTION("Event reader did not leave all containers.");
+            }
+            if (counter.integerSum != expectedSum || counter.stringLength != expectedLength)
+            {
+                THROW_TEST_EXCEPTION("Event reader reported unexpected values: " << counter.integerSum << ", " << counter.stringLength);
+            }
+        }
+
+        // Trees allocated from an arena must be identical and are freed by releasing
+        // the arena, which must allow the memory to be reused by the next tree.
+        {
+            libember::util::MonotonicArena arena(1024);
+            libember::util::MonotonicArena::size_type capacity = 0;
+            for (int pass = 0; pass < 3; ++pass)
+            {
+                libember::dom::AsyncDomReader reader(libember::glow::GlowNodeFactory::getFactory());
+                reader.setArena(&arena);
+                reader.read(&tree[0], &tree[0] + tree.size());
+
+                libember::dom::Node* const root = reader.detachRoot();
+                if (root == 0 || encode(*root) != tree || !root->isArenaAllocated())
+                {
+                    THROW_TEST_EXCEPTION("Decoding into an arena does not reproduce the encoded tree.");
+                }
+
+                // Heap nodes inserted into the tree are deleted along with it, while
+                // erased arena nodes are left to the arena.
+                libember::dom::Container* const container = dynamic_cast<libember::dom::Container*>(root);
+                libember::dom::Node* const leaf = new libember::dom::VariantLeaf(libember::ber::make_tag(libember::ber::Class::ContextSpecific, 1), 1);
+                container->erase(container->begin());
+                container->insert(container->end(), leaf);
+                if (leaf->isArenaAllocated() || container->size() != 1 || &*container->begin() != leaf)
+                {
+                    THROW_TEST_EXCEPTION("Replacing a node of an arena tree failed.");
+                }
+                libember::dom::Node::destroy(root);
+
+                libember::util::OctetStream input;
+                input.append(tree.begin(), tree.end());
+                libember::dom::DomReader domReader;
+                libember::dom::Node* const domRoot = domReader.decodeTree(input, libember::glow::GlowNodeFactory::getFactory(), &arena);
+                if (domRoot == 0 || encode(*domRoot) != tree || !domRoot->isArenaAllocated())
+                {
+                    THROW_TEST_EXCEPTION("DomReader does not reproduce the encoded tree in an arena.");
+                }
+
+                if (arena.size() == 0 || (pass > 0 && arena.capacity() != capacity))
+                {
+                    THROW_TEST_EXCEPTION("Arena did not reuse its memory: " << arena.size() << ", " << arena.capacity());
+                }
+                capacity = arena.capacity();
+                arena.release();
+            }
+        }
+
+        // Containers encoded with indefinite length, either as a whole or streamed
+        // element by element, must decode to the same tree.
+        {
+            libember::dom::AsyncDomReader reader(libember::glow::GlowNodeFactory::getFactory());
+            reader.read(&tree[0], &tree[0] + tree.size());
+            libember::dom::Node* const root = reader.detachRoot();
+            libember::dom::Container const& container = dynamic_cast<libember::dom::Container const&>(*root);
+
+            libember::util::OctetStream whole;
+            libember::dom::StreamingEncoder(whole).write(*root);
+
+            libember::util::OctetStream streamed;
+            Bytes streamedBytes;
+            libember::dom::StreamingEncoder encoder(streamed, libember::dom::StreamingEncoder::LengthForm::Definite);
+            encoder.beginContainer(root->applicationTag(), root->typeTag());
+            for (libember::dom::Container::const_iterator it = container.begin(); it != container.end(); ++it)
+            {
+                encoder.write(*it);
+                streamedBytes.insert(streamedBytes.end(), streamed.begin(), streamed.end());
+                streamed.clear();
+            }
+            encoder.endContainer();
+            streamedBytes.insert(streamedBytes.end(), streamed.begin(), streamed.end());
+            delete root;
+
+            Bytes const wholeBytes(whole.begin(), whole.end());
+            if (wholeBytes.size() <= tree.size() || decode(wholeBytes, 0) != expected || decode(wholeBytes, 7) != expected)
+            {
+                THROW_TEST_EXCEPTION("Decoding a tree with indefinite length containers does not reproduce the encoded tree.");
+            }
+            if (encoder.depth() != 0 || decode(streamedBytes, 5) != expected)
+            {
+                THROW_TEST_EXCEPTION("Decoding a streamed tree does not reproduce the encoded tree.");
+            }
+
+            libember::util::OctetStream input;
+            input.append(wholeBytes.begin(), wholeBytes.end());
+            libember::dom::DomReader domReader;
+            libember::dom::Node* const domRoot = domReader.decodeTree(input, libember::glow::GlowNodeFactory::getFactory());
+            if (domRoot == 0 || encode(*domRoot) != tree)
+            {
+                THROW_TEST_EXCEPTION("DomReader does not reproduce a tree with indefinite length containers.");
+            }
+            delete domRoot;
+        }
+
+        // Damaged input must yield the same result on both paths.
+        for (std::size_t position = 0; position < tree.size(); position += 11)
+        {
+            Bytes damaged = tree;
+            damaged[position] = static_cast<unsigned char>(damaged[position] ^ 0x5A);
+
+            std::string const byteWise = decode(damaged, 0);
+            std::string const blockWise = decode(damaged, 16);
+            if (byteWise != blockWise)
+            {
+                THROW_TEST_EXCEPTION("Decoding damaged input differs at position " << position << ": " << byteWise.substr(0, 60) << " / " << blockWise.substr(0, 60));
+            }
+        }
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
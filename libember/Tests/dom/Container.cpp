@@ -0,0 +1,266 @@
+/*
+    libember -- C++ 03 implementation of the Ember+ Protocol
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include "ember/Ember.hpp"
+
+#define THROW_TEST_EXCEPTION(message)                       \
+            {                                               \
+                std::ostringstream msgStream;               \
+                msgStream << message ;                      \
+                throw std::runtime_error(msgStream.str());  \
+            }
+
+namespace
+{
+    typedef std::vector<unsigned int> Numbers;
+
+    libember::dom::Node* createLeaf(unsigned int number)
+    {
+        return new libember::dom::VariantLeaf(libember::ber::make_tag(libember::ber::Class::ContextSpecific, number), static_cast<int>(number));
+    }
+
+    Numbers numbersOf(libember::dom::Container const& container)
+    {
+        Numbers result;
+        libember::dom::Container::const_iterator const last = container.end();
+        for (libember::dom::Container::const_iterator it = container.begin(); it != last; ++it)
+        {
+            result.push_back(it->applicationTag().number());
+        }
+        return result;
+    }
+
+    void verify(libember::dom::Container const& container, Numbers const& expected, char const* step)
+    {
+        Numbers const actual = numbersOf(container);
+        if (actual != expected || container.size() != expected.size())
+        {
+            THROW_TEST_EXCEPTION("Unexpected children after " << step << ": " << actual.size() << " instead of " << expected.size());
+        }
+
+        libember::dom::Container::const_iterator const last = container.end();
+        for (libember::dom::Container::const_iterator it = container.begin(); it != last; ++it)
+        {
+            if (it->parent() != &container)
+            {
+                THROW_TEST_EXCEPTION("Child with invalid parent after " << step);
+            }
+        }
+    }
+}
+
+int main(int, char const* const*)
+{
+    try
+    {
+        libember::dom::Sequence sequence(libember::ber::make_tag(libember::ber::Class::Application, 1));
+        Numbers expected;
+        verify(sequence, expected, "construction");
+
+        // Append more children than the inline storage holds.
+        for (unsigned int i = 0; i < 20; ++i)
+        {
+            sequence.insert(sequence.end(), createLeaf(i + 10));
+            expected.push_back(i + 10);
+        }
+        verify(sequence, expected, "appending");
+
+        // Insert at the front and in the middle.
+        sequence.insert(sequence.begin(), createLeaf(1));
+        expected.insert(expected.begin(), 1);
+
+        libember::dom::Container::iterator middle = sequence.begin();
+        for (int i = 0; i < 5; ++i)
+        {
+            ++middle;
+        }
+        libember::dom::Container::iterator const inserted = sequence.insert(middle, createLeaf(2));
+        expected.insert(expected.begin() + 5, 2);
+        if (inserted->applicationTag().number() != 2)
+        {
+            THROW_TEST_EXCEPTION("Insert did not return the inserted child.");
+        }
+        verify(sequence, expected, "inserting");
+
+        // Erase a single child and a range.
+        sequence.erase(inserted);
+        expected.erase(expected.begin() + 5);
+        verify(sequence, expected, "erasing a child");
+
+        libember::dom::Container::iterator first = sequence.begin();
+        ++first;
+        libember::dom::Container::iterator last = first;
+        for (int i = 0; i < 10; ++i)
+        {
+            ++last;
+        }
+        sequence.erase(first, last);
+        expected.erase(expected.begin() + 1, expected.begin() + 11);
+        verify(sequence, expected, "erasing a range");
+
+        // Iterators keep referring to their child while other children are
+        // inserted or erased.
+        libember::dom::Container::iterator kept = sequence.begin();
+        ++kept;
+        unsigned int const keptNumber = kept->applicationTag().number();
+        sequence.insert(sequence.begin(), createLeaf(3));
+        expected.insert(expected.begin(), 3);
+        sequence.erase(sequence.begin());
+        expected.erase(expected.begin());
+        sequence.erase(sequence.begin());
+        expected.erase(expected.begin());
+        if (kept->applicationTag().number() != keptNumber || kept != sequence.begin())
+        {
+            THROW_TEST_EXCEPTION("Iterator does not refer to the same child after inserting and erasing.");
+        }
+        verify(sequence, expected, "inserting and erasing before an iterator");
+
+        // Children can be erased while iterating.
+        for (libember::dom::Container::iterator it = sequence.begin(); it != sequence.end(); /* Nothing */)
+        {
+            libember::dom::Container::iterator next = it;
+            ++next;
+            if (it->applicationTag().number() % 2 == 0)
+            {
+                sequence.erase(it);
+            }
+            it = next;
+        }
+
+        Numbers odd;
+        for (Numbers::const_iterator it = expected.begin(); it != expected.end(); ++it)
+        {
+            if (*it % 2 != 0)
+            {
+                odd.push_back(*it);
+            }
+        }
+        expected = odd;
+        verify(sequence, expected, "erasing while iterating");
+
+        // Copies are deep and encode identically.
+        libember::dom::Node* const copy = sequence.clone();
+        libember::dom::Container const* const copiedContainer = dynamic_cast<libember::dom::Container const*>(copy);
+        if (copiedContainer == 0)
+        {
+            THROW_TEST_EXCEPTION("Clone is not a container.");
+        }
+        verify(*copiedContainer, expected, "cloning");
+
+        libember::util::OctetStream original;
+        libember::util::OctetStream copied;
+        sequence.encode(original);
+        copy->encode(copied);
+        delete copy;
+        if (original.size() != copied.size() || !std::equal(original.begin(), original.end(), copied.begin()))
+        {
+            THROW_TEST_EXCEPTION("Clone does not encode like the original.");
+        }
+
+        // Nodes support the nothrow and placement forms of new.
+        {
+            libember::dom::Node* const leaf = new (std::nothrow) libember::dom::VariantLeaf(libember::ber::make_tag(libember::ber::Class::ContextSpecific, 4), 4);
+            if (leaf == 0 || leaf->isArenaAllocated())
+            {
+                THROW_TEST_EXCEPTION("Allocating a node with nothrow new failed.");
+            }
+            delete leaf;
+
+            libember::util::MonotonicArena::max_align_type storage[(sizeof(libember::dom::Sequence) + sizeof(libember::util::MonotonicArena::max_align_type) - 1) / sizeof(libember::util::MonotonicArena::max_align_type)];
+            libember::dom::Sequence* const inPlace = new (static_cast<void*>(storage)) libember::dom::Sequence(libember::ber::make_tag(libember::ber::Class::Application, 2));
+            inPlace->insert(inPlace->end(), createLeaf(5));
+            if (static_cast<void*>(inPlace) != static_cast<void*>(storage) || inPlace->size() != 1)
+            {
+                THROW_TEST_EXCEPTION("Constructing a node in place failed.");
+            }
+            inPlace->~Sequence();
+        }
+
+        // Glow containers keep their children sorted by tag.
+        libember::glow::GlowNode node(1);
+        node.setIdentifier("node");
+        node.setDescription("description");
+        node.setIsOnline(true);
+        node.children();
+        libember::dom::Container::const_iterator previous = node.begin();
+        libember::dom::Container::const_iterator const end = node.end();
+        for (libember::dom::Container::const_iterator it = previous; it != end; previous = it++)
+        {
+            if (it != previous && it->applicationTag() < previous->applicationTag())
+            {
+                THROW_TEST_EXCEPTION("Glow container children are not sorted.");
+            }
+        }
+
+        // Glow property reads go through the content index, which must follow
+        // changes made through the setters and directly on the content set.
+        {
+            libember::glow::GlowParameter parameter(1);
+            parameter.setIdentifier("gain");
+            parameter.setDescription("Gain");
+            parameter.setMinimum(-128L);
+            parameter.setValue(-6L);
+            parameter.setIdentifier("level");
+            if (parameter.identifier() != "level" || parameter.description() != "Gain" || parameter.minimum().toInteger() != -128 || parameter.value().toInteger() != -6)
+            {
+                THROW_TEST_EXCEPTION("Unexpected property values after setting them.");
+            }
+
+            parameter.setFormat("%d dB");
+            if (parameter.format() != "%d dB" || parameter.identifier() != "level")
+            {
+                THROW_TEST_EXCEPTION("Unexpected property values after adding a property.");
+            }
+
+            libember::dom::Container::iterator const contents = libember::glow::util::find_tag(parameter.begin(), parameter.end(), libember::glow::GlowTags::Parameter::Contents());
+            libember::dom::Container& set = dynamic_cast<libember::dom::Container&>(*contents);
+            set.erase(libember::glow::util::find_tag(set.begin(), set.end(), libember::glow::GlowTags::ParameterContents::Identifier()));
+            if (!parameter.identifier().empty() || parameter.description() != "Gain")
+            {
+                THROW_TEST_EXCEPTION("Property lookup does not reflect a property erased from the content set.");
+            }
+        }
+
+        // The tree encoder produces the same encoding as the nodes themselves,
+        // including for nested glow containers and foreign leaves.
+        {
+            libember::glow::GlowRootElementCollection* const root = libember::glow::GlowRootElementCollection::create();
+            libember::glow::GlowNode* const child = new libember::glow::GlowNode(1);
+            child->setIdentifier("child");
+            child->children()->insert(child->children()->end(), new libember::glow::GlowParameter(2));
+            root->insert(root->end(), child);
+            root->insert(root->end(), sequence.clone());
+
+            libember::util::OctetStream expectedEncoding;
+            root->encode(expectedEncoding);
+
+            libember::dom::TreeEncoder encoder;
+            std::size_t const length = encoder.measure(*root);
+            libember::util::OctetStream encoded(0, length);
+            encoder.encode(encoded);
+            if (length != expectedEncoding.size() || encoded.size() != length || !std::equal(encoded.begin(), encoded.end(), expectedEncoding.begin()))
+            {
+                THROW_TEST_EXCEPTION("Tree encoder does not encode like the nodes: " << encoded.size() << " instead of " << expectedEncoding.size() << " bytes");
+            }
+            delete root;
+        }
+
+        sequence.clear();
+        verify(sequence, Numbers(), "clearing");
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,277 @@
+/*
+    libember -- C++ 03 implementation of the Ember+ Protocol
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include "ember/Ember.hpp"
+
+#define THROW_TEST_EXCEPTION(message)                       \
+            {                                               \
+                std::ostringstream msgStream;               \
+                msgStream << message ;                      \
+                throw std::runtime_error(msgStream.str());  \
+            }
+
+namespace
+{
+    typedef std::vector<unsigned char> Bytes;
+    namespace codec = libember::glow::codec;
+
+    Bytes bytesOf(libember::util::OctetStream const& stream)
+    {
+        return Bytes(stream.begin(), stream.end());
+    }
+
+    Bytes encode(libember::dom::Node const& node)
+    {
+        libember::util::OctetStream stream;
+        node.encode(stream);
+        return bytesOf(stream);
+    }
+
+    libember::ber::ObjectIdentifier makePath(int first, int second)
+    {
+        libember::ber::ObjectIdentifier path;
+        path.push_back(first);
+        path.push_back(second);
+        return path;
+    }
+
+    /**
+     * Collects all decoded elements.
+     */
+    struct Collector : codec::MessageHandler
+    {
+        Collector()
+            : unsupported(0)
+        {}
+
+        void command(codec::Command const& command)
+        {
+            commands.push_back(command);
+        }
+
+        void qualifiedParameter(codec::QualifiedParameter const& parameter)
+        {
+            parameters.push_back(parameter);
+        }
+
+        void qualifiedNode(codec::QualifiedNode const& node)
+        {
+            nodes.push_back(node);
+        }
+
+        void qualifiedMatrix(codec::QualifiedMatrix const& matrix)
+        {
+            matrices.push_back(matrix);
+        }
+
+        void streamEntry(codec::StreamEntry const& entry)
+        {
+            streams.push_back(entry);
+        }
+
+        void unsupportedElement(libember::ber::Tag const&)
+        {
+            ++unsupported;
+        }
+
+        std::vector<codec::Command> commands;
+        std::vector<codec::QualifiedParameter> parameters;
+        std::vector<codec::QualifiedNode> nodes;
+        std::vector<codec::QualifiedMatrix> matrices;
+        std::vector<codec::StreamEntry> streams;
+        int unsupported;
+    };
+
+    Collector decode(Bytes const& bytes)
+    {
+        libember::util::OctetStream input;
+        input.append(bytes.begin(), bytes.end());
+
+        Collector collector;
+        codec::decodeMessage(input, collector);
+        if (!input.empty())
+        {
+            THROW_TEST_EXCEPTION("Message has not been consumed completely.");
+        }
+        return collector;
+    }
+}
+
+int main(int, char const* const*)
+{
+    using namespace libember::glow;
+    try
+    {
+        // Elements encoded by the dom must be decoded by the codec and encoded
+        // back to the same bytes.
+        GlowRootElementCollection* const root = GlowRootElementCollection::create();
+
+        GlowQualifiedParameter* const parameter = new GlowQualifiedParameter(root, makePath(1, 2));
+        parameter->setIdentifier("gain");
+        parameter->setValue(-6L);
+        parameter->setMinimum(-128L);
+        parameter->setFormat("%d dB");
+        parameter->setIsOnline(true);
+
+        GlowQualifiedParameter* const text = new GlowQualifiedParameter(root, makePath(1, 3));
+        text->setValue(std::string("text"));
+        text->setStreamIdentifier(7);
+
+        GlowQualifiedNode* const node = new GlowQualifiedNode(root, makePath(1, 4));
+        new GlowCommand(node, CommandType::GetDirectory, DirFieldMask::All);
+
+        new GlowCommand(root, CommandType::GetDirectory);
+
+        GlowQualifiedMatrix* const matrix = new GlowQualifiedMatrix(root, makePath(2, 1));
+        GlowConnection* const connection = new GlowConnection(5);
+        connection->setSources(makePath(3, 4));
+        connection->setOperation(ConnectionOperation::Connect);
+        matrix->connections()->insert(matrix->connections()->end(), connection);
+        matrix->connections()->insert(matrix->connections()->end(), new GlowConnection(6));
+
+        Bytes const elements = encode(*root);
+        delete root;
+
+        Collector const collector = decode(elements);
+        if (collector.parameters.size() != 2 || collector.nodes.size() != 1 || collector.commands.size() != 1 || collector.matrices.size() != 1 || collector.unsupported != 0)
+        {
+            THROW_TEST_EXCEPTION("Unexpected number of decoded elements.");
+        }
+
+        codec::QualifiedParameter const& decodedParameter = collector.parameters.front();
+        codec::ParameterContents const& contents = decodedParameter.contents.value();
+        if (decodedParameter.path != makePath(1, 2) || contents.identifier.value() != "gain" || contents.value.value() != codec::ScalarValue(-6L)
+        ||  contents.minimum.value() != codec::ScalarValue(-128L) || contents.format.value() != "%d dB" || !contents.isOnline.value() || contents.description.hasValue())
+        {
+            THROW_TEST_EXCEPTION("Unexpected parameter contents.");
+        }
+        if (collector.parameters.back().contents.value().value.value() != codec::ScalarValue("text") || collector.parameters.back().contents.value().streamIdentifier.value() != 7)
+        {
+            THROW_TEST_EXCEPTION("Unexpected string parameter contents.");
+        }
+
+        codec::QualifiedNode const& decodedNode = collector.nodes.front();
+        if (decodedNode.path != makePath(1, 4) || decodedNode.children.items.size() != 1
+        ||  decodedNode.children.items.front().number != CommandType::GetDirectory || decodedNode.children.items.front().dirFieldMask.value() != DirFieldMask::All)
+        {
+            THROW_TEST_EXCEPTION("Unexpected qualified node.");
+        }
+
+        codec::QualifiedMatrix const& decodedMatrix = collector.matrices.front();
+        if (decodedMatrix.path != makePath(2, 1) || decodedMatrix.connections.items.size() != 2
+        ||  decodedMatrix.connections.items.front().target != 5 || decodedMatrix.connections.items.front().sources.value() != makePath(3, 4)
+        ||  decodedMatrix.connections.items.front().operation.value() != ConnectionOperation::Connect || decodedMatrix.connections.items.back().sources.hasValue())
+        {
+            THROW_TEST_EXCEPTION("Unexpected matrix connections.");
+        }
+
+        // Records encoded as a message must decode to the same records.
+        {
+            libember::util::OctetStream output;
+            codec::encodeElements(output, collector.parameters.begin(), collector.parameters.end());
+            Collector const reencoded = decode(bytesOf(output));
+            if (reencoded.parameters.size() != 2 || reencoded.parameters.front().contents.value().value.value() != codec::ScalarValue(-6L)
+            ||  reencoded.parameters.back().path != makePath(1, 3))
+            {
+                THROW_TEST_EXCEPTION("Re-encoded parameters do not decode.");
+            }
+        }
+
+        // Each record must encode exactly like the corresponding dom element.
+        {
+            libember::util::OctetStream input;
+            input.append(elements.begin(), elements.end());
+            libember::dom::DomReader reader;
+            libember::dom::Node* const decodedRoot = reader.decodeTree(input, GlowNodeFactory::getFactory());
+            libember::dom::Container const& container = dynamic_cast<libember::dom::Container const&>(*decodedRoot);
+
+            std::vector<Bytes> recordBytes;
+            libember::util::OctetStream output;
+            codec::encode(output, collector.parameters.front());
+            recordBytes.push_back(bytesOf(output));
+            output.clear();
+            codec::encode(output, collector.parameters.back());
+            recordBytes.push_back(bytesOf(output));
+            output.clear();
+            codec::encode(output, collector.nodes.front());
+            recordBytes.push_back(bytesOf(output));
+            output.clear();
+            codec::encode(output, collector.commands.front());
+            recordBytes.push_back(bytesOf(output));
+            output.clear();
+            codec::encode(output, collector.matrices.front());
+            recordBytes.push_back(bytesOf(output));
+
+            std::size_t index = 0;
+            for (libember::dom::Container::const_iterator it = container.begin(); it != container.end(); ++it, ++index)
+            {
+                // The dom element is wrapped in the context-specific tag of the collection.
+                Bytes const element = encode(*it);
+                Bytes const& record = recordBytes[index];
+                if (element.size() < record.size() || !std::equal(record.begin(), record.end(), element.end() - record.size()))
+                {
+                    THROW_TEST_EXCEPTION("Record " << index << " does not encode like the dom element.");
+                }
+            }
+            delete decodedRoot;
+        }
+
+        // Stream collections
+        {
+            GlowStreamCollection* const streams = GlowStreamCollection::create();
+            streams->insert(1, 100);
+            streams->insert(2, 0.5);
+            streams->insert(3, std::string("level"));
+            Bytes const streamBytes = encode(*streams);
+            delete streams;
+
+            Collector const decodedStreams = decode(streamBytes);
+            if (decodedStreams.streams.size() != 3 || decodedStreams.streams[0].streamIdentifier != 1 || decodedStreams.streams[0].streamValue != codec::ScalarValue(100)
+            ||  decodedStreams.streams[1].streamValue != codec::ScalarValue(0.5) || decodedStreams.streams[2].streamValue != codec::ScalarValue("level"))
+            {
+                THROW_TEST_EXCEPTION("Unexpected stream entries.");
+            }
+
+            libember::util::OctetStream output;
+            codec::encodeStreams(output, decodedStreams.streams.begin(), decodedStreams.streams.end());
+            if (bytesOf(output) != streamBytes)
+            {
+                THROW_TEST_EXCEPTION("Stream entries do not encode like the dom.");
+            }
+        }
+
+        // Containers of indefinite length, and unsupported elements, which are skipped.
+        {
+            GlowRootElementCollection* const mixed = GlowRootElementCollection::create();
+            GlowNode* const plainNode = new GlowNode(mixed, 1);
+            plainNode->setIdentifier("node");
+            GlowQualifiedParameter* const qualified = new GlowQualifiedParameter(mixed, makePath(1, 2));
+            qualified->setValue(1.5);
+
+            libember::util::OctetStream output;
+            libember::dom::StreamingEncoder(output).write(*mixed);
+            delete mixed;
+
+            Collector const decodedMixed = decode(bytesOf(output));
+            if (decodedMixed.unsupported != 1 || decodedMixed.parameters.size() != 1 || decodedMixed.parameters.front().contents.value().value.value() != codec::ScalarValue(1.5))
+            {
+                THROW_TEST_EXCEPTION("Unexpected elements decoded from containers of indefinite length.");
+            }
+        }
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,119 @@
+/*
+    libember -- C++ 03 implementation of the Ember+ Protocol
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include "ember/glow/MinMax.hpp"
+#include "ember/glow/Value.hpp"
+#include "ember/glow/ValuePool.hpp"
+
+#define THROW_TEST_EXCEPTION(message)                       \
+            {                                               \
+                std::ostringstream msgStream;               \
+                msgStream << message ;                      \
+                throw std::runtime_error(msgStream.str());  \
+            }
+
+namespace
+{
+    using libember::glow::Variant;
+
+    /**
+     * Creates two variants from the passed value and verifies whether both
+     * refer to the same instance.
+     */
+    template<typename ValueType>
+    void assertShared(ValueType const& value, bool expected)
+    {
+        Variant* const first = Variant::create(value);
+        Variant* const second = Variant::create(value);
+        bool const shared = (first == second);
+        first->releaseRef();
+        second->releaseRef();
+
+        if (shared != expected)
+        {
+            THROW_TEST_EXCEPTION("Unexpected sharing of variants created from " << value << "!");
+        }
+    }
+
+    /**
+     * Created during static initialization, possibly before the shared
+     * instances exist, in which case the value has an instance of its own.
+     */
+    libember::glow::Value const staticZero(0L);
+}
+
+int main(int, char const* const*)
+{
+    try
+    {
+        assertShared(0L, true);
+        assertShared(1L, true);
+        assertShared(2L, false);
+        assertShared(true, true);
+        assertShared(false, true);
+        assertShared(std::string(), true);
+        assertShared(std::string("Off"), false);
+        assertShared(0.0, false);
+
+        Variant* const none = Variant::create<void*>(0);
+        Variant* const other = Variant::create<void*>(0);
+        if (none != other)
+        {
+            THROW_TEST_EXCEPTION("Null variants are not shared!");
+        }
+        none->releaseRef();
+        other->releaseRef();
+
+        // Shared instances survive releasing all references held by values
+        for (int round = 0; round < 2; ++round)
+        {
+            libember::glow::Value const zero(0L);
+            libember::glow::Value const yes(true);
+            libember::glow::Value const empty(std::string(""));
+            libember::glow::Value const null;
+            libember::glow::MinMax const minimum(0L);
+
+            if (zero.toInteger() != 0 || zero.type().value() != libember::glow::ParameterType::Integer
+            ||  yes.toBoolean() != true || yes.type().value() != libember::glow::ParameterType::Boolean
+            ||  !empty.toString().empty() || empty.type().value() != libember::glow::ParameterType::String
+            ||  !null.isNull()
+            ||  minimum.toInteger() != 0)
+            {
+                THROW_TEST_EXCEPTION("Shared values are invalid in round " << round << "!");
+            }
+        }
+
+        if (staticZero.toInteger() != 0 || staticZero.type().value() != libember::glow::ParameterType::Integer)
+        {
+            THROW_TEST_EXCEPTION("A value created during static initialization is invalid!");
+        }
+
+        libember::glow::ValuePool pool;
+        libember::glow::Value const& off = pool.intern("Off");
+        libember::glow::Value const& on = pool.intern("On");
+        if (&pool.intern("Off") != &off || pool.find("On") != &on || pool.find("Auto") != 0 || pool.size() != 2)
+        {
+            THROW_TEST_EXCEPTION("Unexpected contents of the value pool!");
+        }
+
+        if (off.toString() != "Off" || on.toString() != "On")
+        {
+            THROW_TEST_EXCEPTION("Pooled values differ from the interned strings!");
+        }
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << "Unexpected exception: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
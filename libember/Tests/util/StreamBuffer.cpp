@@ -6,7 +6,9 @@
     (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 */
 
+#include <cstdlib>
 #include <iostream>
+#include <new>
 #include <sstream>
 #include <stdexcept>
 #include <ember/util/StreamBuffer.hpp>
@@ -20,6 +22,39 @@
     
 template class libember::util::StreamBuffer<unsigned short>;
 
+namespace
+{
+    std::size_t allocationCount = 0;
+}
+
+/** Counts the heap allocations, so that the number of allocations per chunk can be verified. */
+#if __cplusplus >= 201103L
+void* operator new(std::size_t size)
+#else
+void* operator new(std::size_t size) throw(std::bad_alloc)
+#endif
+{
+    ++allocationCount;
+    void* const memory = std::malloc(size > 0 ? size : 1);
+    if (memory == 0)
+    {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void operator delete(void* memory) throw()
+{
+    std::free(memory);
+}
+
+#if defined(__cpp_sized_deallocation)
+void operator delete(void* memory, std::size_t) throw()
+{
+    std::free(memory);
+}
+#endif
+
 int main(int, char const* const*)
 {
     try
@@ -66,6 +101,110 @@ int main(int, char const* const*)
                 }
             }
         }
+
+        if (!testStream.empty() || testStream.size() != 0)
+        {
+            THROW_TEST_EXCEPTION("Buffer not empty after consuming all elements!");
+        }
+
+        // A buffer with a runtime chunk size that spans several chunks must be
+        // copied completely and keep its contents after being cleared and refilled.
+        StreamBuffer<unsigned short, 256> chunkedStream(0, 64);
+        if (chunkedStream.chunk_size() != 64)
+        {
+            THROW_TEST_EXCEPTION("Invalid chunk size! Expected 64, found " << chunkedStream.chunk_size());
+        }
+        for (unsigned int pass = 0; pass < 3; ++pass)
+        {
+            for (unsigned int i = 0; i < 100; ++i)
+            {
+                chunkedStream.append(static_cast<unsigned short>(i + pass));
+            }
+
+            StreamBuffer<unsigned short, 256> copy(chunkedStream);
+            if (copy.size() != 100 || chunkedStream.size() != 100)
+            {
+                THROW_TEST_EXCEPTION("Invalid size of copy! Expected 100, found " << copy.size());
+            }
+            unsigned int expected = pass;
+            for (StreamBuffer<unsigned short, 256>::iterator it = copy.begin(); it != copy.end(); ++it, ++expected)
+            {
+                if (*it != expected)
+                {
+                    THROW_TEST_EXCEPTION("Invalid element in copy! Expected " << expected << ", found " << *it);
+                }
+            }
+            if (expected != pass + 100)
+            {
+                THROW_TEST_EXCEPTION("Copy is incomplete! Expected " << 100 << " elements, found " << (expected - pass));
+            }
+
+            chunkedStream.clear();
+            if (!chunkedStream.empty() || chunkedStream.begin() != chunkedStream.end())
+            {
+                THROW_TEST_EXCEPTION("Buffer not empty after clear!");
+            }
+        }
+        chunkedStream.shrink_to_fit();
+
+        // The segments of a buffer must cover its contents in order, bulk appends
+        // must continue the partially filled tail chunk.
+        StreamBuffer<unsigned char, 256> octets(0, 100);
+        unsigned char source[1000];
+        for (unsigned int i = 0; i < sizeof(source); ++i)
+        {
+            source[i] = static_cast<unsigned char>(i * 7);
+        }
+        octets.append(source, 1);
+        octets.append(source + 1, 349);
+        octets.append(source + 350, source + 1000);
+        octets.consume(150);
+
+        std::size_t offset = 150;
+        std::size_t segmentCount = 0;
+        for (StreamBuffer<unsigned char, 256>::segment_iterator it = octets.segment_begin(); it != octets.segment_end(); ++it, ++segmentCount)
+        {
+            if (it->second == 0 || it->second > 100)
+            {
+                THROW_TEST_EXCEPTION("Invalid segment length " << it->second);
+            }
+            for (std::size_t i = 0; i < it->second; ++i, ++offset)
+            {
+                if (it->first[i] != source[offset])
+                {
+                    THROW_TEST_EXCEPTION("Invalid element in segment! Expected " << int(source[offset]) << ", found " << int(it->first[i]));
+                }
+            }
+        }
+        if (offset != sizeof(source) || segmentCount != 9 || octets.size() != 850)
+        {
+            THROW_TEST_EXCEPTION("Segments are incomplete! Expected 850 elements in 9 segments, found " << (offset - 150) << " in " << segmentCount);
+        }
+
+        // A fresh buffer allocates each chunk along with its storage in a single
+        // block, and so does a copy.
+        {
+            std::size_t const length = 1024 * 1024;
+            std::size_t const chunks = length / 256;
+
+            std::size_t const before = allocationCount;
+            StreamBuffer<unsigned char, 256> fresh;
+            for (std::size_t appended = 0; appended < length; appended += 1000)
+            {
+                fresh.append(source, appended + 1000 < length ? 1000 : length - appended);
+            }
+            if (fresh.size() != length || allocationCount - before != chunks)
+            {
+                THROW_TEST_EXCEPTION("Filling a fresh buffer took " << (allocationCount - before) << " allocations for " << chunks << " chunks");
+            }
+
+            std::size_t const beforeCopy = allocationCount;
+            StreamBuffer<unsigned char, 256> const copy(fresh);
+            if (copy.size() != length || allocationCount - beforeCopy != chunks)
+            {
+                THROW_TEST_EXCEPTION("Copying a buffer took " << (allocationCount - beforeCopy) << " allocations for " << chunks << " chunks");
+            }
+        }
     }
     catch (std::exception const& e)
     {
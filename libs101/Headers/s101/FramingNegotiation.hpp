@@ -0,0 +1,179 @@
+/*
+    libs101 -- C++ 03 implementation of the S101 encoding and decoding
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __LIBS101_FRAMINGNEGOTIATION_HPP
+#define __LIBS101_FRAMINGNEGOTIATION_HPP
+
+#include "CommandType.hpp"
+#include "MessageType.hpp"
+#include "StreamDecoder.hpp"
+
+//SimianIgnore
+
+namespace libs101
+{
+    /**
+     * Tracks which framing variant may be used to send messages to a remote peer.
+     * Frames without escaping start with the Invalid byte (0xF8) and a length
+     * prefix instead of BoF, and are neither escaped nor protected by a crc, which
+     * makes them considerably cheaper to encode and decode on reliable links.
+     * A peer is considered to support them as soon as it has sent such a frame.
+     * To find out whether a peer supports them, a keep-alive request encoded
+     * with a StreamEncoderWithoutEscaping (see encodeProbe) can be sent: a peer
+     * that understands the variant answers in kind, using
+     * KeepAliveFrame::response(bool) with the framing variant of the request.
+     * Using frames without escaping has to be enabled explicitly, since decoders
+     * that don't know the variant may misinterpret the probe.
+     * One instance is required per connection.
+     */
+    class FramingNegotiation
+    {
+        public:
+            /**
+             * Enumerates the framing variants.
+             */
+            enum Mode
+            {
+                /** Frames start with BoF, special bytes are escaped and a crc is appended. */
+                WithEscaping,
+
+                /** Frames start with the Invalid byte and the payload length, no escaping is applied. */
+                WithoutEscaping
+            };
+
+        public:
+            /**
+             * Constructor.
+             * @param isWithoutEscapingEnabled If set to true, frames without escaping are
+             *      used as soon as the peer has been detected to support them.
+             */
+            explicit FramingNegotiation(bool isWithoutEscapingEnabled = false);
+
+            /**
+             * Returns the framing variant to use for outgoing messages.
+             * @return WithoutEscaping if the variant has been enabled and the peer
+             *      supports it, otherwise WithEscaping.
+             */
+            Mode mode() const;
+
+            /**
+             * Returns true if frames without escaping may be used, once the peer
+             * supports them.
+             * @return true if frames without escaping are enabled.
+             */
+            bool isWithoutEscapingEnabled() const;
+
+            /**
+             * Returns true if the peer has sent at least one frame without escaping.
+             * @return true if the peer supports frames without escaping.
+             */
+            bool isWithoutEscapingSupportedByPeer() const;
+
+            /**
+             * Enables or disables the use of frames without escaping.
+             * @param value true to use frames without escaping when possible.
+             */
+            void setWithoutEscapingEnabled(bool value);
+
+            /**
+             * Records the framing variant of a frame received from the peer.
+             * @param isFrameWithoutEscaping true if the frame did not use escaping.
+             */
+            void notify(bool isFrameWithoutEscaping);
+
+            /**
+             * Records the framing variant of the frame currently being decoded.
+             * This method must be called from within the decoder callback.
+             * @param decoder The decoder invoking the callback.
+             */
+            template<typename ValueType>
+            void notify(StreamDecoder<ValueType> const& decoder);
+
+            /**
+             * Forgets what has been learned about the peer, e.g. after the
+             * connection has been re-established.
+             */
+            void reset();
+
+            /**
+             * Encodes a keep-alive request that can be used to probe the peer.
+             * Pass a StreamEncoderWithoutEscaping to query support for frames
+             * without escaping.
+             * @param encoder The encoder to write the request to. The encoder is finished.
+             * @param slot The slot identifier to use.
+             */
+            template<typename EncoderType>
+            static void encodeProbe(EncoderType& encoder, unsigned char slot = 0x00);
+
+        private:
+            bool m_isWithoutEscapingEnabled;
+            bool m_isWithoutEscapingSupportedByPeer;
+    };
+
+    /**************************************************************************/
+    /* Mandatory inline implementation                                        */
+    /**************************************************************************/
+
+    inline FramingNegotiation::FramingNegotiation(bool isWithoutEscapingEnabled)
+        : m_isWithoutEscapingEnabled(isWithoutEscapingEnabled)
+        , m_isWithoutEscapingSupportedByPeer(false)
+    {}
+
+    inline FramingNegotiation::Mode FramingNegotiation::mode() const
+    {
+        return m_isWithoutEscapingEnabled && m_isWithoutEscapingSupportedByPeer
+            ? WithoutEscaping
+            : WithEscaping;
+    }
+
+    inline bool FramingNegotiation::isWithoutEscapingEnabled() const
+    {
+        return m_isWithoutEscapingEnabled;
+    }
+
+    inline bool FramingNegotiation::isWithoutEscapingSupportedByPeer() const
+    {
+        return m_isWithoutEscapingSupportedByPeer;
+    }
+
+    inline void FramingNegotiation::setWithoutEscapingEnabled(bool value)
+    {
+        m_isWithoutEscapingEnabled = value;
+    }
+
+    inline void FramingNegotiation::notify(bool isFrameWithoutEscaping)
+    {
+        if (isFrameWithoutEscaping)
+            m_isWithoutEscapingSupportedByPeer = true;
+    }
+
+    template<typename ValueType>
+    inline void FramingNegotiation::notify(StreamDecoder<ValueType> const& decoder)
+    {
+        notify(decoder.isDecodingFrameWithoutEscaping());
+    }
+
+    inline void FramingNegotiation::reset()
+    {
+        m_isWithoutEscapingSupportedByPeer = false;
+    }
+
+    template<typename EncoderType>
+    inline void FramingNegotiation::encodeProbe(EncoderType& encoder, unsigned char slot)
+    {
+        encoder.encode(slot);                                                       // Slot
+        encoder.encode(static_cast<unsigned char>(MessageType::EmBER));             // Message Type
+        encoder.encode(static_cast<unsigned char>(CommandType::KeepAliveRequest));  // Command
+        encoder.encode(0x01);                                                       // Framing Version (1)
+        encoder.finish();
+    }
+}
+
+//EndSimianIgnore
+
+#endif  // __LIBS101_FRAMINGNEGOTIATION_HPP
@@ -0,0 +1,221 @@
+/*
+    libs101 -- C++ 03 implementation of the S101 encoding and decoding
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __LIBS101_KEEPALIVEFRAME_HPP
+#define __LIBS101_KEEPALIVEFRAME_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include "CommandType.hpp"
+#include "MessageType.hpp"
+#include "StreamEncoder.hpp"
+#include "StreamEncoderWithoutEscaping.hpp"
+
+//SimianIgnore
+
+namespace libs101
+{
+    /**
+     * Holds a completely encoded keep-alive frame for slot 0. Since these frames
+     * never change, they are encoded once during static initialization and can be
+     * written to any number of connections without running the encoder again.
+     * Each frame is available with and without escaping. A keep-alive request
+     * should be answered using the framing variant of the request, which lets
+     * the peer detect support for frames without escaping (see FramingNegotiation).
+     */
+    class KeepAliveFrame
+    {
+        public:
+            typedef unsigned char value_type;
+            typedef value_type const* const_iterator;
+            typedef std::size_t size_type;
+
+            /**
+             * Returns the encoded keep-alive request.
+             * @return The encoded keep-alive request.
+             */
+            static KeepAliveFrame const& request();
+
+            /**
+             * Returns the encoded keep-alive response.
+             * @return The encoded keep-alive response.
+             */
+            static KeepAliveFrame const& response();
+
+            /**
+             * Returns the keep-alive request encoded as a frame without escaping.
+             * @return The encoded keep-alive request without escaping.
+             */
+            static KeepAliveFrame const& requestWithoutEscaping();
+
+            /**
+             * Returns the keep-alive response encoded as a frame without escaping.
+             * @return The encoded keep-alive response without escaping.
+             */
+            static KeepAliveFrame const& responseWithoutEscaping();
+
+            /**
+             * Returns the keep-alive response using the passed framing variant.
+             * @param isWithoutEscaping true to return the response without escaping,
+             *      e.g. because the request has been received without escaping.
+             * @return The encoded keep-alive response.
+             */
+            static KeepAliveFrame const& response(bool isWithoutEscaping);
+
+            /**
+             * Returns the first byte of the frame.
+             * @return The first byte of the frame.
+             */
+            const_iterator begin() const;
+
+            /**
+             * Returns a pointer one past the last byte of the frame.
+             * @return A pointer one past the last byte of the frame.
+             */
+            const_iterator end() const;
+
+            /**
+             * Returns the number of bytes of the frame.
+             * @return The number of bytes of the frame.
+             */
+            size_type size() const;
+
+        private:
+            /**
+             * The largest possible frame: BoF, four header bytes, two crc bytes
+             * which may both require escaping and EoF. A frame without escaping
+             * consists of the Invalid byte, the size of the length field, four
+             * length bytes and the four header bytes, which fits as well.
+             */
+            enum { MaximumLength = 1 + 4 + 4 + 1 };
+
+            /**
+             * Constructor, encodes the frame.
+             * @param command The keep-alive command to encode.
+             * @param isWithoutEscaping true to encode a frame without escaping.
+             */
+            KeepAliveFrame(CommandType::_Domain command, bool isWithoutEscaping);
+
+            /**
+             * Holds the encoded frames. They are static members of a class template
+             * so that they can be defined in this header, and they are encoded during
+             * static initialization, before any thread that could race on them has
+             * been started. Frames accessed by the constructors of other static
+             * objects may still be empty.
+             */
+            template<typename Tag>
+            struct Frames
+            {
+                static KeepAliveFrame const request;
+                static KeepAliveFrame const response;
+                static KeepAliveFrame const requestWithoutEscaping;
+                static KeepAliveFrame const responseWithoutEscaping;
+            };
+
+            /**
+             * Encodes the frame using the passed encoder.
+             * @param encoder The encoder to use.
+             * @param command The keep-alive command to encode.
+             */
+            template<typename EncoderType>
+            void encode(EncoderType& encoder, CommandType::_Domain command);
+
+        private:
+            value_type m_bytes[MaximumLength];
+            size_type m_size;
+    };
+
+    /**************************************************************************/
+    /* Mandatory inline implementation                                        */
+    /**************************************************************************/
+
+    inline KeepAliveFrame::KeepAliveFrame(CommandType::_Domain command, bool isWithoutEscaping)
+    {
+        if (isWithoutEscaping)
+        {
+            StreamEncoderWithoutEscaping<value_type> encoder;
+            encode(encoder, command);
+        }
+        else
+        {
+            StreamEncoder<value_type> encoder;
+            encode(encoder, command);
+        }
+    }
+
+    template<typename EncoderType>
+    inline void KeepAliveFrame::encode(EncoderType& encoder, CommandType::_Domain command)
+    {
+        encoder.encode(0x00);                                   // Slot
+        encoder.encode(MessageType::EmBER);                     // Message Type
+        encoder.encode(static_cast<value_type>(command));       // Command
+        encoder.encode(0x01);                                   // Framing Version (1)
+        encoder.finish();
+
+        m_size = encoder.size();
+        std::copy(encoder.begin(), encoder.end(), m_bytes);
+    }
+
+    template<typename Tag>
+    KeepAliveFrame const KeepAliveFrame::Frames<Tag>::request(CommandType::KeepAliveRequest, false);
+
+    template<typename Tag>
+    KeepAliveFrame const KeepAliveFrame::Frames<Tag>::response(CommandType::KeepAliveResponse, false);
+
+    template<typename Tag>
+    KeepAliveFrame const KeepAliveFrame::Frames<Tag>::requestWithoutEscaping(CommandType::KeepAliveRequest, true);
+
+    template<typename Tag>
+    KeepAliveFrame const KeepAliveFrame::Frames<Tag>::responseWithoutEscaping(CommandType::KeepAliveResponse, true);
+
+    inline KeepAliveFrame const& KeepAliveFrame::request()
+    {
+        return Frames<void>::request;
+    }
+
+    inline KeepAliveFrame const& KeepAliveFrame::response()
+    {
+        return Frames<void>::response;
+    }
+
+    inline KeepAliveFrame const& KeepAliveFrame::requestWithoutEscaping()
+    {
+        return Frames<void>::requestWithoutEscaping;
+    }
+
+    inline KeepAliveFrame const& KeepAliveFrame::responseWithoutEscaping()
+    {
+        return Frames<void>::responseWithoutEscaping;
+    }
+
+    inline KeepAliveFrame const& KeepAliveFrame::response(bool isWithoutEscaping)
+    {
+        return isWithoutEscaping
+            ? responseWithoutEscaping()
+            : response();
+    }
+
+    inline KeepAliveFrame::const_iterator KeepAliveFrame::begin() const
+    {
+        return m_bytes;
+    }
+
+    inline KeepAliveFrame::const_iterator KeepAliveFrame::end() const
+    {
+        return m_bytes + m_size;
+    }
+
+    inline KeepAliveFrame::size_type KeepAliveFrame::size() const
+    {
+        return m_size;
+    }
+}
+
+//EndSimianIgnore
+
+#endif  // __LIBS101_KEEPALIVEFRAME_HPP
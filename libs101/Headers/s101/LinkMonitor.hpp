@@ -0,0 +1,485 @@
+/*
+    libs101 -- C++ 03 implementation of the S101 encoding and decoding
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __LIBS101_LINKMONITOR_HPP
+#define __LIBS101_LINKMONITOR_HPP
+
+#include <cstddef>
+#include <vector>
+
+//SimianIgnore
+
+namespace libs101
+{
+    /**
+     * Supervises the health of any number of S101 connections with a single timer.
+     * Each connection owns a Link which is attached to the monitor and notified
+     * whenever data has been received. If a connection has been idle for the probe
+     * interval, the handler is asked to send a keep-alive request. If it stays idle
+     * until the timeout elapses, the handler is told that the peer is dead.
+     *
+     * The deadlines are kept in a timer wheel whose size exceeds the timeout, so
+     * attaching, detaching and notifying a link as well as advancing the monitor by
+     * one tick take constant time, independent of the number of links. A link is
+     * only examined when its deadline is reached; received data merely updates its
+     * timestamp, unless the peer has been probed before.
+     *
+     * The handler passed to tick() and advance() must provide the methods
+     * probe(ObjectType*) and expire(ObjectType*). A link is detached before expire
+     * is called. Both methods may attach, detach or destroy any link.
+     * @note The time is measured in ticks, their length is chosen by the user.
+     */
+    template<typename ObjectType>
+    class LinkMonitor
+    {
+        struct Node
+        {
+            Node* previous;
+            Node* next;
+        };
+
+        public:
+            typedef ObjectType object_type;
+            typedef std::size_t size_type;
+
+            /**
+             * Represents a single supervised connection. A link detaches itself
+             * when it is destroyed.
+             */
+            class Link : private Node
+            {
+                friend class LinkMonitor;
+                public:
+                    /**
+                     * Constructor, initializes a link which is not attached.
+                     * @param object The object passed to the handler.
+                     */
+                    explicit Link(object_type* object);
+
+                    /** Destructor, detaches the link. */
+                    ~Link();
+
+                    /**
+                     * Returns the object passed to the handler.
+                     * @return The object passed to the handler.
+                     */
+                    object_type* object() const;
+
+                    /**
+                     * Returns true if the link is attached to a monitor.
+                     * @return true if the link is attached to a monitor.
+                     */
+                    bool isAttached() const;
+
+                    /**
+                     * Returns true if a keep-alive request has been sent and no
+                     * data has been received since.
+                     * @return true if the peer has been probed.
+                     */
+                    bool isProbed() const;
+
+                    /**
+                     * Returns the tick at which data has been received most recently.
+                     * @return The tick at which data has been received most recently.
+                     */
+                    size_type lastReceived() const;
+
+                    /**
+                     * Records that data has been received from the peer. Any kind
+                     * of message, including a keep-alive response, proves that the
+                     * peer is alive.
+                     */
+                    void notifyReceived();
+
+                private:
+                    /** Prohibit copy */
+                    Link(Link const&);
+
+                    /** Prohibit assignment */
+                    Link& operator=(Link const&);
+
+                private:
+                    object_type *const m_object;
+                    LinkMonitor* m_monitor;
+                    size_type m_lastReceived;
+                    bool m_isProbed;
+            };
+
+        public:
+            /**
+             * Constructor.
+             * @param probeInterval The number of idle ticks after which a keep-alive
+             *      request is sent.
+             * @param timeout The number of idle ticks after which a peer is
+             *      considered dead.
+             */
+            LinkMonitor(size_type probeInterval, size_type timeout);
+
+            /** Destructor, detaches all links. */
+            ~LinkMonitor();
+
+            /**
+             * Returns the current tick.
+             * @return The current tick.
+             */
+            size_type now() const;
+
+            /**
+             * Returns the probe interval, in ticks.
+             * @return The probe interval.
+             */
+            size_type probeInterval() const;
+
+            /**
+             * Returns the timeout, in ticks.
+             * @return The timeout.
+             */
+            size_type timeout() const;
+
+            /**
+             * Returns the number of attached links.
+             * @return The number of attached links.
+             */
+            size_type size() const;
+
+            /**
+             * Attaches a link and treats it as if data had just been received.
+             * If the link is already attached, it is detached first.
+             * @param link The link to attach.
+             */
+            void attach(Link& link);
+
+            /**
+             * Detaches a link. Does nothing if the link is not attached to
+             * this monitor.
+             * @param link The link to detach.
+             */
+            void detach(Link& link);
+
+            /**
+             * Advances the monitor by a single tick and processes the links
+             * whose deadline has been reached.
+             * @param handler The handler that probes or drops the connections.
+             */
+            template<typename HandlerType>
+            void tick(HandlerType& handler);
+
+            /**
+             * Advances the monitor to the specified tick. If more ticks than
+             * fit into the wheel have elapsed, only a single revolution is
+             * processed, which is sufficient to visit all links.
+             * @param now The current tick.
+             * @param handler The handler that probes or drops the connections.
+             */
+            template<typename HandlerType>
+            void advance(size_type now, HandlerType& handler);
+
+        private:
+            /** Prohibit copy */
+            LinkMonitor(LinkMonitor const&);
+
+            /** Prohibit assignment */
+            LinkMonitor& operator=(LinkMonitor const&);
+
+            /**
+             * Returns the smallest power of two which is greater than the
+             * largest delay that can be scheduled.
+             * @param probeInterval The probe interval.
+             * @param timeout The timeout.
+             * @return The number of wheel slots.
+             */
+            static size_type wheelSize(size_type probeInterval, size_type timeout);
+
+            /**
+             * Returns the tick at which a link has to be examined next.
+             * @param link The link to examine.
+             * @return The tick at which the next probe or the timeout is due.
+             */
+            size_type deadline(Link const& link) const;
+
+            /**
+             * Initializes an empty list.
+             * @param node The list head.
+             */
+            static void clear(Node& node);
+
+            /**
+             * Inserts a node at the end of a list.
+             * @param head The list head.
+             * @param node The node to insert.
+             */
+            static void insert(Node& head, Node& node);
+
+            /**
+             * Removes a node from the list it is part of.
+             * @param node The node to remove.
+             */
+            static void remove(Node& node);
+
+            /**
+             * Inserts a link into the slot of the specified deadline.
+             * @param link The link to schedule.
+             * @param deadline The tick at which the link has to be examined.
+             */
+            void schedule(Link& link, size_type deadline);
+
+        private:
+            std::vector<Node> m_wheel;
+            Node m_expired;
+            size_type m_mask;
+            size_type m_now;
+            size_type m_probeInterval;
+            size_type m_timeout;
+            size_type m_size;
+    };
+
+    /**************************************************************************/
+    /* Mandatory inline implementation                                        */
+    /**************************************************************************/
+
+    template<typename ObjectType>
+    inline LinkMonitor<ObjectType>::Link::Link(object_type* object)
+        : m_object(object)
+        , m_monitor(0)
+        , m_lastReceived(0)
+        , m_isProbed(false)
+    {
+        LinkMonitor::clear(*this);
+    }
+
+    template<typename ObjectType>
+    inline LinkMonitor<ObjectType>::Link::~Link()
+    {
+        if (m_monitor != 0)
+            m_monitor->detach(*this);
+    }
+
+    template<typename ObjectType>
+    inline typename LinkMonitor<ObjectType>::object_type* LinkMonitor<ObjectType>::Link::object() const
+    {
+        return m_object;
+    }
+
+    template<typename ObjectType>
+    inline bool LinkMonitor<ObjectType>::Link::isAttached() const
+    {
+        return m_monitor != 0;
+    }
+
+    template<typename ObjectType>
+    inline bool LinkMonitor<ObjectType>::Link::isProbed() const
+    {
+        return m_isProbed;
+    }
+
+    template<typename ObjectType>
+    inline typename LinkMonitor<ObjectType>::size_type LinkMonitor<ObjectType>::Link::lastReceived() const
+    {
+        return m_lastReceived;
+    }
+
+    template<typename ObjectType>
+    inline void LinkMonitor<ObjectType>::Link::notifyReceived()
+    {
+        if (m_monitor != 0)
+        {
+            m_lastReceived = m_monitor->m_now;
+
+            // The pending deadline is the timeout, which is later than the next probe.
+            if (m_isProbed)
+            {
+                m_isProbed = false;
+                m_monitor->schedule(*this, m_monitor->deadline(*this));
+            }
+        }
+    }
+
+    template<typename ObjectType>
+    inline LinkMonitor<ObjectType>::LinkMonitor(size_type probeInterval, size_type timeout)
+        : m_wheel(wheelSize(probeInterval, timeout))
+        , m_mask(m_wheel.size() - 1)
+        , m_now(0)
+        , m_probeInterval(probeInterval > 0 ? probeInterval : 1)
+        , m_timeout(timeout > 0 ? timeout : 1)
+        , m_size(0)
+    {
+        clear(m_expired);
+
+        for (size_type index = 0; index < m_wheel.size(); ++index)
+            clear(m_wheel[index]);
+    }
+
+    template<typename ObjectType>
+    inline LinkMonitor<ObjectType>::~LinkMonitor()
+    {
+        for (size_type index = 0; index < m_wheel.size(); ++index)
+        {
+            Node& head = m_wheel[index];
+
+            while (head.next != &head)
+                detach(static_cast<Link&>(*head.next));
+        }
+    }
+
+    template<typename ObjectType>
+    inline typename LinkMonitor<ObjectType>::size_type LinkMonitor<ObjectType>::now() const
+    {
+        return m_now;
+    }
+
+    template<typename ObjectType>
+    inline typename LinkMonitor<ObjectType>::size_type LinkMonitor<ObjectType>::probeInterval() const
+    {
+        return m_probeInterval;
+    }
+
+    template<typename ObjectType>
+    inline typename LinkMonitor<ObjectType>::size_type LinkMonitor<ObjectType>::timeout() const
+    {
+        return m_timeout;
+    }
+
+    template<typename ObjectType>
+    inline typename LinkMonitor<ObjectType>::size_type LinkMonitor<ObjectType>::size() const
+    {
+        return m_size;
+    }
+
+    template<typename ObjectType>
+    inline void LinkMonitor<ObjectType>::attach(Link& link)
+    {
+        if (link.m_monitor != 0)
+            link.m_monitor->detach(link);
+
+        link.m_monitor = this;
+        link.m_lastReceived = m_now;
+        link.m_isProbed = false;
+        ++m_size;
+
+        schedule(link, deadline(link));
+    }
+
+    template<typename ObjectType>
+    inline void LinkMonitor<ObjectType>::detach(Link& link)
+    {
+        if (link.m_monitor == this)
+        {
+            remove(link);
+            link.m_monitor = 0;
+            --m_size;
+        }
+    }
+
+    template<typename ObjectType>
+    template<typename HandlerType>
+    inline void LinkMonitor<ObjectType>::tick(HandlerType& handler)
+    {
+        ++m_now;
+
+        Node& slot = m_wheel[m_now & m_mask];
+
+        if (slot.next == &slot)
+            return;
+
+        // Move the slot to a separate list, so that links which are rescheduled
+        // into the same slot are not visited twice. The handler may destroy
+        // links still waiting in this list, which unlink themselves.
+        m_expired.next = slot.next;
+        m_expired.previous = slot.previous;
+        m_expired.next->previous = &m_expired;
+        m_expired.previous->next = &m_expired;
+        clear(slot);
+
+        while (m_expired.next != &m_expired)
+        {
+            Link& link = static_cast<Link&>(*m_expired.next);
+            size_type const idle = m_now - link.m_lastReceived;
+
+            if (idle >= m_timeout)
+            {
+                detach(link);
+                handler.expire(link.m_object);
+            }
+            else if (idle >= m_probeInterval && link.m_isProbed == false)
+            {
+                link.m_isProbed = true;
+                schedule(link, deadline(link));
+                handler.probe(link.m_object);
+            }
+            else
+            {
+                schedule(link, deadline(link));
+            }
+        }
+    }
+
+    template<typename ObjectType>
+    template<typename HandlerType>
+    inline void LinkMonitor<ObjectType>::advance(size_type now, HandlerType& handler)
+    {
+        if (now - m_now > m_wheel.size())
+            m_now = now - m_wheel.size();
+
+        while (m_now != now)
+            tick(handler);
+    }
+
+    template<typename ObjectType>
+    inline typename LinkMonitor<ObjectType>::size_type LinkMonitor<ObjectType>::wheelSize(size_type probeInterval, size_type timeout)
+    {
+        size_type const delay = probeInterval > timeout ? probeInterval : timeout;
+        size_type size = 2;
+
+        while (size <= delay)
+            size <<= 1;
+
+        return size;
+    }
+
+    template<typename ObjectType>
+    inline typename LinkMonitor<ObjectType>::size_type LinkMonitor<ObjectType>::deadline(Link const& link) const
+    {
+        bool const isProbeDue = link.m_isProbed == false && m_probeInterval < m_timeout;
+        return link.m_lastReceived + (isProbeDue ? m_probeInterval : m_timeout);
+    }
+
+    template<typename ObjectType>
+    inline void LinkMonitor<ObjectType>::clear(Node& node)
+    {
+        node.previous = &node;
+        node.next = &node;
+    }
+
+    template<typename ObjectType>
+    inline void LinkMonitor<ObjectType>::insert(Node& head, Node& node)
+    {
+        node.previous = head.previous;
+        node.next = &head;
+        head.previous->next = &node;
+        head.previous = &node;
+    }
+
+    template<typename ObjectType>
+    inline void LinkMonitor<ObjectType>::remove(Node& node)
+    {
+        node.previous->next = node.next;
+        node.next->previous = node.previous;
+        clear(node);
+    }
+
+    template<typename ObjectType>
+    inline void LinkMonitor<ObjectType>::schedule(Link& link, size_type deadline)
+    {
+        remove(link);
+        insert(m_wheel[deadline & m_mask], link);
+    }
+}
+
+//EndSimianIgnore
+
+#endif  // __LIBS101_LINKMONITOR_HPP
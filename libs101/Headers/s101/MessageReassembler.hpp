@@ -0,0 +1,320 @@
+/*
+    libs101 -- C++ 03 implementation of the S101 encoding and decoding
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __LIBS101_MESSAGEREASSEMBLER_HPP
+#define __LIBS101_MESSAGEREASSEMBLER_HPP
+
+#include <cstddef>
+#include <iterator>
+#include "CommandType.hpp"
+#include "MessageType.hpp"
+#include "PackageFlag.hpp"
+
+//SimianIgnore
+
+namespace libs101
+{
+    /**
+     * Parses the header of decoded S101 frames and reassembles EmBER messages
+     * which have been split into several packages. The payload of each package
+     * is passed to a sink as soon as it arrives, so the complete message is
+     * never collected in a single buffer. The sink must provide the methods
+     * reset(), which is called when a new message starts, and
+     * read(first, last), which receives the payload fragments in order. Both
+     * requirements are met by libember's dom::AsyncDomReader.
+     */
+    template<typename ValueType = unsigned char>
+    class MessageReassembler
+    {
+        public:
+            typedef ValueType value_type;
+            typedef std::size_t size_type;
+
+            /**
+             * Enumerates the possible outcomes of reading a single frame.
+             */
+            enum Result
+            {
+                /** The payload has been passed to the sink, more packages will follow. */
+                Fragment,
+
+                /** The last package of a message has been passed to the sink. */
+                Complete,
+
+                /** The frame contains a keep-alive request which should be answered. */
+                KeepAliveRequest,
+
+                /** The frame contains a keep-alive response. */
+                KeepAliveResponse,
+
+                /** The frame contains a provider state or another command without payload. */
+                Command,
+
+                /** The package doesn't belong to a message that is currently being received. */
+                OutOfSequence,
+
+                /** The message exceeds the configured maximum length and is being discarded. */
+                Overflow,
+
+                /** The frame is too short or not an EmBER message. */
+                Invalid
+            };
+
+            /**
+             * The header fields of the frame that has been read most recently.
+             */
+            struct Header
+            {
+                value_type slot;
+                value_type message;
+                value_type command;
+                value_type version;
+                value_type flags;
+                value_type dtd;
+                value_type appBytesCount;
+                value_type appBytes[255];
+            };
+
+        public:
+            /**
+             * Constructor, initializes a reassembler that is not receiving a message.
+             * @param maximumMessageLength The maximum number of payload bytes a single
+             *      message may have. Messages exceeding this limit are discarded.
+             *      Pass 0 to accept messages of any length.
+             */
+            explicit MessageReassembler(size_type maximumMessageLength = 0);
+
+            /**
+             * Reads a single decoded S101 frame, as delivered by the StreamDecoder.
+             * If the frame contains an EmBER package, its payload is passed to
+             * @p sink.
+             * @param first First byte of the decoded frame.
+             * @param last Points one past the last byte of the decoded frame.
+             * @param sink The sink which receives the payload of the message.
+             * @return The outcome of reading the frame.
+             */
+            template<typename InputIterator, typename SinkType>
+            Result read(InputIterator first, InputIterator last, SinkType& sink);
+
+            /**
+             * Returns the header of the frame that has been read most recently.
+             * @return The header of the frame that has been read most recently.
+             */
+            Header const& header() const;
+
+            /**
+             * Returns the number of payload bytes of the current message that
+             * have been passed to the sink so far.
+             * @return The number of payload bytes received for the current message.
+             */
+            size_type messageLength() const;
+
+            /**
+             * Returns the maximum message length.
+             * @return The maximum message length, or 0 if the length is unlimited.
+             */
+            size_type maximumMessageLength() const;
+
+            /**
+             * Sets the maximum message length. The new limit applies to the
+             * message currently being received as well.
+             * @param value The maximum message length, or 0 for no limit.
+             */
+            void setMaximumMessageLength(size_type value);
+
+            /**
+             * Returns true if the first package of a message has been read and
+             * the last package is still outstanding.
+             * @return true if a message is currently being received.
+             */
+            bool isReceiving() const;
+
+            /**
+             * Abandons the message currently being received.
+             */
+            void reset();
+
+        private:
+            /**
+             * Enumerates the sequencing states.
+             */
+            enum State
+            {
+                Idle,
+                Receiving,
+                Discarding
+            };
+
+            /**
+             * Reads the next header byte.
+             * @param first The current position within the frame, advanced on success.
+             * @param last The end of the frame.
+             * @param value Receives the header byte.
+             * @return false if the frame ended prematurely.
+             */
+            template<typename InputIterator>
+            static bool next(InputIterator& first, InputIterator last, value_type& value);
+
+        private:
+            Header m_header;
+            State m_state;
+            size_type m_messageLength;
+            size_type m_maximumMessageLength;
+    };
+
+    /**************************************************************************/
+    /* Mandatory inline implementation                                        */
+    /**************************************************************************/
+
+    template<typename ValueType>
+    inline MessageReassembler<ValueType>::MessageReassembler(size_type maximumMessageLength)
+        : m_state(Idle)
+        , m_messageLength(0)
+        , m_maximumMessageLength(maximumMessageLength)
+    {
+        m_header.slot = 0;
+        m_header.message = 0;
+        m_header.command = 0;
+        m_header.version = 0;
+        m_header.flags = 0;
+        m_header.dtd = 0;
+        m_header.appBytesCount = 0;
+    }
+
+    template<typename ValueType>
+    inline typename MessageReassembler<ValueType>::Header const& MessageReassembler<ValueType>::header() const
+    {
+        return m_header;
+    }
+
+    template<typename ValueType>
+    inline typename MessageReassembler<ValueType>::size_type MessageReassembler<ValueType>::messageLength() const
+    {
+        return m_messageLength;
+    }
+
+    template<typename ValueType>
+    inline typename MessageReassembler<ValueType>::size_type MessageReassembler<ValueType>::maximumMessageLength() const
+    {
+        return m_maximumMessageLength;
+    }
+
+    template<typename ValueType>
+    inline void MessageReassembler<ValueType>::setMaximumMessageLength(size_type value)
+    {
+        m_maximumMessageLength = value;
+    }
+
+    template<typename ValueType>
+    inline bool MessageReassembler<ValueType>::isReceiving() const
+    {
+        return m_state == Receiving;
+    }
+
+    template<typename ValueType>
+    inline void MessageReassembler<ValueType>::reset()
+    {
+        m_state = Idle;
+        m_messageLength = 0;
+    }
+
+    template<typename ValueType>
+    template<typename InputIterator>
+    inline bool MessageReassembler<ValueType>::next(InputIterator& first, InputIterator last, value_type& value)
+    {
+        if (first == last)
+            return false;
+
+        value = static_cast<value_type>(*first);
+        ++first;
+        return true;
+    }
+
+    template<typename ValueType>
+    template<typename InputIterator, typename SinkType>
+    inline typename MessageReassembler<ValueType>::Result MessageReassembler<ValueType>::read(InputIterator first, InputIterator last, SinkType& sink)
+    {
+        Header& header = m_header;
+
+        if (!next(first, last, header.slot) || !next(first, last, header.message))
+            return Invalid;
+
+        if (header.message != MessageType::EmBER)
+            return Invalid;
+
+        if (!next(first, last, header.command) || !next(first, last, header.version))
+            return Invalid;
+
+        switch (header.command)
+        {
+            case CommandType::EmBER:
+                break;
+
+            case CommandType::KeepAliveRequest:
+                return KeepAliveRequest;
+
+            case CommandType::KeepAliveResponse:
+                return KeepAliveResponse;
+
+            default:
+                return Command;
+        }
+
+        if (!next(first, last, header.flags) || !next(first, last, header.dtd) || !next(first, last, header.appBytesCount))
+            return Invalid;
+
+        for (size_type index = 0; index < header.appBytesCount; ++index)
+        {
+            if (!next(first, last, header.appBytes[index]))
+                return Invalid;
+        }
+
+        if (header.flags & PackageFlag::FirstPackage)
+        {
+            m_state = Receiving;
+            m_messageLength = 0;
+            sink.reset();
+        }
+
+        bool const isLastPackage = (header.flags & PackageFlag::LastPackage) != 0;
+
+        if (m_state != Receiving)
+        {
+            Result const result = m_state == Discarding ? Overflow : OutOfSequence;
+
+            if (isLastPackage)
+                reset();
+
+            return result;
+        }
+
+        size_type const length = static_cast<size_type>(std::distance(first, last));
+
+        if (m_maximumMessageLength != 0
+        && (m_messageLength > m_maximumMessageLength || length > m_maximumMessageLength - m_messageLength))
+        {
+            m_state = isLastPackage ? Idle : Discarding;
+            m_messageLength = 0;
+            return Overflow;
+        }
+
+        m_messageLength += length;
+
+        if (isLastPackage)
+            m_state = Idle;
+
+        if (first != last)
+            sink.read(first, last);
+
+        return isLastPackage ? Complete : Fragment;
+    }
+}
+
+//EndSimianIgnore
+
+#endif  // __LIBS101_MESSAGEREASSEMBLER_HPP
@@ -17,7 +17,12 @@
 #include "Byte.hpp"
 #include "CommandType.hpp"
 #include "Dtd.hpp"
+#include "FramingNegotiation.hpp"
+#include "KeepAliveFrame.hpp"
+#include "LinkMonitor.hpp"
+#include "MessageReassembler.hpp"
 #include "MessageType.hpp"
+#include "ScatterEncoder.hpp"
 #include "StreamDecoder.hpp"
 #include "StreamEncoder.hpp"
 #include "StreamEncoderWithoutEscaping.hpp"
@@ -0,0 +1,445 @@
+/*
+    libs101 -- C++ 03 implementation of the S101 encoding and decoding
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __LIBS101_SCATTERENCODER_HPP
+#define __LIBS101_SCATTERENCODER_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include "Byte.hpp"
+#include "util/ByteScan.hpp"
+#include "util/Crc16.hpp"
+
+//SimianIgnore
+
+namespace libs101
+{
+    /**
+     * Encodes a S101 message into a list of segments that can be passed to a
+     * gather write (e.g. writev) without assembling the frame in a single
+     * buffer first. Both the segment list and the byte buffer that receives
+     * the frame header, escape sequences and crc trailer are owned by the
+     * caller. Runs of payload bytes which need no escaping and are passed as
+     * a contiguous block are not copied at all, the corresponding segment
+     * refers to the input buffer instead. Such input buffers must therefore
+     * stay valid until the segments have been written.
+     */
+    template<typename ValueType = unsigned char>
+    class ScatterEncoder
+    {
+        public:
+            typedef ValueType value_type;
+            typedef value_type* pointer;
+            typedef value_type const* const_pointer;
+            typedef std::size_t size_type;
+
+            /**
+             * Describes a contiguous range of encoded bytes. The layout
+             * corresponds to the one of struct iovec.
+             */
+            struct Segment
+            {
+                const_pointer data;
+                size_type size;
+            };
+
+            typedef Segment const* const_iterator;
+
+            /**
+             * Constructor, initializes the encoder with the storage it writes to.
+             * @param segments The array that receives the segment list.
+             * @param segmentCapacity The number of entries @p segments provides.
+             *      If the list runs out of entries, the remaining payload
+             *      is copied to @p buffer instead of being referenced.
+             * @param buffer The buffer that receives all bytes that cannot be
+             *      referenced in place.
+             * @param bufferCapacity The size of @p buffer. Use
+             *      maximumBufferLength() to determine a size that is
+             *      sufficient for any payload of a given length.
+             */
+            ScatterEncoder(Segment* segments, size_type segmentCapacity, pointer buffer, size_type bufferCapacity);
+
+            /**
+             * Returns the buffer size that is sufficient to encode a payload
+             * of the specified length, even if every byte requires escaping
+             * and no run can be referenced in place.
+             * @param payloadLength The number of payload bytes.
+             * @return The worst case number of buffer bytes needed.
+             */
+            static size_type maximumBufferLength(size_type payloadLength);
+
+            /**
+             * Returns the number of segments in use.
+             * @return The number of segments in use.
+             */
+            size_type size() const;
+
+            /**
+             * Returns the total number of encoded bytes, summed up over all segments.
+             * @return The total number of encoded bytes.
+             */
+            size_type length() const;
+
+            /**
+             * Returns the first segment.
+             * @return The first segment.
+             */
+            const_iterator begin() const;
+
+            /**
+             * Returns a pointer one past the last segment in use.
+             * @return A pointer one past the last segment in use.
+             */
+            const_iterator end() const;
+
+            /**
+             * Encodes a single byte.
+             * @param input The byte to encode.
+             */
+            void encode(value_type input);
+
+            /**
+             * Encodes n bytes. The bytes are copied to the buffer.
+             * @param first First item to encode.
+             * @param last Last item to encode.
+             */
+            template<typename InputIterator>
+            void encode(InputIterator first, InputIterator last);
+
+            /**
+             * Encodes a contiguous block of bytes. Runs which don't need to be
+             * escaped are referenced in place if they are long enough to be
+             * worth a segment of their own.
+             * @param first Pointer to the first byte to encode.
+             * @param last Points one past the last byte to encode.
+             */
+            void encode(const_pointer first, const_pointer last);
+
+            /**
+             * Encodes a contiguous, mutable block of bytes. Forwards to the
+             * overload for constant buffers, which would otherwise lose against
+             * the generic iterator overload during overload resolution.
+             * @param first Pointer to the first byte to encode.
+             * @param last Points one past the last byte to encode.
+             */
+            void encode(pointer first, pointer last);
+
+            /**
+             * Appends the crc and the EoF byte. After calling this method, the
+             * segments may be transmitted.
+             */
+            void finish();
+
+            /**
+             * Resets the encoder so that the segment list and the buffer can be
+             * reused for the next message.
+             */
+            void reset();
+
+            /**
+             * Returns true if the encoded package is complete and ready to be transmitted.
+             * @return true if the packet is valid, false if finish still has to be called.
+             */
+            bool isFinished() const;
+
+            /**
+             * Returns true if the buffer was too small to hold the encoded
+             * message. The segments of an overflowed message are incomplete
+             * and must not be transmitted.
+             * @return true if bytes have been dropped because the buffer was full.
+             */
+            bool isOverflowed() const;
+
+        private:
+            /**
+             * Runs shorter than this are copied to the buffer, as the cost of an
+             * additional segment outweighs the copy.
+             */
+            enum { MinimumReferenceLength = 32 };
+
+            /**
+             * Writes the BoF byte if the frame has not been started yet.
+             */
+            void start();
+
+            /**
+             * Escapes a single byte if necessary and writes it to the buffer.
+             * @param input The byte to write.
+             */
+            void append(value_type input);
+
+            /**
+             * Writes a single byte to the buffer, extending the current buffer
+             * segment or opening a new one.
+             * @param input The byte to write.
+             */
+            void write(value_type input);
+
+            /**
+             * Writes a run of bytes which don't require escaping, either by
+             * referencing it or by copying it to the buffer.
+             * @param first Pointer to the first byte of the run.
+             * @param last Points one past the last byte of the run.
+             */
+            void write(const_pointer first, const_pointer last);
+
+        private:
+            Segment* m_segments;
+            size_type m_segmentCapacity;
+            size_type m_segmentCount;
+            pointer m_buffer;
+            size_type m_bufferCapacity;
+            size_type m_bufferLength;
+            util::Crc16::value_type m_crc;
+            bool m_isTailInBuffer;
+            bool m_isStarted;
+            bool m_isFinished;
+            bool m_isOverflowed;
+    };
+
+    /**************************************************************************/
+    /* Mandatory inline implementation                                        */
+    /**************************************************************************/
+
+    template<typename ValueType>
+    inline ScatterEncoder<ValueType>::ScatterEncoder(Segment* segments, size_type segmentCapacity, pointer buffer, size_type bufferCapacity)
+        : m_segments(segments)
+        , m_segmentCapacity(segmentCapacity)
+        , m_segmentCount(0)
+        , m_buffer(buffer)
+        , m_bufferCapacity(bufferCapacity)
+        , m_bufferLength(0)
+        , m_crc(0xFFFF)
+        , m_isTailInBuffer(false)
+        , m_isStarted(false)
+        , m_isFinished(false)
+        , m_isOverflowed(false)
+    {}
+
+    template<typename ValueType>
+    inline typename ScatterEncoder<ValueType>::size_type ScatterEncoder<ValueType>::maximumBufferLength(size_type payloadLength)
+    {
+        // BoF, the escaped payload, two escaped crc bytes and EoF
+        return 1 + 2 * payloadLength + 4 + 1;
+    }
+
+    template<typename ValueType>
+    inline typename ScatterEncoder<ValueType>::size_type ScatterEncoder<ValueType>::size() const
+    {
+        return m_segmentCount;
+    }
+
+    template<typename ValueType>
+    inline typename ScatterEncoder<ValueType>::size_type ScatterEncoder<ValueType>::length() const
+    {
+        size_type result = 0;
+        for (size_type index = 0; index < m_segmentCount; ++index)
+            result += m_segments[index].size;
+
+        return result;
+    }
+
+    template<typename ValueType>
+    inline typename ScatterEncoder<ValueType>::const_iterator ScatterEncoder<ValueType>::begin() const
+    {
+        return m_segments;
+    }
+
+    template<typename ValueType>
+    inline typename ScatterEncoder<ValueType>::const_iterator ScatterEncoder<ValueType>::end() const
+    {
+        return m_segments + m_segmentCount;
+    }
+
+    template<typename ValueType>
+    inline bool ScatterEncoder<ValueType>::isFinished() const
+    {
+        return m_isFinished;
+    }
+
+    template<typename ValueType>
+    inline bool ScatterEncoder<ValueType>::isOverflowed() const
+    {
+        return m_isOverflowed;
+    }
+
+    template<typename ValueType>
+    inline void ScatterEncoder<ValueType>::reset()
+    {
+        m_segmentCount = 0;
+        m_bufferLength = 0;
+        m_crc = 0xFFFF;
+        m_isTailInBuffer = false;
+        m_isStarted = false;
+        m_isFinished = false;
+        m_isOverflowed = false;
+    }
+
+    template<typename ValueType>
+    inline void ScatterEncoder<ValueType>::finish()
+    {
+        if (m_isFinished == false)
+        {
+            start();
+
+            util::Crc16::value_type const crc = ~m_crc;
+
+            append(static_cast<value_type>((crc >> 0) & 0xFF));
+            append(static_cast<value_type>((crc >> 8) & 0xFF));
+
+            write(Byte::EoF);
+            m_isFinished = true;
+        }
+    }
+
+    template<typename ValueType>
+    inline void ScatterEncoder<ValueType>::encode(value_type input)
+    {
+        start();
+
+        m_crc = util::Crc16::add(m_crc, input);
+        append(input);
+    }
+
+    template<typename ValueType>
+    template<typename InputIterator>
+    inline void ScatterEncoder<ValueType>::encode(InputIterator first, InputIterator last)
+    {
+        for(; first != last; ++first)
+            encode(*first);
+    }
+
+    template<typename ValueType>
+    inline void ScatterEncoder<ValueType>::encode(pointer first, pointer last)
+    {
+        encode(const_pointer(first), const_pointer(last));
+    }
+
+    template<typename ValueType>
+    inline void ScatterEncoder<ValueType>::encode(const_pointer first, const_pointer last)
+    {
+        if (first == last)
+            return;
+
+        start();
+
+        m_crc = util::Crc16::add(m_crc, first, last);
+
+        while (first != last)
+        {
+            const_pointer const stop = util::ByteScan::findAtLeast(first, last, Byte::Invalid);
+
+            write(first, stop);
+
+            if (stop != last)
+            {
+                write(Byte::CE);
+                write(static_cast<value_type>(*stop ^ Byte::XOR));
+                first = stop + 1;
+            }
+            else
+            {
+                first = stop;
+            }
+        }
+    }
+
+    template<typename ValueType>
+    inline void ScatterEncoder<ValueType>::start()
+    {
+        if (m_isStarted == false)
+        {
+            m_isStarted = true;
+            m_crc = 0xFFFF;
+            write(Byte::BoF);
+        }
+    }
+
+    template<typename ValueType>
+    inline void ScatterEncoder<ValueType>::append(value_type input)
+    {
+        if (input >= Byte::Invalid)
+        {
+            write(Byte::CE);
+            write(static_cast<value_type>(input ^ Byte::XOR));
+        }
+        else
+        {
+            write(input);
+        }
+    }
+
+    template<typename ValueType>
+    inline void ScatterEncoder<ValueType>::write(value_type input)
+    {
+        if (m_bufferLength == m_bufferCapacity)
+        {
+            m_isOverflowed = true;
+            return;
+        }
+
+        pointer const target = m_buffer + m_bufferLength;
+
+        if (m_isTailInBuffer)
+        {
+            ++m_segments[m_segmentCount - 1].size;
+        }
+        else if (m_segmentCount < m_segmentCapacity)
+        {
+            m_segments[m_segmentCount].data = target;
+            m_segments[m_segmentCount].size = 1;
+            ++m_segmentCount;
+            m_isTailInBuffer = true;
+        }
+        else
+        {
+            m_isOverflowed = true;
+            return;
+        }
+
+        *target = input;
+        ++m_bufferLength;
+    }
+
+    template<typename ValueType>
+    inline void ScatterEncoder<ValueType>::write(const_pointer first, const_pointer last)
+    {
+        size_type const length = static_cast<size_type>(last - first);
+
+        // A referenced run needs its own segment plus one for the bytes
+        // that follow it in the buffer.
+        if (length >= MinimumReferenceLength && m_segmentCount + 2 <= m_segmentCapacity)
+        {
+            m_segments[m_segmentCount].data = first;
+            m_segments[m_segmentCount].size = length;
+            ++m_segmentCount;
+            m_isTailInBuffer = false;
+        }
+        else if (length > 0)
+        {
+            if (m_bufferCapacity - m_bufferLength < length)
+            {
+                m_isOverflowed = true;
+                return;
+            }
+
+            write(*first);
+
+            if (m_isOverflowed == false)
+            {
+                std::copy(first + 1, last, m_buffer + m_bufferLength);
+                m_segments[m_segmentCount - 1].size += length - 1;
+                m_bufferLength += length - 1;
+            }
+        }
+    }
+}
+
+//EndSimianIgnore
+
+#endif  // __LIBS101_SCATTERENCODER_HPP
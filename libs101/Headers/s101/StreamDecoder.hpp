@@ -9,8 +9,10 @@
 #ifndef __LIBS101_STREAMDECODER_HPP
 #define __LIBS101_STREAMDECODER_HPP
 
+#include <algorithm>
 #include <vector>
 #include "Byte.hpp"
+#include "util/ByteScan.hpp"
 #include "util/Crc16.hpp"
 
 //SimianIgnore
@@ -81,6 +83,85 @@ namespace libs101
         template<typename InputIterator, typename CallbackType>
         void read(InputIterator first, InputIterator last, CallbackType callback);
 
+        /**
+         * Reads a contiguous block of bytes. Instead of running each byte
+         * through the state machine, this overload scans for the next byte
+         * that has a special meaning in the current state and appends the
+         * escape-free run in front of it as a whole. The messages passed to
+         * the callback are identical to those produced by readByte().
+         * @param first Pointer to the first byte of the buffer to decode.
+         * @param last Points one past the last byte of the buffer to decode.
+         * @param callback Callback function that will be called when a valid
+         *      message has been decoded. The function must have the following
+         *      signature: bool (const_iterator, const_iterator, StateType)
+         * @param state A user state that can be used to transfer any
+         *      kind of data to the callback function.
+         * @note Each time a message has been decoded this method calls reset.
+         */
+        template<typename CallbackType, typename StateType>
+        void read(const_pointer first, const_pointer last, CallbackType callback, StateType state);
+
+        /**
+         * Reads a contiguous block of bytes. See the stateful overload for
+         * details.
+         * @param first Pointer to the first byte of the buffer to decode.
+         * @param last Points one past the last byte of the buffer to decode.
+         * @param callback Callback function that will be called when a valid
+         *      message has been decoded. The function must have the following
+         *      signature: bool (const_iterator, const_iterator)
+         * @note Each time a message has been decoded this method calls reset.
+         */
+        template<typename CallbackType>
+        void read(const_pointer first, const_pointer last, CallbackType callback);
+
+        /**
+         * Reads a contiguous, mutable block of bytes. Forwards to the overload
+         * for constant buffers, which would otherwise lose against the generic
+         * iterator overload during overload resolution.
+         * @param first Pointer to the first byte of the buffer to decode.
+         * @param last Points one past the last byte of the buffer to decode.
+         * @param callback Callback function that will be called when a valid
+         *      message has been decoded.
+         * @param state A user state that can be used to transfer any
+         *      kind of data to the callback function.
+         */
+        template<typename CallbackType, typename StateType>
+        void read(pointer first, pointer last, CallbackType callback, StateType state);
+
+        /**
+         * Reads a contiguous, mutable block of bytes. See the stateful
+         * overload for details.
+         * @param first Pointer to the first byte of the buffer to decode.
+         * @param last Points one past the last byte of the buffer to decode.
+         * @param callback Callback function that will be called when a valid
+         *      message has been decoded.
+         */
+        template<typename CallbackType>
+        void read(pointer first, pointer last, CallbackType callback);
+
+        /**
+         * Reads a contiguous block of bytes and delivers the decoded messages
+         * without copying them whenever possible. If a frame is completely
+         * contained in the input buffer and its payload does not contain any
+         * escaped bytes, the callback receives a range that points directly
+         * into the input buffer. Escaped bytes within the crc do not prevent
+         * this. The same applies to frames without escaping whose declared
+         * payload is completely contained in the input buffer. All other
+         * frames are collected in the internal buffer, which keeps its
+         * capacity across messages, and are delivered from there.
+         * @param first Pointer to the first byte of the buffer to decode.
+         * @param last Points one past the last byte of the buffer to decode.
+         * @param callback Callback function that will be called when a valid
+         *      message has been decoded. The function must have the following
+         *      signature: void (const_pointer, const_pointer, StateType)
+         * @param state A user state that can be used to transfer any
+         *      kind of data to the callback function.
+         * @note The range passed to the callback is only valid while the
+         *      callback is being invoked.
+         */
+        template<typename CallbackType, typename StateType>
+        void readInPlace(const_pointer first, const_pointer last, CallbackType callback, StateType state);
+
         /**
          * Decodes a single byte. If this is the last byte of a S101 message
          * the provided callback function will be invoked.
@@ -137,6 +218,87 @@ namespace libs101
         template<typename CallbackType>
         static void invokeStatelessCallback(const_iterator first, const_iterator last, CallbackType callback);
 
+        /**
+         * Binds a callback expecting pointers and its user state to the
+         * decoder whose internal buffer is passed to the callback.
+         */
+        template<typename CallbackType, typename StateType>
+        struct InPlaceBinding
+        {
+            InPlaceBinding(StreamDecoder const* decoder, CallbackType callback, StateType state)
+                : decoder(decoder)
+                , callback(callback)
+                , state(state)
+            {}
+
+            StreamDecoder const* decoder;
+            CallbackType callback;
+            StateType state;
+        };
+
+        /**
+         * Translates a message decoded into the internal buffer to a pointer
+         * range and forwards it to the bound callback.
+         * @param first Start of the buffer containing a decoded S101 message.
+         * @param last End of the buffer.
+         * @param binding The callback and user state to forward the message to.
+         */
+        template<typename BindingType>
+        static void invokeInPlaceCallback(const_iterator first, const_iterator last, BindingType* binding);
+
+        /**
+         * Decodes a single run of bytes: the bytes up to the next byte having
+         * a special meaning in the current state are consumed as a whole,
+         * the special byte itself is passed to readByte().
+         * @param first Pointer to the first byte of the buffer to decode.
+         * @param last Points one past the last byte of the buffer to decode.
+         * @param callback Callback to pass to readByte().
+         * @param state User state to pass to readByte().
+         * @return Pointer to the first byte that has not been consumed.
+         */
+        template<typename CallbackType, typename StateType>
+        const_pointer readRun(const_pointer first, const_pointer last, CallbackType callback, StateType state);
+
+        /**
+         * Tries to decode the escaped frame starting at the BoF byte @p first
+         * without copying it.
+         * @param first Pointer to the BoF byte of the frame.
+         * @param last Points one past the last byte of the input buffer.
+         * @param callback Callback function that receives the decoded message.
+         * @param state User state to pass to the callback.
+         * @return Pointer to the first byte following the frame, or 0 if the
+         *      frame is incomplete or requires unescaping and has to be
+         *      decoded by using the internal buffer.
+         */
+        template<typename CallbackType, typename StateType>
+        const_pointer readFrameInPlace(const_pointer first, const_pointer last, CallbackType callback, StateType state);
+
+        /**
+         * Tries to decode the frame without escaping starting at the Invalid
+         * byte @p first without copying it.
+         * @param first Pointer to the Invalid byte that starts the frame.
+         * @param last Points one past the last byte of the input buffer.
+         * @param callback Callback function that receives the decoded message.
+         * @param state User state to pass to the callback.
+         * @return Pointer to the first byte following the frame, or 0 if the
+         *      declared payload is not completely contained in the buffer.
+         */
+        template<typename CallbackType, typename StateType>
+        const_pointer readFrameWithoutEscapingInPlace(const_pointer first, const_pointer last, CallbackType callback, StateType state);
+
+        /**
+         * Appends the payload of a frame without escaping. Once the length
+         * has been decoded, all remaining payload bytes available in the
+         * buffer are appended at once.
+         * @param first Pointer to the first byte of the buffer to decode.
+         * @param last Points one past the last byte of the buffer to decode.
+         * @param callback Callback function that receives the decoded message.
+         * @param state User state to pass to the callback.
+         * @return Pointer to the first byte that has not been consumed.
+         */
+        template<typename CallbackType, typename StateType>
+        const_pointer readRunWithoutEscaping(const_pointer first, const_pointer last, CallbackType callback, StateType state);
+
         ByteVector m_bytes;
         bool m_escape;
         State m_state;
@@ -214,6 +376,234 @@ namespace libs101
             readByte(*first, callback);
     }
 
+    template<typename ValueType>
+    template<typename CallbackType, typename StateType>
+    inline void StreamDecoder<ValueType>::read(const_pointer first, const_pointer last, CallbackType callback, StateType state)
+    {
+        while (first != last)
+            first = readRun(first, last, callback, state);
+    }
+
+    template<typename ValueType>
+    template<typename CallbackType>
+    inline void StreamDecoder<ValueType>::read(const_pointer first, const_pointer last, CallbackType callback)
+    {
+        typedef void (*CallbackBindType)(const_iterator, const_iterator, CallbackType);
+
+        CallbackBindType const bind = &StreamDecoder::template invokeStatelessCallback<CallbackType>;
+        read(first, last, bind, callback);
+    }
+
+    template<typename ValueType>
+    template<typename CallbackType, typename StateType>
+    inline void StreamDecoder<ValueType>::read(pointer first, pointer last, CallbackType callback, StateType state)
+    {
+        read(const_pointer(first), const_pointer(last), callback, state);
+    }
+
+    template<typename ValueType>
+    template<typename CallbackType>
+    inline void StreamDecoder<ValueType>::read(pointer first, pointer last, CallbackType callback)
+    {
+        read(const_pointer(first), const_pointer(last), callback);
+    }
+
+    template<typename ValueType>
+    template<typename CallbackType, typename StateType>
+    inline void StreamDecoder<ValueType>::readInPlace(const_pointer first, const_pointer last, CallbackType callback, StateType state)
+    {
+        typedef InPlaceBinding<CallbackType, StateType> BindingType;
+        typedef void (*CallbackBindType)(const_iterator, const_iterator, BindingType*);
+
+        BindingType binding(this, callback, state);
+        CallbackBindType const bind = &StreamDecoder::template invokeInPlaceCallback<BindingType>;
+
+        while (first != last)
+        {
+            if (m_state == OutOfFrame)
+            {
+                first = util::ByteScan::findAtLeast(first, last, Byte::Invalid);
+
+                if (first != last && (*first == Byte::BoF || *first == Byte::Invalid))
+                {
+                    const_pointer const next = *first == Byte::BoF
+                        ? readFrameInPlace(first, last, callback, state)
+                        : readFrameWithoutEscapingInPlace(first, last, callback, state);
+
+                    if (next != 0)
+                    {
+                        first = next;
+                        continue;
+                    }
+                }
+
+                if (first == last)
+                    break;
+            }
+
+            first = readRun(first, last, bind, &binding);
+        }
+    }
+
+    template<typename ValueType>
+    template<typename CallbackType, typename StateType>
+    inline typename StreamDecoder<ValueType>::const_pointer StreamDecoder<ValueType>::readRun(const_pointer first, const_pointer last, CallbackType callback, StateType state)
+    {
+        if (m_state == OutOfFrame)
+        {
+            first = util::ByteScan::findAtLeast(first, last, Byte::Invalid);
+        }
+        else if (m_state == WithinFrameWithEscaping && m_escape == false)
+        {
+            const_pointer const stop = util::ByteScan::findAtLeast(first, last, Byte::CE);
+
+            if (first != stop)
+            {
+                m_bytes.insert(m_bytes.end(), first, stop);
+                m_crc = util::Crc16::add(m_crc, first, stop);
+                first = stop;
+            }
+        }
+        else if (m_state == WithinFrameWithoutEscaping)
+        {
+            return readRunWithoutEscaping(first, last, callback, state);
+        }
+
+        if (first != last)
+        {
+            readByte(*first, callback, state);
+            ++first;
+        }
+
+        return first;
+    }
+
+    template<typename ValueType>
+    template<typename CallbackType, typename StateType>
+    inline typename StreamDecoder<ValueType>::const_pointer StreamDecoder<ValueType>::readFrameInPlace(const_pointer first, const_pointer last, CallbackType callback, StateType state)
+    {
+        const_pointer const payload = first + 1;
+        const_pointer const stop = util::ByteScan::findAtLeast(payload, last, Byte::CE);
+
+        if (stop == last)
+            return 0;
+
+        if (*stop == Byte::BoF)
+            return stop;
+
+        // Collect the bytes following the unescaped run. The payload can only
+        // be delivered in place if these belong to the crc, i.e. if there are
+        // at most two of them.
+        value_type trailer[2];
+        size_type trailerLength = 0;
+        bool escape = false;
+        const_pointer cursor = stop;
+
+        for(; cursor != last && *cursor != Byte::EoF; ++cursor)
+        {
+            value_type const byte = *cursor;
+
+            if (byte == Byte::BoF || trailerLength == 2 || (byte == Byte::CE && escape))
+                return 0;
+
+            if (byte == Byte::CE)
+            {
+                escape = true;
+            }
+            else
+            {
+                trailer[trailerLength++] = static_cast<value_type>(escape ? (byte ^ Byte::XOR) : byte);
+                escape = false;
+            }
+        }
+
+        size_type const runLength = static_cast<size_type>(stop - payload);
+
+        if (cursor == last || escape || runLength + trailerLength < 2)
+        {
+            if (cursor != last && escape == false)
+                return cursor + 1;
+
+            return 0;
+        }
+
+        util::Crc16::value_type crc = util::Crc16::add(util::Crc16::value_type(0xFFFFU), payload, stop);
+        crc = util::Crc16::add(crc, trailer, trailer + trailerLength);
+
+        if (crc == 0xF0B8)
+            callback(payload, stop - (2 - trailerLength), state);
+
+        return cursor + 1;
+    }
+
+    template<typename ValueType>
+    template<typename CallbackType, typename StateType>
+    inline typename StreamDecoder<ValueType>::const_pointer StreamDecoder<ValueType>::readFrameWithoutEscapingInPlace(const_pointer first, const_pointer last, CallbackType callback, StateType state)
+    {
+        size_type const available = static_cast<size_type>(last - first);
+
+        if (available < 2)
+            return 0;
+
+        size_type const payloadLengthLength = first[1] & 0x07;
+
+        if (available < 2 + payloadLengthLength)
+            return 0;
+
+        const_pointer const payload = first + 2 + payloadLengthLength;
+        size_type payloadLength = 0;
+
+        for (const_pointer cursor = first + 2; cursor != payload; ++cursor)
+            payloadLength = (payloadLength << 8) | *cursor;
+
+        if (static_cast<size_type>(last - payload) < payloadLength)
+            return 0;
+
+        // Report the frame type to callbacks querying isDecodingFrameWithoutEscaping().
+        m_state = WithinFrameWithoutEscaping;
+        callback(payload, payload + payloadLength, state);
+        m_state = OutOfFrame;
+
+        return payload + payloadLength;
+    }
+
+    template<typename ValueType>
+    template<typename CallbackType, typename StateType>
+    inline typename StreamDecoder<ValueType>::const_pointer StreamDecoder<ValueType>::readRunWithoutEscaping(const_pointer first, const_pointer last, CallbackType callback, StateType state)
+    {
+        size_type const headerLength = 1 + m_payloadLengthLength;
+        size_type const length = m_bytes.size();
+
+        if (length == 0 || length < headerLength)
+        {
+            readByte(*first, callback, state);
+            return first + 1;
+        }
+
+        size_type const missing = headerLength + m_payloadLength - length;
+        size_type const count = std::min(missing, static_cast<size_type>(last - first));
+
+        m_bytes.insert(m_bytes.end(), first, first + count);
+
+        if (count == missing)
+        {
+            callback(m_bytes.begin() + headerLength, m_bytes.end(), state);
+            reset();
+        }
+
+        return first + count;
+    }
+
+    template<typename ValueType>
+    template<typename BindingType>
+    inline void StreamDecoder<ValueType>::invokeInPlaceCallback(const_iterator first, const_iterator last, BindingType* binding)
+    {
+        ByteVector const& bytes = binding->decoder->m_bytes;
+        const_pointer const base = bytes.empty() ? 0 : &bytes[0];
+
+        binding->callback(base + (first - bytes.begin()), base + (last - bytes.begin()), binding->state);
+    }
+
     template<typename ValueType>
     template<typename InputType, typename CallbackType>
     inline void StreamDecoder<ValueType>::readByte(InputType input, CallbackType callback)
@@ -290,14 +680,10 @@ namespace libs101
                 m_payloadLength = 0;
 
                 for (size_type index = 0; index < m_payloadLengthLength; ++index)
-                {
-                    int const shift = (m_payloadLength - index - 1) * 8;
-
-                    m_payloadLength |= (m_bytes[1 + index] << shift);
-                }
+                    m_payloadLength = (m_payloadLength << 8) | m_bytes[1 + index];
             }
 
-            if (length >= 1 && length - (1 + m_payloadLengthLength) == m_payloadLength)
+            if (length >= 1 + m_payloadLengthLength && length - (1 + m_payloadLengthLength) == m_payloadLength)
             {
                 callback(m_bytes.begin() + (1 + m_payloadLengthLength), m_bytes.end(), state);
                 reset();
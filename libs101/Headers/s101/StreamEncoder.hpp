@@ -9,8 +9,10 @@
 #ifndef __LIBS101_STREAMENCODER_HPP
 #define __LIBS101_STREAMENCODER_HPP
 
+#include <algorithm>
 #include <vector>
 #include "Byte.hpp"
+#include "util/ByteScan.hpp"
 #include "util/Crc16.hpp"
 
 //SimianIgnore
@@ -72,6 +74,27 @@ namespace libs101
             template<typename InputIterator>
             void encode(InputIterator first, InputIterator last);
 
+            /**
+             * Encodes a contiguous block of bytes. If the buffer cannot hold the
+             * worst case of every byte requiring an escape sequence, it is grown
+             * to at least twice its capacity, so that encoding a message in
+             * chunks does not copy the buffer for every chunk. The crc is
+             * computed for the whole block and runs of bytes that need no
+             * escaping are copied at once.
+             * @param first Pointer to the first byte to encode.
+             * @param last Points one past the last byte to encode.
+             */
+            void encode(const_pointer first, const_pointer last);
+
+            /**
+             * Encodes a contiguous, mutable block of bytes. Forwards to the
+             * overload for constant buffers, which would otherwise lose against
+             * the generic iterator overload during overload resolution.
+             * @param first Pointer to the first byte to encode.
+             * @param last Points one past the last byte to encode.
+             */
+            void encode(pointer first, pointer last);
+
             /**
              * Appends the crc and the EoF byte to the buffer. After calling
              * this method, the packet may be transmitted.
@@ -108,10 +131,11 @@ namespace libs101
 
     template<typename ValueType>
     inline StreamEncoder<ValueType>::StreamEncoder(size_type capacity)
-        : m_bytes(capacity)
-        , m_crc(0xFFFF)
+        : m_crc(0xFFFF)
         , m_isFinished(false)
-    {}
+    {
+        m_bytes.reserve(capacity);
+    }
 
     template<typename ValueType>
     inline bool StreamEncoder<ValueType>::isFinished() const
@@ -182,6 +206,49 @@ namespace libs101
             encode(*first);
     }
 
+    template<typename ValueType>
+    inline void StreamEncoder<ValueType>::encode(pointer first, pointer last)
+    {
+        encode(const_pointer(first), const_pointer(last));
+    }
+
+    template<typename ValueType>
+    inline void StreamEncoder<ValueType>::encode(const_pointer first, const_pointer last)
+    {
+        if (first == last)
+            return;
+
+        if (m_bytes.empty())
+        {
+            m_crc = 0xFFFF;
+            m_bytes.push_back(Byte::BoF);
+        }
+
+        m_crc = util::Crc16::add(m_crc, first, last);
+
+        size_type const required = m_bytes.size() + 2 * static_cast<size_type>(last - first);
+        if (m_bytes.capacity() < required)
+            m_bytes.reserve(std::max(2 * m_bytes.capacity(), required));
+
+        while (first != last)
+        {
+            const_pointer const stop = util::ByteScan::findAtLeast(first, last, Byte::Invalid);
+
+            m_bytes.insert(m_bytes.end(), first, stop);
+
+            if (stop != last)
+            {
+                m_bytes.push_back(Byte::CE);
+                m_bytes.push_back(*stop ^ Byte::XOR);
+                first = stop + 1;
+            }
+            else
+            {
+                first = stop;
+            }
+        }
+    }
+
     template<typename ValueType>
     inline void StreamEncoder<ValueType>::append(value_type input)
     {
@@ -107,9 +107,9 @@ namespace libs101
 
     template<typename ValueType>
     inline StreamEncoderWithoutEscaping<ValueType>::StreamEncoderWithoutEscaping(size_type capacity)
-        : m_bytes(capacity)
-        , m_isFinished(false)
+        : m_isFinished(false)
     {
+        m_bytes.reserve(capacity);
     }
 
     template<typename ValueType>
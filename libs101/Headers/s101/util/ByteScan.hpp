@@ -0,0 +1,114 @@
+/*
+    libs101 -- C++ 03 implementation of the S101 encoding and decoding
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __LIBS101_UTIL_BYTESCAN_HPP
+#define __LIBS101_UTIL_BYTESCAN_HPP
+
+#include "Simd.hpp"
+
+namespace libs101 { namespace util
+{
+    /**
+     * Static class providing fast scans for the bytes that have a special meaning
+     * within the S101 framing. All of them (BoF, EoF, CE and the escape-requiring
+     * range) are located at the upper end of the value range, so a single
+     * "greater or equal" comparison is sufficient to find them.
+     */
+    class ByteScan
+    {
+        public:
+            /**
+             * Returns the first position within the range [first, last) whose
+             * value is greater than or equal to @p threshold.
+             * @param first The first item of the buffer to scan.
+             * @param last Points one past the last item of the buffer to scan.
+             * @param threshold The smallest value to stop at.
+             * @return The position of the first matching item, or last if the
+             *      range does not contain such an item.
+             */
+            template<typename InputIterator>
+            static InputIterator findAtLeast(InputIterator first, InputIterator last, unsigned char threshold);
+
+            /**
+             * Overload for contiguous byte buffers, which examines 16 bytes per
+             * iteration if the target supports SSE2.
+             * @param first The first byte of the buffer to scan.
+             * @param last Points one past the last byte of the buffer to scan.
+             * @param threshold The smallest value to stop at.
+             * @return The position of the first matching byte, or last if the
+             *      range does not contain such a byte.
+             */
+            static unsigned char const* findAtLeast(unsigned char const* first, unsigned char const* last, unsigned char threshold);
+
+        private:
+#ifdef LIBS101_HAS_SSE2
+            /**
+             * Returns the index of the least significant bit set in @p mask.
+             * @param mask A non-zero bit mask.
+             * @return The index of the least significant bit set.
+             */
+            static unsigned int lowestBit(unsigned int mask);
+#endif
+    };
+
+    /******************************************************/
+    /* Inline implementation                              */
+    /******************************************************/
+
+    template<typename InputIterator>
+    inline InputIterator ByteScan::findAtLeast(InputIterator first, InputIterator last, unsigned char threshold)
+    {
+        for(; first != last; ++first)
+        {
+            if (static_cast<unsigned char>(*first) >= threshold)
+                break;
+        }
+
+        return first;
+    }
+
+    inline unsigned char const* ByteScan::findAtLeast(unsigned char const* first, unsigned char const* last, unsigned char threshold)
+    {
+#ifdef LIBS101_HAS_SSE2
+        __m128i const limit = _mm_set1_epi8(static_cast<char>(threshold));
+
+        for(; last - first >= 16; first += 16)
+        {
+            __m128i const block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(first));
+            __m128i const match = _mm_cmpeq_epi8(_mm_max_epu8(block, limit), block);
+            unsigned int const mask = static_cast<unsigned int>(_mm_movemask_epi8(match));
+
+            if (mask != 0)
+                return first + lowestBit(mask);
+        }
+#endif
+        for(; first != last; ++first)
+        {
+            if (*first >= threshold)
+                break;
+        }
+
+        return first;
+    }
+
+#ifdef LIBS101_HAS_SSE2
+    inline unsigned int ByteScan::lowestBit(unsigned int mask)
+    {
+#  if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return static_cast<unsigned int>(index);
+#  else
+        return static_cast<unsigned int>(__builtin_ctz(mask));
+#  endif
+    }
+#endif
+}
+}
+
+#endif  // __LIBS101_UTIL_BYTESCAN_HPP
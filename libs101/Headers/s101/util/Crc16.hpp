@@ -9,6 +9,9 @@
 #ifndef __LIBS101_UTIL_CRC16_HPP
 #define __LIBS101_UTIL_CRC16_HPP
 
+#include <cstddef>
+#include "Simd.hpp"
+
 namespace libs101 { namespace util
 {
     /**
@@ -41,7 +44,83 @@ namespace libs101 { namespace util
             template<typename InputIterator>
             static value_type add(value_type crc, InputIterator first, InputIterator last);
 
+            /**
+             * Computes the crc for a contiguous byte buffer. Short buffers
+             * are processed eight bytes at a time (slicing-by-8), larger ones
+             * are folded with carry-less multiplications if the processor
+             * supports them.
+             * @param crc The current crc value.
+             * @param first The first byte of the buffer to compute the crc from.
+             * @param last Points one past the last byte of the buffer.
+             * @return Returns the new crc.
+             */
+            static value_type add(value_type crc, unsigned char const* first, unsigned char const* last);
+
+            /**
+             * Computes the crc for a contiguous byte buffer by using the
+             * portable slicing-by-8 algorithm.
+             * @param crc The current crc value.
+             * @param first The first byte of the buffer to compute the crc from.
+             * @param last Points one past the last byte of the buffer.
+             * @return Returns the new crc.
+             */
+            static value_type addSliced(value_type crc, unsigned char const* first, unsigned char const* last);
+
+#ifdef LIBS101_HAS_PCLMUL
+            /**
+             * Computes the crc for a contiguous byte buffer by folding 64 bytes
+             * per iteration with carry-less multiplications. The caller must
+             * ensure that Cpu::hasCarrylessMultiply() returns true.
+             * @param crc The current crc value.
+             * @param first The first byte of the buffer to compute the crc from.
+             * @param last Points one past the last byte of the buffer. The
+             *      buffer must contain at least 64 bytes.
+             * @return Returns the new crc.
+             */
+            LIBS101_TARGET_PCLMUL
+            static value_type addFolded(value_type crc, unsigned char const* first, unsigned char const* last);
+#endif
+
         private:
+            /**
+             * Buffers shorter than this are not worth the setup of the
+             * carry-less folding.
+             */
+            enum { FoldingThreshold = 128 };
+
+            /**
+             * The lookup tables used by the slicing-by-8 algorithm. The first
+             * table is the classic byte-wise table, table n contains the crc
+             * of a single byte followed by n zero bytes.
+             */
+            struct SlicingTables
+            {
+                SlicingTables();
+
+                value_type entries[8][256];
+                bool initialized;
+            };
+
+            /**
+             * Holds the slicing tables. They are a static member of a class template
+             * so that they can be defined in this header, and they are computed
+             * during static initialization, before any thread that could race on
+             * them has been started. Until then, e.g. in the constructors of other
+             * static objects, the tables are not initialized and addSliced falls
+             * back to the byte-wise table.
+             */
+            template<typename Tag>
+            struct SlicingTablesInstance
+            {
+                static SlicingTables const tables;
+            };
+
+            /**
+             * Returns the slicing tables computed during static initialization.
+             * @return The slicing-by-8 lookup tables.
+             */
+            static SlicingTables const& slicingTables();
+
             /**
              * Returns the crc value at the specified index.
              * @param index Index within the crc table.
@@ -71,6 +150,137 @@ namespace libs101 { namespace util
         return crc;
     }
 
+    inline Crc16::value_type Crc16::add(value_type crc, unsigned char const* first, unsigned char const* last)
+    {
+#ifdef LIBS101_HAS_PCLMUL
+        if (last - first >= FoldingThreshold && Cpu::hasCarrylessMultiply())
+            return addFolded(crc, first, last);
+#endif
+        return addSliced(crc, first, last);
+    }
+
+    inline Crc16::value_type Crc16::addSliced(value_type crc, unsigned char const* first, unsigned char const* last)
+    {
+        SlicingTables const& tables = slicingTables();
+        if (tables.initialized == false)
+        {
+            for(; first != last; ++first)
+            {
+                crc = add(crc, *first);
+            }
+
+            return crc;
+        }
+
+        value_type const (*table)[256] = tables.entries;
+
+        for(; last - first >= 8; first += 8)
+        {
+            unsigned int const low = (crc ^ first[0]) & 0xFF;
+            unsigned int const high = ((crc >> 8) ^ first[1]) & 0xFF;
+
+            crc = table[7][low] ^ table[6][high]
+                ^ table[5][first[2]] ^ table[4][first[3]]
+                ^ table[3][first[4]] ^ table[2][first[5]]
+                ^ table[1][first[6]] ^ table[0][first[7]];
+        }
+
+        for(; first != last; ++first)
+        {
+            crc = 0xFFFF & ((crc >> 8) ^ table[0][(crc ^ *first) & 0xFF]);
+        }
+
+        return crc;
+    }
+
+#ifdef LIBS101_HAS_PCLMUL
+    LIBS101_TARGET_PCLMUL
+    inline Crc16::value_type Crc16::addFolded(value_type crc, unsigned char const* first, unsigned char const* last)
+    {
+        /*
+         * The data is loaded in its natural (bit-reflected) order, so the low
+         * quadword of a register holds the higher order coefficients. Folding a
+         * register A over a distance of n bits computes A_low * (x^(n+63) mod P)
+         * xor A_high * (x^(n-1) mod P), which is congruent to A * x^n. The
+         * exponents are reduced by one because the carry-less product of two
+         * reflected operands is shifted by one bit. All constants are reflected
+         * into the upper 16 bits of a 64 bit lane.
+         */
+        __m128i const fold512 = _mm_set_epi32(static_cast<int>(0x7F900000U), 0, static_cast<int>(0x98220000U), 0);
+        __m128i const fold384 = _mm_set_epi32(static_cast<int>(0x8F660000U), 0, static_cast<int>(0x51590000U), 0);
+        __m128i const fold256 = _mm_set_epi32(static_cast<int>(0x20F30000U), 0, static_cast<int>(0xAAC80000U), 0);
+        __m128i const fold128 = _mm_set_epi32(static_cast<int>(0x7EEA0000U), 0, static_cast<int>(0xA95D0000U), 0);
+
+        __m128i x0 = _mm_loadu_si128(reinterpret_cast<__m128i const*>(first + 0));
+        __m128i x1 = _mm_loadu_si128(reinterpret_cast<__m128i const*>(first + 16));
+        __m128i x2 = _mm_loadu_si128(reinterpret_cast<__m128i const*>(first + 32));
+        __m128i x3 = _mm_loadu_si128(reinterpret_cast<__m128i const*>(first + 48));
+
+        x0 = _mm_xor_si128(x0, _mm_cvtsi32_si128(crc));
+        first += 64;
+
+        for(; last - first >= 64; first += 64)
+        {
+            x0 = _mm_xor_si128(
+                _mm_xor_si128(_mm_clmulepi64_si128(x0, fold512, 0x00), _mm_clmulepi64_si128(x0, fold512, 0x11)),
+                _mm_loadu_si128(reinterpret_cast<__m128i const*>(first + 0)));
+            x1 = _mm_xor_si128(
+                _mm_xor_si128(_mm_clmulepi64_si128(x1, fold512, 0x00), _mm_clmulepi64_si128(x1, fold512, 0x11)),
+                _mm_loadu_si128(reinterpret_cast<__m128i const*>(first + 16)));
+            x2 = _mm_xor_si128(
+                _mm_xor_si128(_mm_clmulepi64_si128(x2, fold512, 0x00), _mm_clmulepi64_si128(x2, fold512, 0x11)),
+                _mm_loadu_si128(reinterpret_cast<__m128i const*>(first + 32)));
+            x3 = _mm_xor_si128(
+                _mm_xor_si128(_mm_clmulepi64_si128(x3, fold512, 0x00), _mm_clmulepi64_si128(x3, fold512, 0x11)),
+                _mm_loadu_si128(reinterpret_cast<__m128i const*>(first + 48)));
+        }
+
+        x3 = _mm_xor_si128(x3, _mm_xor_si128(_mm_clmulepi64_si128(x0, fold384, 0x00), _mm_clmulepi64_si128(x0, fold384, 0x11)));
+        x3 = _mm_xor_si128(x3, _mm_xor_si128(_mm_clmulepi64_si128(x1, fold256, 0x00), _mm_clmulepi64_si128(x1, fold256, 0x11)));
+        x3 = _mm_xor_si128(x3, _mm_xor_si128(_mm_clmulepi64_si128(x2, fold128, 0x00), _mm_clmulepi64_si128(x2, fold128, 0x11)));
+
+        for(; last - first >= 16; first += 16)
+        {
+            x3 = _mm_xor_si128(
+                _mm_xor_si128(_mm_clmulepi64_si128(x3, fold128, 0x00), _mm_clmulepi64_si128(x3, fold128, 0x11)),
+                _mm_loadu_si128(reinterpret_cast<__m128i const*>(first)));
+        }
+
+        unsigned char remainder[16];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(remainder), x3);
+
+        crc = addSliced(0, remainder, remainder + 16);
+        return addSliced(crc, first, last);
+    }
+#endif
+
+    inline Crc16::SlicingTables::SlicingTables()
+    {
+        for(int index = 0; index < 256; ++index)
+        {
+            entries[0][index] = crcvalue(index);
+        }
+
+        for(int slice = 1; slice < 8; ++slice)
+        {
+            for(int index = 0; index < 256; ++index)
+            {
+                value_type const previous = entries[slice - 1][index];
+                entries[slice][index] = 0xFFFF & ((previous >> 8) ^ entries[0][previous & 0xFF]);
+            }
+        }
+
+        initialized = true;
+    }
+
+    template<typename Tag>
+    Crc16::SlicingTables const Crc16::SlicingTablesInstance<Tag>::tables;
+
+    inline Crc16::SlicingTables const& Crc16::slicingTables()
+    {
+        return SlicingTablesInstance<void>::tables;
+    }
+
     inline Crc16::value_type Crc16::crcvalue(int index)
     {
         static value_type const crc[256] = 
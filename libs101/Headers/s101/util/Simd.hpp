@@ -0,0 +1,106 @@
+/*
+    libs101 -- C++ 03 implementation of the S101 encoding and decoding
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __LIBS101_UTIL_SIMD_HPP
+#define __LIBS101_UTIL_SIMD_HPP
+
+/*
+ * Detection of the vector instruction sets used by the block oriented
+ * framing code. SSE2 is part of every x86-64 target and is selected at
+ * compile time. The carry-less multiplication (PCLMULQDQ) is not, so code
+ * using it is compiled with a function level target attribute and only
+ * invoked if Cpu::hasCarrylessMultiply() reports support at runtime.
+ * Define LIBS101_NO_SIMD to force the portable implementations.
+ */
+
+#if !defined(LIBS101_NO_SIMD)
+#  if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define LIBS101_HAS_SSE2
+#    include <emmintrin.h>
+#    if defined(_MSC_VER)
+#      include <intrin.h>
+#      define LIBS101_HAS_PCLMUL
+#      define LIBS101_TARGET_PCLMUL
+#    elif defined(__GNUC__) && ((__GNUC__ > 4) || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9) || defined(__clang__))
+#      include <cpuid.h>
+#      include <wmmintrin.h>
+#      define LIBS101_HAS_PCLMUL
+#      define LIBS101_TARGET_PCLMUL __attribute__((target("pclmul")))
+#    endif
+#  endif
+#endif
+
+namespace libs101 { namespace util
+{
+    /**
+     * Static class providing the runtime detection of optional processor features.
+     */
+    class Cpu
+    {
+        public:
+            /**
+             * Returns true if the processor supports the carry-less multiplication
+             * instruction (PCLMULQDQ). The result is determined once during
+             * static initialization, before that false is returned.
+             * @return true if PCLMULQDQ may be used.
+             */
+            static bool hasCarrylessMultiply();
+
+        private:
+            /**
+             * Holds the cached processor query. The flag is a static member of a
+             * class template so that it can be defined in this header, and it is
+             * set during static initialization, before any thread that could race
+             * on it has been started. Code running in the constructors of other
+             * static objects may still see false and use the portable implementations.
+             */
+            template<typename Tag>
+            struct Features
+            {
+                static bool const carrylessMultiply;
+            };
+
+            /**
+             * Queries the processor for PCLMULQDQ support.
+             * @return true if PCLMULQDQ may be used.
+             */
+            static bool queryCarrylessMultiply();
+    };
+
+    /******************************************************/
+    /* Inline implementation                              */
+    /******************************************************/
+
+    template<typename Tag>
+    bool const Cpu::Features<Tag>::carrylessMultiply = Cpu::queryCarrylessMultiply();
+
+    inline bool Cpu::hasCarrylessMultiply()
+    {
+        return Features<void>::carrylessMultiply;
+    }
+
+    inline bool Cpu::queryCarrylessMultiply()
+    {
+#if defined(LIBS101_HAS_PCLMUL) && defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 1);
+        return (info[2] & (1 << 1)) != 0;
+#elif defined(LIBS101_HAS_PCLMUL)
+        unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+        if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) == 0)
+            return false;
+
+        return (ecx & bit_PCLMUL) != 0;
+#else
+        return false;
+#endif
+    }
+}
+}
+
+#endif  // __LIBS101_UTIL_SIMD_HPP
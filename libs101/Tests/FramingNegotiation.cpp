@@ -0,0 +1,184 @@
+/*
+    libs101 -- C++ 03 implementation of the S101 encoding and decoding
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include "s101/S101.hpp"
+
+#define THROW_TEST_EXCEPTION(message)                       \
+            {                                               \
+                std::ostringstream msgStream;               \
+                msgStream << message ;                      \
+                throw std::runtime_error(msgStream.str());  \
+            }
+
+namespace
+{
+    typedef std::vector<unsigned char> Bytes;
+    typedef libs101::StreamDecoder<unsigned char> Decoder;
+
+    /**
+     * A sink for the reassembler which ignores the payload.
+     */
+    struct NullSink
+    {
+        void reset()
+        {}
+
+        template<typename InputIterator>
+        void read(InputIterator, InputIterator)
+        {}
+    };
+
+    /**
+     * Answers keep-alive requests in kind, the way a consumer or provider does.
+     */
+    struct Peer
+    {
+        explicit Peer(bool isWithoutEscapingEnabled)
+            : negotiation(isWithoutEscapingEnabled)
+        {}
+
+        void read(Bytes const& bytes)
+        {
+            decoder.read(bytes.begin(), bytes.end(), &Peer::onFrame, this);
+        }
+
+        static void onFrame(Decoder::const_iterator first, Decoder::const_iterator last, Peer* peer)
+        {
+            peer->negotiation.notify(peer->decoder);
+
+            libs101::MessageReassembler<unsigned char> reassembler;
+            NullSink sink;
+            if (reassembler.read(first, last, sink) == libs101::MessageReassembler<unsigned char>::KeepAliveRequest)
+            {
+                libs101::KeepAliveFrame const& response = libs101::KeepAliveFrame::response(peer->decoder.isDecodingFrameWithoutEscaping());
+                peer->output.assign(response.begin(), response.end());
+            }
+        }
+
+        Decoder decoder;
+        libs101::FramingNegotiation negotiation;
+        Bytes output;
+    };
+
+    Bytes toBytes(libs101::KeepAliveFrame const& frame)
+    {
+        return Bytes(frame.begin(), frame.end());
+    }
+
+    void testKeepAliveFrames()
+    {
+        libs101::StreamEncoder<unsigned char> encoder;
+        libs101::FramingNegotiation::encodeProbe(encoder);
+        if (Bytes(encoder.begin(), encoder.end()) != toBytes(libs101::KeepAliveFrame::request()))
+        {
+            THROW_TEST_EXCEPTION("The probe with escaping differs from the keep-alive request!");
+        }
+
+        libs101::StreamEncoderWithoutEscaping<unsigned char> encoderWithoutEscaping;
+        libs101::FramingNegotiation::encodeProbe(encoderWithoutEscaping);
+        if (Bytes(encoderWithoutEscaping.begin(), encoderWithoutEscaping.end()) != toBytes(libs101::KeepAliveFrame::requestWithoutEscaping()))
+        {
+            THROW_TEST_EXCEPTION("The probe without escaping differs from the keep-alive request!");
+        }
+
+        if (&libs101::KeepAliveFrame::response(false) != &libs101::KeepAliveFrame::response()
+        ||  &libs101::KeepAliveFrame::response(true) != &libs101::KeepAliveFrame::responseWithoutEscaping())
+        {
+            THROW_TEST_EXCEPTION("Unexpected keep-alive response variant!");
+        }
+
+        Bytes const response = toBytes(libs101::KeepAliveFrame::responseWithoutEscaping());
+        if (response.size() != 10 || response[0] != 0xF8 || response[5] != 4 || response[8] != libs101::CommandType::KeepAliveResponse)
+        {
+            THROW_TEST_EXCEPTION("Unexpected keep-alive response without escaping!");
+        }
+    }
+
+    void testNegotiation()
+    {
+        libs101::FramingNegotiation negotiation;
+        if (negotiation.mode() != libs101::FramingNegotiation::WithEscaping || negotiation.isWithoutEscapingEnabled())
+        {
+            THROW_TEST_EXCEPTION("Frames without escaping must be disabled by default!");
+        }
+
+        // Support by the peer alone doesn't change the mode.
+        negotiation.notify(true);
+        if (negotiation.mode() != libs101::FramingNegotiation::WithEscaping || negotiation.isWithoutEscapingSupportedByPeer() == false)
+        {
+            THROW_TEST_EXCEPTION("Unexpected mode while disabled!");
+        }
+
+        negotiation.setWithoutEscapingEnabled(true);
+        if (negotiation.mode() != libs101::FramingNegotiation::WithoutEscaping)
+        {
+            THROW_TEST_EXCEPTION("Unexpected mode after enabling!");
+        }
+
+        // A single frame with escaping doesn't revoke the support.
+        negotiation.notify(false);
+        if (negotiation.mode() != libs101::FramingNegotiation::WithoutEscaping)
+        {
+            THROW_TEST_EXCEPTION("Unexpected mode after a frame with escaping!");
+        }
+
+        negotiation.reset();
+        if (negotiation.mode() != libs101::FramingNegotiation::WithEscaping || negotiation.isWithoutEscapingEnabled() == false)
+        {
+            THROW_TEST_EXCEPTION("Unexpected mode after a reset!");
+        }
+    }
+
+    void testProbe()
+    {
+        Peer provider(false);
+        Peer consumer(true);
+
+        // A request with escaping is answered with escaping.
+        provider.read(toBytes(libs101::KeepAliveFrame::request()));
+        if (provider.output != toBytes(libs101::KeepAliveFrame::response()) || provider.negotiation.isWithoutEscapingSupportedByPeer())
+        {
+            THROW_TEST_EXCEPTION("A request with escaping must be answered with escaping!");
+        }
+
+        // The probe is answered in kind, which tells the consumer that the provider supports the variant.
+        libs101::StreamEncoderWithoutEscaping<unsigned char> probe;
+        libs101::FramingNegotiation::encodeProbe(probe);
+        provider.read(Bytes(probe.begin(), probe.end()));
+        if (provider.output != toBytes(libs101::KeepAliveFrame::responseWithoutEscaping()))
+        {
+            THROW_TEST_EXCEPTION("The probe must be answered without escaping!");
+        }
+
+        consumer.read(provider.output);
+        if (consumer.negotiation.mode() != libs101::FramingNegotiation::WithoutEscaping || consumer.output.empty() == false)
+        {
+            THROW_TEST_EXCEPTION("The consumer didn't detect support for frames without escaping!");
+        }
+    }
+}
+
+int main(int, char const* const*)
+{
+    try
+    {
+        testKeepAliveFrames();
+        testNegotiation();
+        testProbe();
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << "Unexpected exception: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
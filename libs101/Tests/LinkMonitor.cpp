@@ -0,0 +1,280 @@
+/*
+    libs101 -- C++ 03 implementation of the S101 encoding and decoding
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include "s101/LinkMonitor.hpp"
+
+#define THROW_TEST_EXCEPTION(message)                       \
+            {                                               \
+                std::ostringstream msgStream;               \
+                msgStream << message ;                      \
+                throw std::runtime_error(msgStream.str());  \
+            }
+
+namespace
+{
+    /**
+     * A supervised connection.
+     */
+    struct Connection
+    {
+        Connection()
+            : probes(0)
+            , expiredAt(0)
+        {}
+
+        int probes;
+        std::size_t expiredAt;
+    };
+
+    typedef libs101::LinkMonitor<Connection> Monitor;
+
+    /**
+     * Records the probes and timeouts reported by the monitor.
+     */
+    struct Handler
+    {
+        explicit Handler(Monitor const& monitor)
+            : monitor(monitor)
+        {}
+
+        void probe(Connection* connection)
+        {
+            ++connection->probes;
+        }
+
+        void expire(Connection* connection)
+        {
+            connection->expiredAt = monitor.now();
+        }
+
+        Monitor const& monitor;
+    };
+
+    void testProbeAndExpire()
+    {
+        Monitor monitor(4, 12);
+        Handler handler(monitor);
+        Connection connection;
+        Monitor::Link link(&connection);
+        monitor.attach(link);
+
+        monitor.advance(3, handler);
+        if (connection.probes != 0 || link.isProbed())
+        {
+            THROW_TEST_EXCEPTION("The link has been probed too early!");
+        }
+
+        monitor.tick(handler);
+        if (connection.probes != 1 || link.isProbed() == false)
+        {
+            THROW_TEST_EXCEPTION("The link has not been probed after the probe interval!");
+        }
+
+        monitor.advance(11, handler);
+        if (connection.expiredAt != 0 || link.isAttached() == false || connection.probes != 1)
+        {
+            THROW_TEST_EXCEPTION("The link has expired too early or has been probed twice!");
+        }
+
+        monitor.tick(handler);
+        if (connection.expiredAt != 12 || link.isAttached() || monitor.size() != 0)
+        {
+            THROW_TEST_EXCEPTION("The link has not expired after the timeout!");
+        }
+    }
+
+    void testNotify()
+    {
+        Monitor monitor(4, 12);
+        Handler handler(monitor);
+        Connection connection;
+        Monitor::Link link(&connection);
+        monitor.attach(link);
+
+        // Data received before the probe interval postpones the probe.
+        monitor.advance(3, handler);
+        link.notifyReceived();
+        monitor.advance(6, handler);
+        if (connection.probes != 0)
+        {
+            THROW_TEST_EXCEPTION("The link has been probed although data has been received!");
+        }
+
+        monitor.advance(7, handler);
+        if (connection.probes != 1)
+        {
+            THROW_TEST_EXCEPTION("The postponed probe has not been sent!");
+        }
+
+        // A response after the probe reschedules the next probe.
+        monitor.advance(9, handler);
+        link.notifyReceived();
+        if (link.isProbed() || link.lastReceived() != 9)
+        {
+            THROW_TEST_EXCEPTION("Unexpected link state after the response!");
+        }
+
+        monitor.advance(19, handler);
+        if (connection.expiredAt != 0 || connection.probes != 2)
+        {
+            THROW_TEST_EXCEPTION("The link has not been probed again after the response!");
+        }
+
+        monitor.advance(21, handler);
+        if (connection.expiredAt != 21)
+        {
+            THROW_TEST_EXCEPTION("The link has not expired after the second probe!");
+        }
+    }
+
+    void testManyLinks()
+    {
+        Monitor monitor(4, 12);
+        Handler handler(monitor);
+        std::vector<Connection> connections(1000);
+        std::vector<Monitor::Link*> links;
+        for (std::size_t index = 0; index < connections.size(); ++index)
+        {
+            links.push_back(new Monitor::Link(&connections[index]));
+            monitor.attach(*links.back());
+
+            // Spread the links over all slots.
+            if (index % 100 == 99)
+                monitor.tick(handler);
+        }
+
+        if (monitor.size() != connections.size())
+        {
+            THROW_TEST_EXCEPTION("Unexpected number of links!");
+        }
+
+        // Advancing beyond the size of the wheel visits every link once.
+        monitor.advance(1000, handler);
+        for (std::size_t index = 0; index < connections.size(); ++index)
+        {
+            if (connections[index].expiredAt == 0 || links[index]->isAttached())
+            {
+                THROW_TEST_EXCEPTION("Link " << index << " has not expired!");
+            }
+        }
+
+        if (monitor.size() != 0)
+        {
+            THROW_TEST_EXCEPTION("Expired links are still attached!");
+        }
+
+        for (std::size_t index = 0; index < links.size(); ++index)
+            delete links[index];
+    }
+
+    /**
+     * A handler which destroys the links of expired connections, including
+     * the ones of other connections that are due in the same tick.
+     */
+    struct DestroyingHandler
+    {
+        void probe(Connection*)
+        {}
+
+        void expire(Connection* connection)
+        {
+            ++expired;
+            for (std::size_t index = 0; index < links.size(); ++index)
+            {
+                if (links[index] != 0 && (links[index]->object() == connection || index % 2 == 0))
+                {
+                    delete links[index];
+                    links[index] = 0;
+                }
+            }
+        }
+
+        std::vector<Monitor::Link*> links;
+        int expired;
+    };
+
+    void testDestroyingHandler()
+    {
+        Monitor monitor(2, 4);
+        std::vector<Connection> connections(10);
+        DestroyingHandler handler;
+        handler.expired = 0;
+        for (std::size_t index = 0; index < connections.size(); ++index)
+        {
+            handler.links.push_back(new Monitor::Link(&connections[index]));
+            monitor.attach(*handler.links.back());
+        }
+
+        monitor.advance(4, handler);
+        for (std::size_t index = 0; index < handler.links.size(); ++index)
+        {
+            if (handler.links[index] != 0)
+            {
+                THROW_TEST_EXCEPTION("Link " << index << " has not been destroyed!");
+            }
+        }
+
+        if (monitor.size() != 0 || handler.expired == 0 || handler.expired > 10)
+        {
+            THROW_TEST_EXCEPTION("Unexpected number of expired links!");
+        }
+    }
+
+    void testDetach()
+    {
+        Connection connection;
+        Monitor::Link link(&connection);
+        {
+            Monitor monitor(4, 12);
+            Handler handler(monitor);
+            monitor.attach(link);
+            monitor.attach(link);
+            if (monitor.size() != 1)
+            {
+                THROW_TEST_EXCEPTION("Attaching a link twice must not add it twice!");
+            }
+
+            monitor.detach(link);
+            monitor.advance(100, handler);
+            if (connection.probes != 0 || connection.expiredAt != 0 || monitor.size() != 0)
+            {
+                THROW_TEST_EXCEPTION("A detached link has been processed!");
+            }
+
+            monitor.attach(link);
+        }
+
+        // The destructor of the monitor detaches all links.
+        if (link.isAttached())
+        {
+            THROW_TEST_EXCEPTION("The link is still attached to a destroyed monitor!");
+        }
+    }
+}
+
+int main(int, char const* const*)
+{
+    try
+    {
+        testProbeAndExpire();
+        testNotify();
+        testManyLinks();
+        testDestroyingHandler();
+        testDetach();
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << "Unexpected exception: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,250 @@
+/*
+    libs101 -- C++ 03 implementation of the S101 encoding and decoding
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include "s101/S101.hpp"
+
+#define THROW_TEST_EXCEPTION(message)                       \
+            {                                               \
+                std::ostringstream msgStream;               \
+                msgStream << message ;                      \
+                throw std::runtime_error(msgStream.str());  \
+            }
+
+namespace
+{
+    typedef std::vector<unsigned char> Bytes;
+    typedef libs101::MessageReassembler<unsigned char> Reassembler;
+
+    /**
+     * A sink which collects the payload of the current message.
+     */
+    struct Sink
+    {
+        Sink()
+            : resets(0)
+        {}
+
+        void reset()
+        {
+            bytes.clear();
+            ++resets;
+        }
+
+        template<typename InputIterator>
+        void read(InputIterator first, InputIterator last)
+        {
+            bytes.insert(bytes.end(), first, last);
+        }
+
+        Bytes bytes;
+        int resets;
+    };
+
+    /**
+     * Builds a decoded EmBER frame, as it is passed to the reassembler.
+     */
+    Bytes makePackage(unsigned char flags, Bytes const& payload, Bytes const& appBytes = Bytes())
+    {
+        Bytes frame;
+        frame.push_back(0x00);                              // Slot
+        frame.push_back(libs101::MessageType::EmBER);
+        frame.push_back(libs101::CommandType::EmBER);
+        frame.push_back(0x01);                              // Version
+        frame.push_back(flags);
+        frame.push_back(libs101::Dtd::Glow);
+        frame.push_back(static_cast<unsigned char>(appBytes.size()));
+        frame.insert(frame.end(), appBytes.begin(), appBytes.end());
+        frame.insert(frame.end(), payload.begin(), payload.end());
+        return frame;
+    }
+
+    Bytes makeCommand(unsigned char command)
+    {
+        Bytes frame;
+        frame.push_back(0x00);
+        frame.push_back(libs101::MessageType::EmBER);
+        frame.push_back(command);
+        frame.push_back(0x01);
+        return frame;
+    }
+
+    Reassembler::Result read(Reassembler& reassembler, Bytes const& frame, Sink& sink)
+    {
+        return reassembler.read(frame.begin(), frame.end(), sink);
+    }
+
+    void assertResult(Reassembler::Result actual, Reassembler::Result expected, char const* what)
+    {
+        if (actual != expected)
+        {
+            THROW_TEST_EXCEPTION(what << ": expected result " << expected << " but got " << actual << "!");
+        }
+    }
+
+    unsigned char const First = libs101::PackageFlag::FirstPackage;
+    unsigned char const Last = libs101::PackageFlag::LastPackage;
+
+    void testSinglePackage()
+    {
+        Reassembler reassembler;
+        Sink sink;
+        Bytes const payload(100, 0x42);
+        Bytes appBytes;
+        appBytes.push_back(0x28);
+        appBytes.push_back(0x02);
+
+        assertResult(read(reassembler, makePackage(First | Last, payload, appBytes), sink), Reassembler::Complete, "Single package");
+        if (sink.bytes != payload || sink.resets != 1 || reassembler.isReceiving() || reassembler.messageLength() != payload.size())
+        {
+            THROW_TEST_EXCEPTION("Single package: unexpected payload or state!");
+        }
+
+        Reassembler::Header const& header = reassembler.header();
+        if (header.dtd != libs101::Dtd::Glow || header.appBytesCount != 2 || header.appBytes[0] != 0x28 || header.appBytes[1] != 0x02)
+        {
+            THROW_TEST_EXCEPTION("Single package: unexpected header!");
+        }
+    }
+
+    void testMultiplePackages()
+    {
+        Reassembler reassembler;
+        Sink sink;
+        Bytes expected;
+        for (int index = 0; index < 5; ++index)
+        {
+            Bytes const payload(10 + index, static_cast<unsigned char>(index));
+            unsigned char const flags = static_cast<unsigned char>((index == 0 ? First : 0) | (index == 4 ? Last : 0));
+            expected.insert(expected.end(), payload.begin(), payload.end());
+
+            assertResult(read(reassembler, makePackage(flags, payload), sink), index == 4 ? Reassembler::Complete : Reassembler::Fragment, "Multiple packages");
+        }
+
+        if (sink.bytes != expected || sink.resets != 1 || reassembler.messageLength() != expected.size())
+        {
+            THROW_TEST_EXCEPTION("Multiple packages: unexpected payload!");
+        }
+
+        // A new first package restarts the message.
+        assertResult(read(reassembler, makePackage(First, Bytes(3, 1)), sink), Reassembler::Fragment, "Restart");
+        assertResult(read(reassembler, makePackage(First | Last, Bytes(4, 2)), sink), Reassembler::Complete, "Restart");
+        if (sink.bytes != Bytes(4, 2) || sink.resets != 3)
+        {
+            THROW_TEST_EXCEPTION("Restart: unexpected payload!");
+        }
+    }
+
+    void testOutOfSequence()
+    {
+        Reassembler reassembler;
+        Sink sink;
+        assertResult(read(reassembler, makePackage(0, Bytes(3, 1)), sink), Reassembler::OutOfSequence, "Out of sequence");
+        assertResult(read(reassembler, makePackage(Last, Bytes(3, 1)), sink), Reassembler::OutOfSequence, "Out of sequence");
+        if (sink.bytes.empty() == false || sink.resets != 0)
+        {
+            THROW_TEST_EXCEPTION("Out of sequence: the sink has been invoked!");
+        }
+
+        assertResult(read(reassembler, makePackage(First, Bytes(3, 1)), sink), Reassembler::Fragment, "Abandoned message");
+        reassembler.reset();
+        assertResult(read(reassembler, makePackage(Last, Bytes(3, 1)), sink), Reassembler::OutOfSequence, "Abandoned message");
+    }
+
+    void testCommands()
+    {
+        Reassembler reassembler;
+        Sink sink;
+        assertResult(read(reassembler, makeCommand(libs101::CommandType::KeepAliveRequest), sink), Reassembler::KeepAliveRequest, "Keep-alive request");
+        assertResult(read(reassembler, makeCommand(libs101::CommandType::KeepAliveResponse), sink), Reassembler::KeepAliveResponse, "Keep-alive response");
+        assertResult(read(reassembler, makeCommand(libs101::CommandType::ProviderState), sink), Reassembler::Command, "Provider state");
+
+        // Commands don't interrupt a message which is being received.
+        assertResult(read(reassembler, makePackage(First, Bytes(3, 1)), sink), Reassembler::Fragment, "Interleaved command");
+        assertResult(read(reassembler, makeCommand(libs101::CommandType::KeepAliveRequest), sink), Reassembler::KeepAliveRequest, "Interleaved command");
+        assertResult(read(reassembler, makePackage(Last, Bytes(3, 2)), sink), Reassembler::Complete, "Interleaved command");
+        if (sink.bytes.size() != 6)
+        {
+            THROW_TEST_EXCEPTION("Interleaved command: unexpected payload!");
+        }
+    }
+
+    void testInvalid()
+    {
+        Reassembler reassembler;
+        Sink sink;
+        Bytes const package = makePackage(First | Last, Bytes(), Bytes(3, 0));
+
+        // Every truncation of the header is rejected.
+        for (std::size_t length = 0; length < package.size(); ++length)
+        {
+            Bytes const truncated(package.begin(), package.begin() + length);
+            assertResult(read(reassembler, truncated, sink), Reassembler::Invalid, "Truncated header");
+        }
+
+        Bytes other = makePackage(First | Last, Bytes(3, 0));
+        other[1] = 0x0F;
+        assertResult(read(reassembler, other, sink), Reassembler::Invalid, "Other message type");
+
+        assertResult(read(reassembler, package, sink), Reassembler::Complete, "Empty payload");
+        if (sink.bytes.empty() == false || sink.resets != 1)
+        {
+            THROW_TEST_EXCEPTION("Empty payload: unexpected sink state!");
+        }
+    }
+
+    void testOverflow()
+    {
+        Reassembler reassembler(16);
+        Sink sink;
+
+        assertResult(read(reassembler, makePackage(First | Last, Bytes(16, 1)), sink), Reassembler::Complete, "Maximum length");
+        assertResult(read(reassembler, makePackage(First | Last, Bytes(17, 1)), sink), Reassembler::Overflow, "Single package overflow");
+
+        // The remaining packages of an overflowed message are discarded.
+        assertResult(read(reassembler, makePackage(First, Bytes(10, 1)), sink), Reassembler::Fragment, "Overflow");
+        assertResult(read(reassembler, makePackage(0, Bytes(10, 1)), sink), Reassembler::Overflow, "Overflow");
+        assertResult(read(reassembler, makePackage(0, Bytes(1, 1)), sink), Reassembler::Overflow, "Discarding");
+        assertResult(read(reassembler, makePackage(Last, Bytes(1, 1)), sink), Reassembler::Overflow, "Discarding");
+        assertResult(read(reassembler, makePackage(Last, Bytes(1, 1)), sink), Reassembler::OutOfSequence, "After overflow");
+        assertResult(read(reassembler, makePackage(First | Last, Bytes(2, 3)), sink), Reassembler::Complete, "After overflow");
+
+        // Lowering the limit below the number of bytes received so far must not
+        // let the remaining packages through.
+        Reassembler lowered(100);
+        assertResult(read(lowered, makePackage(First, Bytes(50, 1)), sink), Reassembler::Fragment, "Lowered limit");
+        lowered.setMaximumMessageLength(20);
+        assertResult(read(lowered, makePackage(Last, Bytes(1, 1)), sink), Reassembler::Overflow, "Lowered limit");
+
+        // Without a limit, any length is accepted.
+        Reassembler unlimited;
+        assertResult(read(unlimited, makePackage(First | Last, Bytes(100000, 1)), sink), Reassembler::Complete, "Unlimited");
+    }
+}
+
+int main(int, char const* const*)
+{
+    try
+    {
+        testSinglePackage();
+        testMultiplePackages();
+        testOutOfSequence();
+        testCommands();
+        testInvalid();
+        testOverflow();
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << "Unexpected exception: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,241 @@
+/*
+    libs101 -- C++ 03 implementation of the S101 encoding and decoding
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include "s101/S101.hpp"
+
+#define THROW_TEST_EXCEPTION(message)                       \
+            {                                               \
+                std::ostringstream msgStream;               \
+                msgStream << message ;                      \
+                throw std::runtime_error(msgStream.str());  \
+            }
+
+namespace
+{
+    typedef std::vector<unsigned char> Bytes;
+    typedef libs101::StreamDecoder<unsigned char> Decoder;
+
+    /**
+     * A decoded frame, along with the framing variant reported by the decoder.
+     */
+    struct Frame
+    {
+        Frame(Bytes const& payload, bool isWithoutEscaping)
+            : payload(payload)
+            , isWithoutEscaping(isWithoutEscaping)
+        {}
+
+        bool operator==(Frame const& other) const
+        {
+            return payload == other.payload && isWithoutEscaping == other.isWithoutEscaping;
+        }
+
+        Bytes payload;
+        bool isWithoutEscaping;
+    };
+
+    typedef std::vector<Frame> Frames;
+
+    /**
+     * Collects the frames reported by a decoder.
+     */
+    struct Collector
+    {
+        explicit Collector(Decoder const& decoder)
+            : decoder(decoder)
+        {}
+
+        Decoder const& decoder;
+        Frames frames;
+    };
+
+    template<typename IteratorType>
+    void collect(IteratorType first, IteratorType last, Collector* collector)
+    {
+        collector->frames.push_back(Frame(Bytes(first, last), collector->decoder.isDecodingFrameWithoutEscaping()));
+    }
+
+    /**
+     * A pseudo random number generator, so that the test is reproducible.
+     */
+    class Random
+    {
+        public:
+            Random()
+                : m_state(1)
+            {}
+
+            unsigned int next(unsigned int range)
+            {
+                m_state = m_state * 1103515245U + 12345U;
+                return (m_state >> 8) % range;
+            }
+
+            /**
+             * Returns a byte which has a special meaning in escaped frames with a
+             * probability of one in @p ratio.
+             */
+            unsigned char nextByte(unsigned int ratio)
+            {
+                return next(ratio) == 0
+                    ? static_cast<unsigned char>(0xF8 + next(8))
+                    : static_cast<unsigned char>(next(0xF8));
+            }
+
+        private:
+            unsigned int m_state;
+    };
+
+    /**
+     * Appends an encoded frame with the passed payload to @p stream.
+     */
+    template<typename EncoderType>
+    void appendFrame(Bytes& stream, Bytes const& payload)
+    {
+        EncoderType encoder;
+        encoder.encode(payload.begin(), payload.end());
+        encoder.finish();
+        stream.insert(stream.end(), encoder.begin(), encoder.end());
+    }
+
+    Frames decodeByteWise(Bytes const& stream)
+    {
+        Decoder decoder;
+        Collector collector(decoder);
+        for (Bytes::const_iterator it = stream.begin(); it != stream.end(); ++it)
+        {
+            decoder.readByte(*it, &collect<Decoder::const_iterator>, &collector);
+        }
+        return collector.frames;
+    }
+
+    Frames decodeIterators(Bytes const& stream, std::size_t blockSize)
+    {
+        Decoder decoder;
+        Collector collector(decoder);
+        for (std::size_t offset = 0; offset < stream.size(); offset += blockSize)
+        {
+            std::size_t const length = std::min(blockSize, stream.size() - offset);
+            decoder.read(stream.begin() + offset, stream.begin() + offset + length, &collect<Decoder::const_iterator>, &collector);
+        }
+        return collector.frames;
+    }
+
+    Frames decodeBlocks(Bytes const& stream, std::size_t blockSize)
+    {
+        Decoder decoder;
+        Collector collector(decoder);
+        unsigned char const* const first = &stream[0];
+        for (std::size_t offset = 0; offset < stream.size(); offset += blockSize)
+        {
+            std::size_t const length = std::min(blockSize, stream.size() - offset);
+            decoder.read(first + offset, first + offset + length, &collect<Decoder::const_iterator>, &collector);
+        }
+        return collector.frames;
+    }
+
+    Frames decodeInPlace(Bytes const& stream, std::size_t blockSize)
+    {
+        Decoder decoder;
+        Collector collector(decoder);
+        unsigned char const* const first = &stream[0];
+        for (std::size_t offset = 0; offset < stream.size(); offset += blockSize)
+        {
+            std::size_t const length = std::min(blockSize, stream.size() - offset);
+            decoder.readInPlace(first + offset, first + offset + length, &collect<unsigned char const*>, &collector);
+        }
+        return collector.frames;
+    }
+}
+
+int main(int, char const* const*)
+{
+    try
+    {
+        Random random;
+        Bytes stream;
+        Frames expected;
+
+        for (std::size_t index = 0; index < 300; ++index)
+        {
+            // Bytes between frames are ignored, as long as they don't start a frame.
+            for (unsigned int count = random.next(4); count > 0; --count)
+            {
+                stream.push_back(static_cast<unsigned char>(random.next(0xF8)));
+            }
+
+            Bytes payload(1 + random.next(index % 10 == 0 ? 3000 : 200));
+            unsigned int const ratio = 1 + random.next(64);
+            for (std::size_t i = 0; i < payload.size(); ++i)
+            {
+                payload[i] = random.nextByte(ratio);
+            }
+
+            switch (index % 5)
+            {
+                case 3:
+                    appendFrame<libs101::StreamEncoderWithoutEscaping<unsigned char> >(stream, payload);
+                    expected.push_back(Frame(payload, true));
+                    break;
+
+                case 4:
+                    if (index % 3 == 0)
+                    {
+                        // A frame with a corrupt crc is dropped.
+                        Bytes corrupt;
+                        appendFrame<libs101::StreamEncoder<unsigned char> >(corrupt, payload);
+                        corrupt[1] = static_cast<unsigned char>(corrupt[1] < 0x80 ? corrupt[1] + 1 : corrupt[1] - 1);
+                        stream.insert(stream.end(), corrupt.begin(), corrupt.end());
+                        break;
+                    }
+                    // Fall through
+
+                default:
+                    appendFrame<libs101::StreamEncoder<unsigned char> >(stream, payload);
+                    expected.push_back(Frame(payload, false));
+                    break;
+            }
+        }
+
+        if (!(decodeByteWise(stream) == expected))
+        {
+            THROW_TEST_EXCEPTION("Byte-wise decoding doesn't yield the encoded frames!");
+        }
+
+        std::size_t const blockSizes[] = { 1, 2, 3, 7, 64, 1000, 4096, stream.size() };
+        for (std::size_t i = 0; i < sizeof(blockSizes) / sizeof(blockSizes[0]); ++i)
+        {
+            std::size_t const blockSize = blockSizes[i];
+            if (!(decodeIterators(stream, blockSize) == expected))
+            {
+                THROW_TEST_EXCEPTION("Decoding iterator ranges of " << blockSize << " bytes differs from byte-wise decoding!");
+            }
+
+            if (!(decodeBlocks(stream, blockSize) == expected))
+            {
+                THROW_TEST_EXCEPTION("Decoding blocks of " << blockSize << " bytes differs from byte-wise decoding!");
+            }
+
+            if (!(decodeInPlace(stream, blockSize) == expected))
+            {
+                THROW_TEST_EXCEPTION("Decoding blocks of " << blockSize << " bytes in place differs from byte-wise decoding!");
+            }
+        }
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << "Unexpected exception: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,230 @@
+/*
+    libs101 -- C++ 03 implementation of the S101 encoding and decoding
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include <algorithm>
+#include <iostream>
+#include <list>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include "s101/S101.hpp"
+
+#define THROW_TEST_EXCEPTION(message)                       \
+            {                                               \
+                std::ostringstream msgStream;               \
+                msgStream << message ;                      \
+                throw std::runtime_error(msgStream.str());  \
+            }
+
+namespace
+{
+    typedef std::vector<unsigned char> Bytes;
+    typedef libs101::StreamEncoder<unsigned char> Encoder;
+    typedef libs101::ScatterEncoder<unsigned char> ScatterEncoder;
+
+    /**
+     * Creates a payload of the passed length, in which roughly one byte out of
+     * @p ratio needs to be escaped.
+     */
+    Bytes makePayload(std::size_t length, unsigned int ratio, unsigned int seed)
+    {
+        Bytes payload(length);
+        unsigned int state = seed;
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            state = state * 1103515245U + 12345U;
+            unsigned int const value = state >> 8;
+            payload[i] = (value / 256) % ratio == 0
+                ? static_cast<unsigned char>(0xF8 + value % 8)
+                : static_cast<unsigned char>(value % 0xF8);
+        }
+        return payload;
+    }
+
+    /**
+     * Encodes the payload byte by byte, which is the reference for all block
+     * oriented implementations.
+     */
+    Bytes encodeByteWise(Bytes const& payload)
+    {
+        Encoder encoder;
+        for (Bytes::const_iterator it = payload.begin(); it != payload.end(); ++it)
+        {
+            encoder.encode(*it);
+        }
+        encoder.finish();
+        return Bytes(encoder.begin(), encoder.end());
+    }
+
+    Bytes encodeBlocks(Bytes const& payload, std::size_t blockSize)
+    {
+        Encoder encoder;
+        unsigned char const* const first = &payload[0];
+        for (std::size_t offset = 0; offset < payload.size(); offset += blockSize)
+        {
+            std::size_t const length = std::min(blockSize, payload.size() - offset);
+            encoder.encode(first + offset, first + offset + length);
+        }
+        encoder.finish();
+        return Bytes(encoder.begin(), encoder.end());
+    }
+
+    Bytes encodeScattered(Bytes const& payload, std::size_t blockSize, std::size_t segmentCapacity)
+    {
+        std::vector<ScatterEncoder::Segment> segments(segmentCapacity);
+        Bytes buffer(ScatterEncoder::maximumBufferLength(payload.size()));
+        ScatterEncoder encoder(&segments[0], segments.size(), &buffer[0], buffer.size());
+
+        unsigned char const* const first = &payload[0];
+        for (std::size_t offset = 0; offset < payload.size(); offset += blockSize)
+        {
+            std::size_t const length = std::min(blockSize, payload.size() - offset);
+            encoder.encode(first + offset, first + offset + length);
+        }
+        encoder.finish();
+
+        if (encoder.isOverflowed())
+        {
+            THROW_TEST_EXCEPTION("The scatter encoder overflowed although the buffer has the maximum length!");
+        }
+
+        Bytes result;
+        for (ScatterEncoder::const_iterator it = encoder.begin(); it != encoder.end(); ++it)
+        {
+            result.insert(result.end(), it->data, it->data + it->size);
+        }
+
+        if (result.size() != encoder.length())
+        {
+            THROW_TEST_EXCEPTION("The segment lengths don't add up to the encoded length!");
+        }
+        return result;
+    }
+
+    void testBlockEncoding()
+    {
+        std::size_t const lengths[] = { 1, 2, 31, 32, 33, 100, 1000, 5000 };
+        unsigned int const ratios[] = { 1, 2, 8, 64, 100000 };
+        std::size_t const blockSizes[] = { 1, 3, 32, 100, 5000 };
+        std::size_t const segmentCapacities[] = { 1, 2, 4, 64 };
+
+        for (std::size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); ++l)
+        {
+            for (std::size_t r = 0; r < sizeof(ratios) / sizeof(ratios[0]); ++r)
+            {
+                Bytes const payload = makePayload(lengths[l], ratios[r], static_cast<unsigned int>(l * 10 + r));
+                Bytes const expected = encodeByteWise(payload);
+
+                Encoder iteratorEncoder;
+                std::list<unsigned char> const list(payload.begin(), payload.end());
+                iteratorEncoder.encode(list.begin(), list.end());
+                iteratorEncoder.finish();
+                if (Bytes(iteratorEncoder.begin(), iteratorEncoder.end()) != expected)
+                {
+                    THROW_TEST_EXCEPTION("Encoding an iterator range differs from byte-wise encoding for " << lengths[l] << " bytes!");
+                }
+
+                for (std::size_t b = 0; b < sizeof(blockSizes) / sizeof(blockSizes[0]); ++b)
+                {
+                    if (encodeBlocks(payload, blockSizes[b]) != expected)
+                    {
+                        THROW_TEST_EXCEPTION("Encoding blocks of " << blockSizes[b] << " bytes differs from byte-wise encoding for " << lengths[l] << " bytes!");
+                    }
+
+                    for (std::size_t s = 0; s < sizeof(segmentCapacities) / sizeof(segmentCapacities[0]); ++s)
+                    {
+                        if (encodeScattered(payload, blockSizes[b], segmentCapacities[s]) != expected)
+                        {
+                            THROW_TEST_EXCEPTION("Scattered encoding with " << segmentCapacities[s] << " segments differs from byte-wise encoding for " << lengths[l] << " bytes!");
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void testGeometricGrowth()
+    {
+        // Appending many small blocks must not reallocate the buffer for each block.
+        Bytes const payload = makePayload(64, 100000, 7);
+        std::size_t reallocations = 0;
+        Encoder encoder;
+        unsigned char const* storage = 0;
+        for (std::size_t i = 0; i < 4096; ++i)
+        {
+            encoder.encode(&payload[0], &payload[0] + payload.size());
+            unsigned char const* const current = &*encoder.begin();
+            if (current != storage)
+            {
+                storage = current;
+                ++reallocations;
+            }
+        }
+
+        if (reallocations > 64)
+        {
+            THROW_TEST_EXCEPTION("The encoder reallocated its buffer " << reallocations << " times for 4096 blocks!");
+        }
+    }
+
+    void testScatterOverflow()
+    {
+        Bytes const payload = makePayload(100, 2, 3);
+        ScatterEncoder::Segment segments[4];
+        Bytes buffer(16);
+        ScatterEncoder encoder(segments, 4, &buffer[0], buffer.size());
+        encoder.encode(&payload[0], &payload[0] + payload.size());
+        encoder.finish();
+        if (encoder.isOverflowed() == false)
+        {
+            THROW_TEST_EXCEPTION("The scatter encoder didn't report an overflow!");
+        }
+
+        encoder.reset();
+        encoder.encode(&payload[0], &payload[0] + 2);
+        encoder.finish();
+        if (encoder.isOverflowed() || encoder.isFinished() == false)
+        {
+            THROW_TEST_EXCEPTION("The scatter encoder didn't recover after a reset!");
+        }
+    }
+
+    void testWithoutEscaping()
+    {
+        Bytes const payload = makePayload(1000, 1, 11);
+        libs101::StreamEncoderWithoutEscaping<unsigned char> encoder;
+        encoder.encode(payload.begin(), payload.end());
+        encoder.finish();
+
+        Bytes const encoded(encoder.begin(), encoder.end());
+        if (encoded.size() != payload.size() + 6
+        ||  encoded[0] != 0xF8 || encoded[1] != 0x04
+        ||  encoded[2] != 0x00 || encoded[3] != 0x00 || encoded[4] != 0x03 || encoded[5] != 0xE8
+        ||  Bytes(encoded.begin() + 6, encoded.end()) != payload)
+        {
+            THROW_TEST_EXCEPTION("Unexpected frame without escaping!");
+        }
+    }
+}
+
+int main(int, char const* const*)
+{
+    try
+    {
+        testBlockEncoding();
+        testGeometricGrowth();
+        testScatterOverflow();
+        testWithoutEscaping();
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << "Unexpected exception: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,117 @@
+/*
+    libs101 -- C++ 03 implementation of the S101 encoding and decoding
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "s101/S101.hpp"
+#include "Benchmark.hpp"
+
+namespace
+{
+    typedef std::vector<unsigned char> Bytes;
+    typedef libs101::StreamEncoder<unsigned char> Encoder;
+    typedef libs101::StreamDecoder<unsigned char> Decoder;
+
+    /** Size of the blocks passed to the decoder, like a network packet. */
+    std::size_t const BlockSize = 1024;
+
+    /** Frames a message, including the S101 message header. */
+    struct Frame
+    {
+        explicit Frame(Bytes const& payload)
+            : payload(payload)
+        {}
+
+        void operator()() const
+        {
+            Encoder encoder;
+            encoder.encode(0x00);                               // Slot
+            encoder.encode(libs101::MessageType::EmBER);
+            encoder.encode(libs101::CommandType::EmBER);
+            encoder.encode(0x01);                               // Version
+            encoder.encode(libs101::PackageFlag::FirstPackage | libs101::PackageFlag::LastPackage);
+            encoder.encode(libs101::Dtd::Glow);
+            encoder.encode(0x02);                               // App bytes
+            encoder.encode(0x28);
+            encoder.encode(0x02);
+            encoder.encode(&payload[0], &payload[0] + payload.size());
+            encoder.finish();
+            benchmark::keep(encoder.size());
+        }
+
+        Bytes const& payload;
+    };
+
+    bool countFrame(Decoder::const_iterator first, Decoder::const_iterator last, std::size_t* count)
+    {
+        *count += static_cast<std::size_t>(last - first);
+        return true;
+    }
+
+    /** Unframes a message delivered in blocks. */
+    struct Unframe
+    {
+        explicit Unframe(Bytes const& payload)
+        {
+            Encoder encoder;
+            encoder.encode(&payload[0], &payload[0] + payload.size());
+            encoder.finish();
+            frame.assign(encoder.begin(), encoder.end());
+        }
+
+        void operator()() const
+        {
+            Decoder decoder;
+            std::size_t count = 0;
+            unsigned char const* const first = &frame[0];
+            for (std::size_t offset = 0; offset < frame.size(); offset += BlockSize)
+            {
+                std::size_t const length = std::min(BlockSize, frame.size() - offset);
+                decoder.read(first + offset, first + offset + length, &countFrame, &count);
+            }
+            benchmark::keep(count);
+        }
+
+        Bytes frame;
+    };
+
+    /**
+     * Creates a payload in which roughly one byte out of @p ratio needs to be
+     * escaped. Pass 0 to create a payload without any bytes to escape.
+     */
+    Bytes createPayload(std::size_t length, unsigned int ratio)
+    {
+        Bytes payload(length);
+        unsigned int state = 1;
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            state = state * 1103515245U + 12345U;
+            unsigned int const value = state >> 8;
+            payload[i] = ratio != 0 && (value / 256) % ratio == 0
+                ? static_cast<unsigned char>(0xF8 + value % 8)
+                : static_cast<unsigned char>(value % 0xF8);
+        }
+        return payload;
+    }
+
+    void measure(std::string const& name, Bytes const& payload)
+    {
+        benchmark::run("s101_frame_" + name, payload.size(), Frame(payload));
+        benchmark::run("s101_unframe_" + name, payload.size(), Unframe(payload));
+    }
+}
+
+int main()
+{
+    measure("small", createPayload(64, 64));
+    measure("plain", createPayload(64 * 1024, 0));
+    measure("mixed", createPayload(64 * 1024, 64));
+    measure("escape_heavy", createPayload(64 * 1024, 2));
+    return 0;
+}
@@ -0,0 +1,115 @@
+/*
+    libs101 -- C++ 03 implementation of the S101 encoding and decoding
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include <iostream>
+#include <list>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include "s101/util/Crc16.hpp"
+
+#define THROW_TEST_EXCEPTION(message)                       \
+            {                                               \
+                std::ostringstream msgStream;               \
+                msgStream << message ;                      \
+                throw std::runtime_error(msgStream.str());  \
+            }
+
+namespace
+{
+    typedef libs101::util::Crc16 Crc16;
+
+    /**
+     * Computes the crc byte by byte, which is the reference for all block
+     * oriented implementations.
+     */
+    Crc16::value_type addByteWise(Crc16::value_type crc, unsigned char const* first, unsigned char const* last)
+    {
+        for (; first != last; ++first)
+        {
+            crc = Crc16::add(crc, *first);
+        }
+        return crc;
+    }
+
+    /**
+     * Verifies that all implementations compute the same crc for the passed range.
+     */
+    void assertCrc(Crc16::value_type seed, unsigned char const* first, unsigned char const* last)
+    {
+        Crc16::value_type const expected = addByteWise(seed, first, last);
+        std::list<unsigned char> const list(first, last);
+
+        if (Crc16::add(seed, first, last) != expected
+        ||  Crc16::addSliced(seed, first, last) != expected
+        ||  Crc16::add(seed, list.begin(), list.end()) != expected)
+        {
+            THROW_TEST_EXCEPTION("Crc mismatch for " << (last - first) << " bytes!");
+        }
+
+#ifdef LIBS101_HAS_PCLMUL
+        if (last - first >= 64 && libs101::util::Cpu::hasCarrylessMultiply() && Crc16::addFolded(seed, first, last) != expected)
+        {
+            THROW_TEST_EXCEPTION("Folded crc mismatch for " << (last - first) << " bytes!");
+        }
+#endif
+    }
+}
+
+int main(int, char const* const*)
+{
+    try
+    {
+        unsigned char const check[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+        Crc16::value_type const checkCrc = static_cast<Crc16::value_type>(~Crc16::add(0xFFFF, check, check + sizeof(check)));
+        if (checkCrc != 0x906E)
+        {
+            THROW_TEST_EXCEPTION("Unexpected check value " << std::hex << checkCrc << "!");
+        }
+
+        std::vector<unsigned char> buffer(1024 + 16);
+        unsigned int state = 1;
+        for (std::size_t i = 0; i < buffer.size(); ++i)
+        {
+            state = state * 1103515245U + 12345U;
+            buffer[i] = static_cast<unsigned char>(state >> 16);
+        }
+
+        // All lengths around the slicing and folding block sizes, at every alignment.
+        for (std::size_t offset = 0; offset < 16; ++offset)
+        {
+            for (std::size_t length = 0; length <= 300; ++length)
+            {
+                unsigned char const* const first = &buffer[offset];
+                assertCrc(0xFFFF, first, first + length);
+                assertCrc(static_cast<Crc16::value_type>(length * 0x1234), first, first + length);
+            }
+        }
+
+        assertCrc(0xFFFF, &buffer[0], &buffer[0] + 1024);
+
+        // A crc computed in pieces equals the one computed at once.
+        Crc16::value_type crc = 0xFFFF;
+        for (std::size_t offset = 0; offset < 1024; offset += 100)
+        {
+            std::size_t const length = offset + 100 < 1024 ? 100 : 1024 - offset;
+            crc = Crc16::add(crc, &buffer[offset], &buffer[offset] + length);
+        }
+
+        if (crc != addByteWise(0xFFFF, &buffer[0], &buffer[0] + 1024))
+        {
+            THROW_TEST_EXCEPTION("Crc computed in pieces differs!");
+        }
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << "Unexpected exception: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
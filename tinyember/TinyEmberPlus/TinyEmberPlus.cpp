@@ -43,7 +43,6 @@ TinyEmberPlus::TinyEmberPlus(::glow::ConsumerProxy* proxy, QWidget *parent, Qt::
     : QMainWindow(parent, flags)
     , m_proxy(proxy)
     , m_settingsSerializer("Settings.xml")
-    , m_lastKeepAliveTransmitTime(QDateTime::currentDateTimeUtc())
     , m_generateRandomValues(false)
     , m_sendKeepAlive(false)
 {
@@ -372,15 +371,7 @@ void TinyEmberPlus::timer()
         delete root;
     }
 
-    auto const now = QDateTime::currentDateTimeUtc();
-    if (m_sendKeepAlive)
-    {
-        if (m_lastKeepAliveTransmitTime.msecsTo(now) > 4000)
-        {
-            m_lastKeepAliveTransmitTime = now;
-            m_proxy->writeRequestKeepAlive();
-        }
-    }
+    m_proxy->updateLinks(m_sendKeepAlive);
 }
 
 void TinyEmberPlus::updateStreamTimer()
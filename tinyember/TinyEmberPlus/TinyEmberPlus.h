@@ -200,7 +200,6 @@ class TinyEmberPlus : public QMainWindow, public glow::ProviderInterface
         glow::ConsumerProxy *const m_proxy;
         serialization::SettingsSerializer m_settingsSerializer;
         QTimer* m_timer;
-        QDateTime m_lastKeepAliveTransmitTime;
         bool m_generateRandomValues;
         bool m_sendKeepAlive;
 
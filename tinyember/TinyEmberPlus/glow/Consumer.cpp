@@ -9,6 +9,7 @@
 #include <ember/Ember.hpp>
 #include <s101/CommandType.hpp>
 #include <s101/Dtd.hpp>
+#include <s101/KeepAliveFrame.hpp>
 #include <s101/PackageFlag.hpp>
 #include <s101/StreamEncoder.hpp>
 #include <s101/MessageType.hpp>
@@ -61,6 +62,15 @@ namespace glow
 #endif
         , m_provider(provider)
         , m_subscriber(new SubscriberImpl(socket))
+        , m_reassembler(MaximumMessageLength)
+#ifdef _MSC_VER
+#  pragma warning(push)
+#  pragma warning(disable : 4355)
+#endif
+        , m_link(this)
+#ifdef _MSC_VER
+#  pragma warning(pop)
+#endif
     {
         if (provider != nullptr)
             provider->registerSubscriberAsync(m_subscriber);
@@ -77,52 +87,35 @@ namespace glow
 
     void Consumer::read(const_iterator first, const_iterator last, size_type /* size */)
     {
-        m_decoder.read(first, last, Consumer::dispatch, this);
+        m_link.notifyReceived();
+        m_decoder.readInPlace(first, last, Consumer::dispatch, this);
     }
 
-    void Consumer::handleMessage(Decoder::const_iterator first, Decoder::const_iterator last)
+    void Consumer::handleMessage(Decoder::const_pointer first, Decoder::const_pointer last)
     {
-        first++;                                                    // Slot
-        auto const message = *first++;                              // Message
-
-        if (message == libs101::MessageType::EmBER)
+        try
         {
-            auto const command = *first++;                          // Command
-            first++;                                                // Version
-            auto const flags = libs101::PackageFlag(*first++);      // Flags
-            first++;                                                // DTD
+            auto const isFrameWithoutEscaping = m_decoder.isDecodingFrameWithoutEscaping();
+            auto const result = m_reassembler.read(first, last, m_reader);
 
-            if (command == libs101::CommandType::EmBER)
+            if (result == Reassembler::Complete)
+            {
+                m_reader.reset();
+            }
+            else if (result == Reassembler::KeepAliveRequest)
             {
-                auto appbytes = *first++;   // 1 AppByte
-                while(appbytes-- > 0)
-                    ++first;
-
-                try
-                {
-                    m_reader.read(first, last);
-                }
-                catch(std::runtime_error ex)
-                {
-                    std::cerr << ex.what();
-                }
-
-                if (flags.value() & libs101::PackageFlag::LastPackage)
-                {
-                    m_reader.reset();
-                }
+                auto const& frame = libs101::KeepAliveFrame::response(isFrameWithoutEscaping);
+                write(frame.begin(), frame.end());
             }
-            else if (command == libs101::CommandType::KeepAliveRequest)
+            else if (result == Reassembler::Overflow)
             {
-                auto encoder = libs101::StreamEncoder<unsigned char>();
-                encoder.encode(0x00);                                       // Slot
-                encoder.encode(libs101::MessageType::EmBER);                // Message Type
-                encoder.encode(libs101::CommandType::KeepAliveResponse);    // Command
-                encoder.encode(0x01);                                       // Framing Version (1)
-                encoder.finish();
-                write(encoder.begin(), encoder.end());
+                std::cerr << "Discarding ember message exceeding " << MaximumMessageLength << " bytes" << std::endl;
             }
         }
+        catch(std::runtime_error ex)
+        {
+            std::cerr << ex.what();
+        }
     }
 
     void Consumer::rootReady(libember::dom::Node* root)
@@ -135,7 +128,7 @@ namespace glow
     }
 
     //static 
-    void Consumer::dispatch(Decoder::const_iterator first, Decoder::const_iterator last, Consumer* state)
+    void Consumer::dispatch(Decoder::const_pointer first, Decoder::const_pointer last, Consumer* state)
     {
         state->handleMessage(first, last);
     }
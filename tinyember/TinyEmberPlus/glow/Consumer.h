@@ -9,6 +9,8 @@
 
 #include <memory>
 #include <ember/Ember.hpp>
+#include <s101/LinkMonitor.hpp>
+#include <s101/MessageReassembler.hpp>
 #include <s101/StreamDecoder.hpp>
 #include "../gadget/Subscriber.h"
 #include "../net/TcpClient.h"
@@ -75,7 +77,14 @@ namespace glow
         };
 
         typedef libs101::StreamDecoder<unsigned char> Decoder;
+        typedef libs101::MessageReassembler<unsigned char> Reassembler;
+
+        /** The maximum size of a single ember message a consumer may send, in bytes. */
+        static const std::size_t MaximumMessageLength = 16 * 1024 * 1024;
+
         public:
+            typedef libs101::LinkMonitor<Consumer> Monitor;
+
             /**
              * Initializes a new Consumer.
              * @param provider The provider which is used to notify consumer requests and subscriptions.
@@ -83,6 +92,12 @@ namespace glow
              */
             Consumer(ProviderInterface* provider, QTcpSocket* socket);
 
+            /**
+             * Returns the link which is used to supervise the connection.
+             * @return The link which is used to supervise the connection.
+             */
+            Monitor::Link& link();
+
         private:
             /** Destructor */
             virtual ~Consumer();
@@ -101,7 +116,7 @@ namespace glow
              * @param first Reference to the first byte of the decoded s101 message.
              * @param last Points the the first element beyond the s101 message buffer.
              */
-            void handleMessage(Decoder::const_iterator first, Decoder::const_iterator last);
+            void handleMessage(Decoder::const_pointer first, Decoder::const_pointer last);
 
             /**
              * This method is called by the DomReader when a tree has been decoded.
@@ -115,14 +130,21 @@ namespace glow
              * @param last Points the the first element beyond the rx buffer.
              * @param state A pointer to the consumer that received the bytes passed.
              */
-            static void dispatch(Decoder::const_iterator first, Decoder::const_iterator last, Consumer* state);
+            static void dispatch(Decoder::const_pointer first, Decoder::const_pointer last, Consumer* state);
 
         private:
             DomReader m_reader;
             ProviderInterface* m_provider;
             SubscriberImpl* m_subscriber;
             Decoder m_decoder;
+            Reassembler m_reassembler;
+            Monitor::Link m_link;
     };
+
+    inline Consumer::Monitor::Link& Consumer::link()
+    {
+        return m_link;
+    }
 }
 
 #endif//__TINYEMBER_GLOW_CONSUMER_H
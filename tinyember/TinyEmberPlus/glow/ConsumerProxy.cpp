@@ -4,6 +4,7 @@
     (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 */
 
+#include <s101/KeepAliveFrame.hpp>
 #include "Consumer.h"
 #include "ConsumerProxy.h"
 #include "Encoder.h"
@@ -24,7 +25,10 @@ namespace glow
 
     ConsumerProxy::ConsumerProxy(QApplication* app, ProviderInterface* provider, short port)
         : m_provider(provider)
+        , m_monitor(ProbeInterval, Timeout)
+        , m_isKeepAliveEnabled(false)
     {
+        m_clock.start();
         m_server = new net::TcpServer(app, this, port);
     }
 
@@ -47,23 +51,34 @@ namespace glow
 
     Consumer* ConsumerProxy::create(QTcpSocket* socket)
     {
-        return new Consumer(m_provider, socket);
+        auto const consumer = new Consumer(m_provider, socket);
+        m_monitor.attach(consumer->link());
+        return consumer;
     }
 
-    void ConsumerProxy::writeRequestKeepAlive()
+    void ConsumerProxy::updateLinks(bool isKeepAliveEnabled)
     {
-        auto const result = Encoder::createRequestKeepAliveMessage();
-        auto server = m_server;
-        if (server != nullptr)
+        m_isKeepAliveEnabled = isKeepAliveEnabled;
+        m_monitor.advance(static_cast<Consumer::Monitor::size_type>(m_clock.elapsed() / TickLength), *this);
+    }
+
+    void ConsumerProxy::probe(Consumer* consumer)
+    {
+        if (m_isKeepAliveEnabled)
         {
-            auto const last = result.end();
-            for(auto it = result.begin(); it != last; ++it)
-            {
-                server->write(it->begin(), it->end());
-            }
+            auto const& frame = libs101::KeepAliveFrame::request();
+            consumer->write(frame.begin(), frame.end());
         }
     }
 
+    void ConsumerProxy::expire(Consumer* consumer)
+    {
+        if (m_isKeepAliveEnabled)
+            consumer->close();
+        else
+            m_monitor.attach(consumer->link());
+    }
+
     void ConsumerProxy::writeProviderState(bool state)
     {
         auto const result = Encoder::createProviderStateMessage(state);
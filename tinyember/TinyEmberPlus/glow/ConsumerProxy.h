@@ -7,6 +7,7 @@
 #ifndef __TINYEMBER_GLOW_CONSUMERPROXY_H
 #define __TINYEMBER_GLOW_CONSUMERPROXY_H
 
+#include <QElapsedTimer>
 #include "../net/TcpClientFactory.h"
 #include "../net/TcpServer.h"
 #include "../gadget/Node.h"
@@ -36,6 +37,7 @@ namespace glow
         public gadget::Node::DirtyStateListenerT,
         private net::TcpClientFactory
     {
+        friend class libs101::LinkMonitor<Consumer>;
         public:
             /**
              * Returns a reference to the static settings instance. The settings define the response behavior.
@@ -65,9 +67,13 @@ namespace glow
             void write(libember::glow::GlowContainer const* container);
 
             /**
-             * Sends a keep-alive request message to all connected clients.
+             * Supervises the connected consumers. Consumers that have been idle for
+             * a while are sent a keep-alive request, consumers that don't respond
+             * are disconnected. This method has to be called periodically.
+             * @param isKeepAliveEnabled If set to false, no keep-alive requests
+             *      are sent and idle consumers stay connected.
              */
-            void writeRequestKeepAlive();
+            void updateLinks(bool isKeepAliveEnabled);
 
             /**
              * Sends a provider state message to all connected clients.
@@ -87,6 +93,20 @@ namespace glow
              * @return The new Consumer instance.
              */
             virtual Consumer* create(QTcpSocket* socket);
+
+            /**
+             * This method is called by the link monitor when a consumer has been idle
+             * for the probe interval. It sends a keep-alive request to the consumer.
+             * @param consumer The idle consumer.
+             */
+            void probe(Consumer* consumer);
+
+            /**
+             * This method is called by the link monitor when a consumer didn't respond
+             * to a keep-alive request. The connection to the consumer is closed.
+             * @param consumer The consumer that didn't respond.
+             */
+            void expire(Consumer* consumer);
             
         private:
             /**
@@ -136,8 +156,21 @@ namespace glow
             bool isNotificationRequired(gadget::Node const* node) const;
 
         private:
+            /**
+             * The link monitor timing, in ticks of 100 milliseconds.
+             */
+            enum
+            {
+                TickLength = 100,
+                ProbeInterval = 40,
+                Timeout = 120,
+            };
+
             ProviderInterface *const m_provider;
             net::TcpServer* m_server;
+            Consumer::Monitor m_monitor;
+            QElapsedTimer m_clock;
+            bool m_isKeepAliveEnabled;
 
             static Settings s_settings;
     };
@@ -30,20 +30,20 @@ namespace glow
 
 
     Encoder::Stream::Stream(Encoder *const encoder)
-        : libember::util::OctetStream(1024)
+        : libember::util::OctetStream(1024, 1024)
         , m_encoder(encoder)
     {}
 
-    void Encoder::Stream::flush(iterator first, iterator last)
+    void Encoder::Stream::flush(iterator, iterator)
     {
         auto const isLastPacket = false;
-        m_encoder->finishPacket(first, last, isLastPacket);
+        m_encoder->finishPacket(segment_begin(), segment_end(), isLastPacket);
     }
 
     void Encoder::Stream::finish()
     {
         auto const isLastPacket = true;
-        m_encoder->finishPacket(std::begin(*this), std::end(*this), isLastPacket);
+        m_encoder->finishPacket(segment_begin(), segment_end(), isLastPacket);
     }
 
 
@@ -52,17 +52,6 @@ namespace glow
         return Encoder(container);
     }
 
-    Encoder Encoder::createRequestKeepAliveMessage()
-    {
-        libs101::StreamEncoder<unsigned char> encoder;
-        encoder.encode(0x00);                                           // Slot
-        encoder.encode(libs101::MessageType::EmBER);                    // Message type
-        encoder.encode(libs101::CommandType::KeepAliveRequest);         // Command
-        encoder.encode(0x01);                                           // Version
-        encoder.finish();
-        return Encoder(encoder.begin(), encoder.end());
-    }
-
     Encoder Encoder::createProviderStateMessage(bool state)
     {
         libs101::StreamEncoder<unsigned char> encoder;
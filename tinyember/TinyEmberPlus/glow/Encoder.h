@@ -91,11 +91,6 @@ namespace glow
              */
             static Encoder createProviderStateMessage(bool state);
 
-            /**
-             * Creates a new keep-alive request.
-             * @return A new Encoder instance which contains the encoded keep-alive request.
-             */
-            static Encoder createRequestKeepAliveMessage();
 
             /**
              * Returns an iterator that points to the first s101 packet.
@@ -134,13 +129,12 @@ namespace glow
             /**
              * Finishes the current packet. When the provided buffer is empty, an empty
              * packet will be generated.
-             * @param first An iterator that points to the first byte of the buffer that contains a portion
-             *      of the encoded ember tree.
-             * @param last An iterator that points one past the last byte to copy.
+             * @param first An iterator that points to the first contiguous segment of the buffer
+             *      that contains a portion of the encoded ember tree.
+             * @param last An iterator that points one past the last segment to encode.
              * @param isLastPacket If set to true, the last packet flag will be set in the current s101 message.
              */
-            template<typename InputIterator>
-            void finishPacket(InputIterator first, InputIterator last, bool isLastPacket);
+            void finishPacket(libember::util::OctetStream::segment_iterator first, libember::util::OctetStream::segment_iterator last, bool isLastPacket);
 
         private:
             bool m_isFirstPacket;
@@ -168,11 +162,10 @@ namespace glow
                 private:
                     /**
                      * This method called by the OctetStream when the capacity has been reached
-                     * and the buffer resets itself.
-                     * @param first An iterator that points to the first item in the current stream buffer.
-                     * @param last An iterator that points one past the last item of the buffer to copy.
+                     * and the buffer resets itself. Since the iterators always span the whole
+                     * buffer, its contents are passed to the encoder as contiguous segments.
                      */
-                    virtual void flush(iterator first, iterator last);
+                    virtual void flush(iterator, iterator);
 
                 private:
                     Encoder *const m_encoder;
@@ -197,8 +190,7 @@ namespace glow
         m_packets.push_back(Packet(first, last));
     }
 
-    template<typename InputIterator>
-    inline void Encoder::finishPacket(InputIterator first, InputIterator last, bool isLastPacket)
+    inline void Encoder::finishPacket(libember::util::OctetStream::segment_iterator first, libember::util::OctetStream::segment_iterator last, bool isLastPacket)
     {
         auto encoder = libs101::StreamEncoder<unsigned char>();
         auto const version = libember::glow::GlowDtd::version();
@@ -218,7 +210,9 @@ namespace glow
         encoder.encode(0x02);                       // App bytes low
         encoder.encode((version >> 0) & 0xFF);      // App specific, minor revision
         encoder.encode((version >> 8) & 0xFF);      // App specific, major revision
-        encoder.encode(first, last);
+        for (/* Nothing */; first != last; ++first)
+            encoder.encode(first->first, first->first + first->second);
+
         encoder.finish();
 
         m_isFirstPacket = false;
@@ -42,6 +42,12 @@ namespace net
              */
             void write(QByteArray const& array);
 
+            /**
+             * Closes the connection. The disconnected signal is emitted once
+             * all pending data has been written.
+             */
+            void close();
+
         signals:
             /**
              * This signal is emitted when the socket disconnects.
@@ -101,6 +107,13 @@ namespace net
         if (socket != nullptr)
             socket->write(array);
     }
+
+    inline void TcpClient::close()
+    {
+        auto socket = m_socket;
+        if (socket != nullptr)
+            socket->disconnectFromHost();
+    }
 }
 
 #endif//__TINYEMBER_NET_TCPCLIENT_H
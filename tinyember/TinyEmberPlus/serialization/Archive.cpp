@@ -4,7 +4,7 @@
     (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 */
 
-#include <algorithm>
+#include <cstddef>
 #include <qfile.h>
 #include <qdatastream.h>
 #include "Archive.h"
@@ -21,10 +21,10 @@ namespace serialization
         QFile file(QString::fromStdString(filename));
         if (file.open(QIODevice::WriteOnly))
         {
-            std::for_each(std::begin(berstream), std::end(berstream), [&file](unsigned char byte)
+            for (auto it = berstream.segment_begin(); it != berstream.segment_end(); ++it)
             {
-                file.putChar(byte);
-            });
+                file.write(reinterpret_cast<char const*>(it->first), static_cast<qint64>(it->second));
+            }
 
             file.flush();
             file.close();
@@ -41,7 +41,7 @@ namespace serialization
             {
                 auto bytearray = file.readAll();
                 auto stream = libember::util::OctetStream(0);
-                stream.append(bytearray.begin(), bytearray.end());
+                stream.append(reinterpret_cast<unsigned char const*>(bytearray.constData()), static_cast<std::size_t>(bytearray.size()));
 
                 auto reader = detail::GadgetTreeReader(stream);
                 result = reader.m_root;
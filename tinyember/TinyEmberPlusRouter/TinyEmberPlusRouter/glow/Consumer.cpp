@@ -9,11 +9,11 @@
 #include <ember/glow/GlowNodeFactory.hpp>
 #include <s101/CommandType.hpp>
 #include <s101/Dtd.hpp>
+#include <s101/KeepAliveFrame.hpp>
 #include <s101/PackageFlag.hpp>
-#include <s101/StreamEncoder.hpp>
 #include <s101/MessageType.hpp>
 #include "Dispatcher.h"
-#include "Encoder.h"
+#include "FramingStream.h"
 #include "Consumer.h"
 
 namespace glow
@@ -49,63 +49,46 @@ namespace glow
       : TcpClient(socket)
       , m_dispatcher(dispatcher)
       , m_reader(this)
+      , m_reassembler(MaximumMessageLength)
+      , m_negotiation(true)
    {}
 
    void Consumer::writeGlow(libember::glow::GlowContainer const* glow)
    {
-      auto encoder = Encoder::createEmberMessage(glow);
-
-      for(auto packet : encoder)
-         write(packet.begin(), packet.end());
+      FramingStream<net::TcpClient> stream(this, m_negotiation.mode());
+      glow->encode(stream);
+      stream.finish();
    }
 
    void Consumer::read(const_iterator first, const_iterator last, size_type size)
    {
       std::cout << "received " << size << " bytes" << std::endl;
-      m_decoder.read(first, last, Consumer::onS101Message, this);
+      m_decoder.readInPlace(first, last, Consumer::onS101Message, this);
    }
 
-   void Consumer::handleS101Message(Decoder::const_iterator first, Decoder::const_iterator last)
+   void Consumer::handleS101Message(Decoder::const_pointer first, Decoder::const_pointer last)
    {
-      first++;                                                   // Slot
-      auto const message = *first++;                             // Message
-
-      if(message == libs101::MessageType::EmBER)
+      try
       {
-         auto const command = *first++;                          // Command
-         first++;                                                // Version
-         auto const flags = libs101::PackageFlag(*first++);      // Flags
-         first++;                                                // DTD
+         auto const isFrameWithoutEscaping = m_decoder.isDecodingFrameWithoutEscaping();
+         auto const result = m_reassembler.read(first, last, m_reader);
+
+         m_negotiation.notify(isFrameWithoutEscaping);
 
-         if(command == libs101::CommandType::EmBER)
+         if(result == Reassembler::KeepAliveRequest)
          {
-            auto appbytes = *first++;   // 1 Byte AppBytesCount
-            while(appbytes-- > 0)
-               first++;
-
-            if(flags.value() & libs101::PackageFlag::FirstPackage)
-               m_reader.reset();
-
-            try
-            {
-               m_reader.read(first, last);
-            }
-            catch(std::runtime_error ex)
-            {
-               std::cerr << ex.what();
-            }
+            auto const& frame = libs101::KeepAliveFrame::response(isFrameWithoutEscaping);
+            write(frame.begin(), frame.end());
          }
-         else if(command == libs101::CommandType::KeepAliveRequest)
+         else if(result == Reassembler::Overflow)
          {
-            auto encoder = libs101::StreamEncoder<unsigned char>();
-            encoder.encode(0x00);                                       // Slot
-            encoder.encode(libs101::MessageType::EmBER);                // Message Type
-            encoder.encode(libs101::CommandType::KeepAliveResponse);    // Command
-            encoder.encode(0x01);                                       // Framing Version (1)
-            encoder.finish();
-            write(encoder.begin(), encoder.end());
+            std::cerr << "Discarding ember message exceeding " << MaximumMessageLength << " bytes" << std::endl;
          }
       }
+      catch(std::runtime_error ex)
+      {
+         std::cerr << ex.what();
+      }
    }
 
    void Consumer::rootReady(libember::dom::Node* root)
@@ -122,7 +105,7 @@ namespace glow
    }
 
    //static 
-   void Consumer::onS101Message(Decoder::const_iterator first, Decoder::const_iterator last, Consumer* state)
+   void Consumer::onS101Message(Decoder::const_pointer first, Decoder::const_pointer last, Consumer* state)
    {
       state->handleS101Message(first, last);
    }
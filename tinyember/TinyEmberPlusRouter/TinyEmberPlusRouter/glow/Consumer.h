@@ -9,6 +9,8 @@
 
 #include <ember/dom/AsyncDomReader.hpp>
 #include <ember/glow/GlowContainer.hpp>
+#include <s101/FramingNegotiation.hpp>
+#include <s101/MessageReassembler.hpp>
 #include <s101/StreamDecoder.hpp>
 #include "../net/TcpClient.h"
 
@@ -49,6 +51,10 @@ namespace glow
       };
 
       typedef libs101::StreamDecoder<unsigned char> Decoder;
+      typedef libs101::MessageReassembler<unsigned char> Reassembler;
+
+      /** The maximum size of a single ember message a consumer may send, in bytes. */
+      static const std::size_t MaximumMessageLength = 16 * 1024 * 1024;
 
    public:
       explicit Consumer(QTcpSocket* socket, Dispatcher* dispatcher);
@@ -81,7 +87,7 @@ namespace glow
         * @param first Reference to the first byte of the decoded s101 message.
         * @param last Points the the first element beyond the s101 message buffer.
         */
-      void handleS101Message(Decoder::const_iterator first, Decoder::const_iterator last);
+      void handleS101Message(Decoder::const_pointer first, Decoder::const_pointer last);
 
       /**
         * Static callback for the s101 decoder.
@@ -89,12 +95,14 @@ namespace glow
         * @param last Points the the first element beyond the rx buffer.
         * @param state A pointer to the consumer that received the bytes passed.
         */
-      static void onS101Message(Decoder::const_iterator first, Decoder::const_iterator last, Consumer* state);
+      static void onS101Message(Decoder::const_pointer first, Decoder::const_pointer last, Consumer* state);
 
    private:
       Dispatcher* m_dispatcher;
       DomReader m_reader;
       Decoder m_decoder;
+      Reassembler m_reassembler;
+      libs101::FramingNegotiation m_negotiation;
    };
 }
 
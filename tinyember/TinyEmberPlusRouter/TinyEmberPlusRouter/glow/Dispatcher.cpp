@@ -6,7 +6,7 @@
 
 #include "../model/model.h"
 #include "Consumer.h"
-#include "Encoder.h"
+#include "FramingStream.h"
 #include "Dispatcher.h"
 
 namespace glow
@@ -463,9 +463,8 @@ namespace glow
 
    void Dispatcher::writeGlow(libember::glow::GlowContainer const* glow)
    {
-      auto encoder = Encoder::createEmberMessage(glow);
-
-      for(auto packet : encoder)
-         m_server.write(packet.begin(), packet.end());
+      FramingStream<net::TcpServer> stream(&m_server);
+      glow->encode(stream);
+      stream.finish();
    }
 }
@@ -0,0 +1,249 @@
+/*
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __TINYEMBERROUTER_GLOW_FRAMINGSTREAM_H
+#define __TINYEMBERROUTER_GLOW_FRAMINGSTREAM_H
+
+#include <algorithm>
+#include <iostream>
+#include <ember/Ember.hpp>
+#include <s101/Byte.hpp>
+#include <s101/CommandType.hpp>
+#include <s101/Dtd.hpp>
+#include <s101/FramingNegotiation.hpp>
+#include <s101/MessageType.hpp>
+#include <s101/PackageFlag.hpp>
+#include <s101/ScatterEncoder.hpp>
+#include <s101/StreamEncoder.hpp>
+
+namespace glow
+{
+    /**
+     * Stream that receives an encoded ember tree and frames its contents as s101
+     * packets whenever the stream buffer is flushed. Each packet is encoded into
+     * a buffer owned by the stream and handed to the target as a list of segments,
+     * so no intermediate packet objects are created.
+     * Packets are framed without escaping if the stream is created with the
+     * corresponding mode, in which case the payload is referenced instead of copied.
+     * The target type must provide a method writeSegments(first, last) which
+     * accepts a range of libs101::ScatterEncoder<unsigned char>::Segment.
+     */
+    template<typename TargetType>
+    class FramingStream : public libember::util::OctetStream
+    {
+        typedef libs101::ScatterEncoder<unsigned char> PacketEncoder;
+
+        public:
+            /**
+             * Initializes a new FramingStream instance.
+             * @param target The object that transmits the encoded packets.
+             * @param mode The framing variant to use for the packets.
+             */
+            explicit FramingStream(TargetType* target, libs101::FramingNegotiation::Mode mode = libs101::FramingNegotiation::WithEscaping);
+
+            /**
+             * Frames the pending data as the last packet of the message.
+             */
+            void finish();
+
+        private:
+            /**
+             * This method called by the OctetStream when the capacity has been reached
+             * and the buffer resets itself. Since the iterators always span the whole
+             * buffer, its contents are framed segment by segment.
+             */
+            virtual void flush(iterator, iterator);
+
+            /**
+             * Encodes a single s101 packet and passes it to the target. When the provided
+             * buffer is empty, an empty packet will be generated.
+             * @param first An iterator that points to the first contiguous segment of the payload.
+             * @param last An iterator that points one past the last segment of the payload.
+             * @param isLastPacket If set to true, the last packet flag will be set in the current s101 message.
+             */
+            void writePacket(segment_iterator first, segment_iterator last, bool isLastPacket);
+
+            /**
+             * Encodes a single s101 packet into a contiguous buffer and passes it to the target.
+             * This is used if the packet does not fit into the buffer owned by the stream.
+             * @param header The s101 header of the packet.
+             * @param first An iterator that points to the first contiguous segment of the payload.
+             * @param last An iterator that points one past the last segment of the payload.
+             */
+            void writePacketWithStreamEncoder(unsigned char const* header, segment_iterator first, segment_iterator last);
+
+            /**
+             * Writes a single s101 packet as a frame without escaping. The frame header
+             * is written to the buffer owned by the stream, the payload segments are
+             * passed to the target as they are. If the payload spans more segments
+             * than the segment list provides, the remaining ones are copied behind
+             * the frame header.
+             * @param header The s101 header of the packet.
+             * @param first An iterator that points to the first contiguous segment of the payload.
+             * @param last An iterator that points one past the last segment of the payload.
+             */
+            void writePacketWithoutEscaping(unsigned char const* header, segment_iterator first, segment_iterator last);
+
+        private:
+            /**
+             * The buffer capacity equals PacketEncoder::maximumBufferLength(HeaderSize + PacketSize),
+             * so a packet only overflows it if the payload exceeds the packet size.
+             */
+            enum
+            {
+                PacketSize = 1024,
+                HeaderSize = 9,
+                SegmentCapacity = 16,
+                BufferCapacity = 1 + 2 * (HeaderSize + PacketSize) + 4 + 1,
+            };
+
+            TargetType *const m_target;
+            libs101::FramingNegotiation::Mode const m_mode;
+            bool m_isFirstPacket;
+            PacketEncoder::Segment m_segments[SegmentCapacity];
+            unsigned char m_buffer[BufferCapacity];
+    };
+
+    /**************************************************************************
+     * Mandatory inline implementation                                        *
+     **************************************************************************/
+
+    template<typename TargetType>
+    inline FramingStream<TargetType>::FramingStream(TargetType* target, libs101::FramingNegotiation::Mode mode)
+        : libember::util::OctetStream(PacketSize, PacketSize)
+        , m_target(target)
+        , m_mode(mode)
+        , m_isFirstPacket(true)
+    {}
+
+    template<typename TargetType>
+    inline void FramingStream<TargetType>::flush(iterator, iterator)
+    {
+        auto const isLastPacket = false;
+        writePacket(segment_begin(), segment_end(), isLastPacket);
+    }
+
+    template<typename TargetType>
+    inline void FramingStream<TargetType>::finish()
+    {
+        auto const isLastPacket = true;
+        writePacket(segment_begin(), segment_end(), isLastPacket);
+        clear();
+    }
+
+    template<typename TargetType>
+    inline void FramingStream<TargetType>::writePacket(segment_iterator first, segment_iterator last, bool isLastPacket)
+    {
+        auto const version = libember::glow::GlowDtd::version();
+        auto const isEmpty = first == last;
+        auto const flags = (unsigned char)(
+                (m_isFirstPacket ? libs101::PackageFlag::FirstPackage : 0) |
+                (isLastPacket ? libs101::PackageFlag::LastPackage : 0) |
+                (isEmpty ? libs101::PackageFlag::EmptyPackage : 0)
+            );
+
+        unsigned char const header[HeaderSize] =
+        {
+            0x00,                                   // Slot
+            libs101::MessageType::EmBER,            // Message type
+            libs101::CommandType::EmBER,            // Ember Command
+            0x01,                                   // Version
+            flags,                                  // Flags
+            libs101::Dtd::Glow,                     // Glow Dtd
+            0x02,                                   // App bytes low
+            (unsigned char)((version >> 0) & 0xFF), // App specific, minor revision
+            (unsigned char)((version >> 8) & 0xFF), // App specific, major revision
+        };
+
+        m_isFirstPacket = false;
+
+        if (m_mode == libs101::FramingNegotiation::WithoutEscaping)
+        {
+            writePacketWithoutEscaping(header, first, last);
+            return;
+        }
+
+        auto encoder = PacketEncoder(m_segments, SegmentCapacity, m_buffer, BufferCapacity);
+        encoder.encode(header, header + HeaderSize);
+        for (auto it = first; it != last; ++it)
+            encoder.encode(it->first, it->first + it->second);
+
+        encoder.finish();
+
+        if (encoder.isOverflowed())
+        {
+            std::cerr << "Packet exceeds the framing buffer of " << BufferCapacity << " bytes, encoding it without scattering" << std::endl;
+            writePacketWithStreamEncoder(header, first, last);
+        }
+        else
+        {
+            m_target->writeSegments(encoder.begin(), encoder.end());
+        }
+    }
+
+    template<typename TargetType>
+    inline void FramingStream<TargetType>::writePacketWithStreamEncoder(unsigned char const* header, segment_iterator first, segment_iterator last)
+    {
+        auto encoder = libs101::StreamEncoder<unsigned char>();
+        encoder.encode(header, header + HeaderSize);
+        for (/* Nothing */; first != last; ++first)
+            encoder.encode(first->first, first->first + first->second);
+
+        encoder.finish();
+
+        PacketEncoder::Segment const segment = { &*encoder.begin(), encoder.size() };
+        m_target->writeSegments(&segment, &segment + 1);
+    }
+
+    template<typename TargetType>
+    inline void FramingStream<TargetType>::writePacketWithoutEscaping(unsigned char const* header, segment_iterator first, segment_iterator last)
+    {
+        auto length = std::size_t(HeaderSize);
+        auto segmentCount = std::size_t(1);
+
+        for (/* Nothing */; first != last; ++first)
+        {
+            auto next = first;
+            if (segmentCount == SegmentCapacity - 1 && ++next != last)
+                break;
+
+            m_segments[segmentCount].data = first->first;
+            m_segments[segmentCount].size = first->second;
+            length += first->second;
+            ++segmentCount;
+        }
+
+        if (first != last)
+        {
+            auto const tail = m_buffer + 6 + HeaderSize;
+            auto tailLength = std::size_t(0);
+            for (/* Nothing */; first != last; ++first)
+            {
+                std::copy(first->first, first->first + first->second, tail + tailLength);
+                tailLength += first->second;
+            }
+
+            m_segments[segmentCount].data = tail;
+            m_segments[segmentCount].size = tailLength;
+            length += tailLength;
+            ++segmentCount;
+        }
+
+        m_buffer[0] = libs101::Byte::Invalid;
+        m_buffer[1] = 0x04;                         // Size of the length field
+        m_buffer[2] = (unsigned char)((length >> 24) & 0xFF);
+        m_buffer[3] = (unsigned char)((length >> 16) & 0xFF);
+        m_buffer[4] = (unsigned char)((length >> 8) & 0xFF);
+        m_buffer[5] = (unsigned char)((length >> 0) & 0xFF);
+        std::copy(header, header + HeaderSize, m_buffer + 6);
+
+        m_segments[0].data = m_buffer;
+        m_segments[0].size = 6 + HeaderSize;
+        m_target->writeSegments(m_segments, m_segments + segmentCount);
+    }
+}
+
+#endif//__TINYEMBERROUTER_GLOW_FRAMINGSTREAM_H
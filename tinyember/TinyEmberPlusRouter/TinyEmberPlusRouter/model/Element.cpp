@@ -80,13 +80,11 @@ namespace model
 
    Element* Element::findChild(int number) const
    {
-      for(auto child : m_children)
-      {
-         if(child->number() == number)
-            return child;
-      }
+      auto result = m_index.find(number);
 
-      return nullptr;
+      return result != m_index.end()
+         ? result->second
+         : nullptr;
    }
 
    // static
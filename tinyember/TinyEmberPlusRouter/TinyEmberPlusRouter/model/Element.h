@@ -8,6 +8,7 @@
 #define __TINYEMBERROUTER_MODEL_ELEMENT_H
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include "../util/Types.h"
 
@@ -96,7 +97,17 @@ namespace model
       inline const_iterator begin() const { return m_children.begin(); }
       inline iterator end() { return m_children.end(); }
       inline const_iterator end() const { return m_children.end(); }
-      inline iterator insert(iterator where, Element* child) { return m_children.insert(where, child); }
+
+      /**
+        * Inserts @p child before @p where and adds it to the index used
+        * by findChild. If several children share the same number, the
+        * one inserted first is found.
+        */
+      inline iterator insert(iterator where, Element* child)
+      {
+         m_index.emplace(child->number(), child);
+         return m_children.insert(where, child);
+      }
 
 
    // ========================================================
@@ -153,7 +164,8 @@ namespace model
    // ========================================================
    public:
       /**
-        * Looks for a child element with the passed number.
+        * Looks for a child element with the passed number. The lookup
+        * uses a hash index and does not scan the children.
         * @param number The number of the child to find.
         * @return Either a pointer to the found child or nullptr.
         */
@@ -195,6 +207,7 @@ namespace model
       std::string m_description;
       Element* m_parent;
       Vector m_children;
+      std::unordered_map<int, Element*> m_index;
       mutable util::Oid* m_path;
    };
 
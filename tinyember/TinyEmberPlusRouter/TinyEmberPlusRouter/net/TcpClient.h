@@ -43,6 +43,16 @@ namespace net
              */
             void write(QByteArray const& array);
 
+            /**
+             * Sends the passed segments to the connected client without
+             * concatenating them first. Each segment must provide the members
+             * data and size.
+             * @param first An iterator that points to the first segment.
+             * @param last An iterator that points one past the last segment.
+             */
+            template<typename SegmentIterator>
+            void writeSegments(SegmentIterator first, SegmentIterator last);
+
         signals:
             /**
              * This signal is emitted when the socket disconnects.
@@ -102,6 +112,17 @@ namespace net
         if (socket != nullptr)
             socket->write(array);
     }
+
+    template<typename SegmentIterator>
+    inline void TcpClient::writeSegments(SegmentIterator first, SegmentIterator last)
+    {
+        auto socket = m_socket;
+        if (socket != nullptr)
+        {
+            for (; first != last; ++first)
+                socket->write(reinterpret_cast<char const*>(first->data), static_cast<qint64>(first->size));
+        }
+    }
 }
 
 #endif//__TINYEMBERROUTER_NET_TCPCLIENT_H
@@ -51,6 +51,15 @@ namespace net
             template<typename InputIterator>
             void write(InputIterator first, InputIterator last);
 
+            /**
+             * Sends the concatenation of the passed segments to all connected clients.
+             * Each segment must provide the members data and size.
+             * @param first An iterator that points to the first segment.
+             * @param last An iterator that points one past the last segment.
+             */
+            template<typename SegmentIterator>
+            void writeSegments(SegmentIterator first, SegmentIterator last);
+
         private slots:
             /**
              * Handles an accepted connection.
@@ -81,6 +90,22 @@ namespace net
         std::copy(first, last, std::back_inserter(array));
         write(array);
     }
+
+    template<typename SegmentIterator>
+    inline void TcpServer::writeSegments(SegmentIterator first, SegmentIterator last)
+    {
+        auto length = 0;
+        for (auto it = first; it != last; ++it)
+            length += static_cast<int>(it->size);
+
+        auto array = QByteArray();
+        array.reserve(length);
+
+        for (; first != last; ++first)
+            array.append(reinterpret_cast<char const*>(first->data), static_cast<int>(first->size));
+
+        write(array);
+    }
 }
 
 #endif//__TINYEMBERROUTER_NET_TCPSERVER_H